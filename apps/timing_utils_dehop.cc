@@ -0,0 +1,593 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+/*
+ * Dehop a recording offline.
+ *
+ * Applies the timed_freq_xlating_fir kernel (a band pass filter at the center
+ * frequency, decimation and a derotator) to a memory-mapped recording, with
+ * the center frequency following a hop schedule. The output is split into
+ * chunks of about --chunk input samples, each read with the filter history
+ * before it, which are filtered in parallel and written in order, so the
+ * result is the same as a single pass. 32 bit float recordings are filtered
+ * straight from the mapping; 16 bit recordings are converted a chunk at a
+ * time.
+ *
+ * The schedule is a CSV file of `time,freq` rows, with the time in seconds
+ * since the epoch and the frequency (Hz, relative to the recording) to shift
+ * to baseband from that time on; `#` starts a comment. Times are looked up in
+ * the recording's index, as written by indexed_file_sink, or extrapolated
+ * from --start-time and --rate. A hop applies to the first output sample whose
+ * input sample is at or after the hop time, and the derotator phase is kept
+ * continuous across hops.
+ *
+ * An index is written next to the output with its rate and times.
+ */
+
+#include "record_index.h"
+#include <gnuradio/blocks/rotator.h>
+#include <gnuradio/filter/fir_filter.h>
+#include <gnuradio/filter/firdes.h>
+#include <gnuradio/gr_complex.h>
+#include <volk/volk.h>
+#include <boost/format.hpp>
+#include <fcntl.h>
+#include <getopt.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace gr::timing_utils;
+
+namespace {
+
+struct options_t {
+    std::string recording;
+    std::string schedule;
+    std::string output;
+    double rate = 0.0;
+    double start_time = 0.0;
+    unsigned decimation = 1;
+    double bandwidth = 0.0;
+    double freq = 0.0;
+    bool sc16 = false;
+    unsigned threads = 0;
+    uint64_t chunk = 1 << 20;
+};
+
+// a run of output samples at one center frequency
+struct segment_t {
+    uint64_t start;    // first output sample
+    double freq;       // center frequency (Hz)
+    double phase;      // derotator phase at the first output sample (rad)
+    double phase_incr; // derotator phase increment per output sample (rad)
+    std::vector<gr_complex> taps;
+};
+
+void usage(const char* name)
+{
+    std::cerr
+        << "usage: " << name << " [options] <recording> <schedule.csv> <output>\n"
+        << "  -d, --decimation N    decimation (default 1)\n"
+        << "  -b, --bandwidth HZ    filter cutoff and transition width (default\n"
+        << "                        0.4 of the output rate)\n"
+        << "  -f, --freq HZ         center frequency before the first hop (default 0)\n"
+        << "  -s, --sc16            recording is interleaved 16 bit I/Q, not 32 bit "
+           "float\n"
+        << "  -r, --rate HZ         sample rate, if the recording has no index\n"
+        << "  -t, --start-time S    time of the first sample, if it has no index\n"
+        << "  -j, --threads N       worker threads (default all cores)\n"
+        << "  -c, --chunk N         input samples per chunk (default 1048576)\n";
+}
+
+// split a time in seconds into whole and fractional seconds without rounding
+// the fraction through a double holding the epoch
+void parse_time(const std::string& text, uint64_t& secs, double& frac)
+{
+    size_t dot = text.find('.');
+    secs = std::stoull(text.substr(0, dot));
+    frac = (dot == std::string::npos) ? 0.0 : std::stod("0" + text.substr(dot));
+}
+
+void shift_time(uint64_t& secs, double& frac, double dt)
+{
+    double t_frac = frac + dt;
+    double whole_secs = std::floor(t_frac);
+    secs += int64_t(whole_secs);
+    frac = t_frac - whole_secs;
+}
+
+std::vector<std::pair<uint64_t, double>> read_schedule(const std::string& filename,
+                                                       const record_index& index)
+{
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error(
+            (boost::format("can't open schedule %s") % filename).str());
+    }
+    std::vector<std::pair<uint64_t, double>> hops;
+    std::string line;
+    size_t line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+        line = line.substr(0, line.find('#'));
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        size_t comma = line.find(',');
+        try {
+            if (comma == std::string::npos) {
+                throw std::invalid_argument("no comma");
+            }
+            uint64_t secs;
+            double frac;
+            parse_time(line.substr(0, comma), secs, frac);
+            hops.emplace_back(index.sample_at(secs, frac),
+                              std::stod(line.substr(comma + 1)));
+        } catch (const std::logic_error&) {
+            throw std::runtime_error(
+                (boost::format("%s:%d: expected time,freq") % filename % line_number)
+                    .str());
+        }
+    }
+    std::stable_sort(hops.begin(), hops.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    return hops;
+}
+
+/*
+ * Segments of the output from the hop schedule, with the composite taps and
+ * the derotator phase of each, as built by timed_freq_xlating_fir
+ */
+std::vector<segment_t> make_segments(const options_t& opts,
+                                     const std::vector<float>& proto_taps,
+                                     const std::vector<std::pair<uint64_t, double>>& hops,
+                                     double rate)
+{
+    std::vector<segment_t> segments(1);
+    segments[0].start = 0;
+    segments[0].freq = opts.freq;
+    for (const auto& hop : hops) {
+        segment_t segment;
+        segment.start = (hop.first + opts.decimation - 1) / opts.decimation;
+        segment.freq = hop.second;
+        if (segment.start == segments.back().start) {
+            segments.back() = segment;
+        } else {
+            segments.push_back(segment);
+        }
+    }
+
+    double phase = 0.0;
+    for (size_t ii = 0; ii < segments.size(); ii++) {
+        segment_t& segment = segments[ii];
+        double fwT0 = 2 * M_PI * segment.freq / rate;
+        segment.taps.resize(proto_taps.size());
+        for (size_t jj = 0; jj < proto_taps.size(); jj++) {
+            segment.taps[jj] = proto_taps[jj] * std::exp(gr_complex(0, jj * fwT0));
+        }
+        segment.phase_incr = -fwT0 * opts.decimation;
+        if (ii > 0) {
+            const segment_t& prev = segments[ii - 1];
+            phase += std::fmod(double(segment.start - prev.start) * prev.phase_incr,
+                               2 * M_PI);
+        }
+        segment.phase = phase;
+    }
+    return segments;
+}
+
+class dehopper
+{
+public:
+    dehopper(const options_t& opts,
+             const char* data,
+             uint64_t nitems,
+             const std::vector<segment_t>& segments,
+             unsigned ntaps)
+        : d_opts(opts),
+          d_data(data),
+          d_nitems(nitems),
+          d_segments(segments),
+          d_ntaps(ntaps),
+          d_noutputs((nitems + opts.decimation - 1) / opts.decimation),
+          d_chunk(std::max(opts.chunk / opts.decimation, uint64_t(1))),
+          d_nchunks((d_noutputs + d_chunk - 1) / d_chunk),
+          d_next_chunk(0),
+          d_written_chunks(0),
+          d_failed(false),
+          d_error(0)
+    {
+    }
+
+    uint64_t noutputs() const { return d_noutputs; }
+
+    void run(FILE* fp)
+    {
+        std::vector<std::thread> workers;
+        for (unsigned ii = 0; ii < d_opts.threads; ii++) {
+            workers.emplace_back([this]() { worker(); });
+        }
+
+        // write the chunks in order as they finish
+        unsigned last_percent = 0;
+        for (uint64_t chunk = 0; chunk < d_nchunks; chunk++) {
+            std::vector<gr_complex> out;
+            {
+                std::unique_lock<std::mutex> l(d_lock);
+                d_cond.wait(l, [&]() { return d_done.count(chunk) != 0; });
+                out.swap(d_done[chunk]);
+                d_done.erase(chunk);
+            }
+            bool ok =
+                fwrite(out.data(), sizeof(gr_complex), out.size(), fp) == out.size();
+            {
+                std::lock_guard<std::mutex> l(d_lock);
+                d_written_chunks++;
+                if (!ok) {
+                    d_failed = true;
+                    d_error = errno;
+                }
+            }
+            d_cond.notify_all();
+            if (!ok) {
+                break;
+            }
+            unsigned percent = 100 * (chunk + 1) / d_nchunks;
+            if (percent != last_percent) {
+                std::cerr << boost::format("\r%3d%%") % percent;
+                last_percent = percent;
+            }
+        }
+        std::cerr << std::endl;
+
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        if (d_failed) {
+            throw std::runtime_error(
+                (boost::format("output write failed: %s") % strerror(d_error)).str());
+        }
+    }
+
+private:
+    const options_t& d_opts;
+    const char* d_data;
+    const uint64_t d_nitems;
+    const std::vector<segment_t>& d_segments;
+    const unsigned d_ntaps;
+    const uint64_t d_noutputs;
+    const uint64_t d_chunk; // output samples per chunk
+    const uint64_t d_nchunks;
+
+    std::mutex d_lock;
+    std::condition_variable d_cond;
+    uint64_t d_next_chunk;
+    uint64_t d_written_chunks;
+    bool d_failed;
+    int d_error;
+    std::map<uint64_t, std::vector<gr_complex>> d_done;
+
+    void worker()
+    {
+        gr::filter::kernel::fir_filter_ccc fir(d_segments[0].taps);
+        const segment_t* taps_segment = &d_segments[0];
+        gr::blocks::rotator rotator;
+        std::vector<gr_complex> in, tmp;
+
+        while (true) {
+            uint64_t chunk;
+            {
+                // bound the chunks held for the writer
+                std::unique_lock<std::mutex> l(d_lock);
+                d_cond.wait(l, [&]() {
+                    return d_failed ||
+                           (d_next_chunk < d_written_chunks + 2 * d_opts.threads);
+                });
+                if (d_failed || (d_next_chunk >= d_nchunks)) {
+                    return;
+                }
+                chunk = d_next_chunk++;
+            }
+
+            const uint64_t first = chunk * d_chunk;
+            const uint64_t noutputs = std::min(d_chunk, d_noutputs - first);
+            const gr_complex* input = read_input(first * d_opts.decimation, noutputs, in);
+
+            std::vector<gr_complex> out(noutputs);
+            tmp.resize(noutputs);
+            uint64_t done = 0;
+            while (done < noutputs) {
+                const uint64_t output = first + done;
+                auto next = std::upper_bound(
+                    d_segments.begin(),
+                    d_segments.end(),
+                    output,
+                    [](uint64_t o, const segment_t& s) { return o < s.start; });
+                const segment_t& segment = *(next - 1);
+                uint64_t n = noutputs - done;
+                if (next != d_segments.end()) {
+                    n = std::min(n, next->start - output);
+                }
+
+                if (taps_segment != &segment) {
+                    fir.set_taps(segment.taps);
+                    taps_segment = &segment;
+                }
+                fir.filterNdec(
+                    &tmp[done], &input[done * d_opts.decimation], n, d_opts.decimation);
+
+                double phase = segment.phase + std::fmod(double(output - segment.start) *
+                                                             segment.phase_incr,
+                                                         2 * M_PI);
+                rotator.set_phase(std::exp(gr_complex(0, phase)));
+                rotator.set_phase_incr(std::exp(gr_complex(0, segment.phase_incr)));
+                rotator.rotateN(&out[done], &tmp[done], n);
+                done += n;
+            }
+
+            {
+                std::lock_guard<std::mutex> l(d_lock);
+                d_done[chunk].swap(out);
+            }
+            d_cond.notify_all();
+        }
+    }
+
+    /*
+     * Input for `noutputs` outputs from input sample `start`, preceded by the
+     * filter history, as complex float; samples before the recording are zero.
+     * Points into the recording if it can, otherwise converts into `in`.
+     */
+    const gr_complex*
+    read_input(uint64_t start, uint64_t noutputs, std::vector<gr_complex>& in)
+    {
+        const uint64_t history = d_ntaps - 1;
+        if (!d_opts.sc16 && (start >= history)) {
+            return (const gr_complex*)d_data + (start - history);
+        }
+
+        const uint64_t count = (noutputs - 1) * d_opts.decimation + d_ntaps;
+        in.assign(count, gr_complex(0, 0));
+
+        // recording items [begin, end) go to in[begin + history - start]
+        const uint64_t begin = (start > history) ? (start - history) : 0;
+        const uint64_t end = std::min(start + count - history, d_nitems);
+        gr_complex* dest = &in[begin + history - start];
+        if (d_opts.sc16) {
+            volk_16i_s32f_convert_32f((float*)dest,
+                                      (const int16_t*)d_data + 2 * begin,
+                                      32768.0,
+                                      2 * (end - begin));
+        } else {
+            memcpy(dest,
+                   (const gr_complex*)d_data + begin,
+                   (end - begin) * sizeof(gr_complex));
+        }
+        return in.data();
+    }
+};
+
+/*
+ * Index of the output: its rate, and the recording's time entries moved to the
+ * output samples they fall on, allowing for the filter delay
+ */
+void write_index(const std::string& filename,
+                 const record_index& index,
+                 const options_t& opts,
+                 double rate,
+                 unsigned ntaps,
+                 uint64_t noutputs)
+{
+    FILE* fp = fopen(filename.c_str(), "wb");
+    if (!fp) {
+        throw std::runtime_error((boost::format("can't open index %s: %s") % filename %
+                                  strerror(errno))
+                                     .str());
+    }
+    record_index_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, RECORD_INDEX_MAGIC, sizeof(header.magic));
+    header.version = RECORD_INDEX_VERSION;
+    header.entry_size = sizeof(record_index_entry_t);
+    header.itemsize = sizeof(gr_complex);
+    header.rate = rate / opts.decimation;
+    fwrite(&header, sizeof(header), 1, fp);
+
+    const uint64_t delay = (ntaps - 1) / 2;
+    bool first = true;
+    for (const record_index_entry_t& in_entry : index.entries()) {
+        if (in_entry.type != INDEX_TIME) {
+            continue;
+        }
+        // output sample k is centered on input sample k * decimation - delay
+        uint64_t output =
+            first ? 0 : (in_entry.sample + delay + opts.decimation - 1) / opts.decimation;
+        if (output >= noutputs) {
+            break;
+        }
+        record_index_entry_t entry = in_entry;
+        entry.sample = output;
+        shift_time(entry.secs,
+                   entry.value,
+                   (double(output * opts.decimation) - double(delay) -
+                    double(in_entry.sample)) /
+                       index.rate_at(in_entry.sample));
+        fwrite(&entry, sizeof(entry), 1, fp);
+        first = false;
+    }
+    fclose(fp);
+}
+
+int dehop(const options_t& opts)
+{
+    const size_t itemsize = opts.sc16 ? 2 * sizeof(int16_t) : sizeof(gr_complex);
+
+    int fd = ::open(opts.recording.c_str(), O_RDONLY);
+    struct stat st;
+    if ((fd < 0) || (fstat(fd, &st) != 0)) {
+        throw std::runtime_error((boost::format("can't open recording %s: %s") %
+                                  opts.recording % strerror(errno))
+                                     .str());
+    }
+    const uint64_t nitems = st.st_size / itemsize;
+    if (nitems == 0) {
+        ::close(fd);
+        throw std::runtime_error(
+            (boost::format("recording %s holds no items") % opts.recording).str());
+    }
+    void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error((boost::format("can't map recording %s: %s") %
+                                  opts.recording % strerror(errno))
+                                     .str());
+    }
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+
+    record_index index(opts.rate);
+    if (!index.load(opts.recording + ".idx")) {
+        record_index_entry_t entry;
+        entry.sample = 0;
+        entry.type = INDEX_TIME;
+        entry.reserved = 0;
+        entry.secs = uint64_t(std::floor(opts.start_time));
+        entry.value = opts.start_time - std::floor(opts.start_time);
+        index.add(entry);
+    }
+    const double rate = index.rate_at(0);
+    if (!(rate > 0.0)) {
+        throw std::runtime_error(
+            (boost::format("recording %s has no index, give its --rate") %
+             opts.recording)
+                .str());
+    }
+
+    const double bandwidth =
+        (opts.bandwidth > 0.0) ? opts.bandwidth : rate * 0.4 / opts.decimation;
+    std::vector<float> proto_taps =
+        gr::filter::firdes::low_pass_2(1, rate, bandwidth, bandwidth, 60);
+    std::vector<segment_t> segments =
+        make_segments(opts, proto_taps, read_schedule(opts.schedule, index), rate);
+    std::cerr << boost::format("%d samples at %g Hz, %d taps, %d hops, %d threads") %
+                     nitems % rate % proto_taps.size() % (segments.size() - 1) %
+                     opts.threads
+              << std::endl;
+
+    FILE* fp = fopen(opts.output.c_str(), "wb");
+    if (!fp) {
+        munmap(data, st.st_size);
+        throw std::runtime_error((boost::format("can't open output %s: %s") %
+                                  opts.output % strerror(errno))
+                                     .str());
+    }
+    dehopper dehop(opts, (const char*)data, nitems, segments, proto_taps.size());
+    try {
+        dehop.run(fp);
+    } catch (...) {
+        fclose(fp);
+        munmap(data, st.st_size);
+        throw;
+    }
+    fclose(fp);
+    munmap(data, st.st_size);
+
+    write_index(
+        opts.output + ".idx", index, opts, rate, proto_taps.size(), dehop.noutputs());
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    static const struct option long_options[] = {
+        { "decimation", required_argument, nullptr, 'd' },
+        { "bandwidth", required_argument, nullptr, 'b' },
+        { "freq", required_argument, nullptr, 'f' },
+        { "sc16", no_argument, nullptr, 's' },
+        { "rate", required_argument, nullptr, 'r' },
+        { "start-time", required_argument, nullptr, 't' },
+        { "threads", required_argument, nullptr, 'j' },
+        { "chunk", required_argument, nullptr, 'c' },
+        { "help", no_argument, nullptr, 'h' },
+        { nullptr, 0, nullptr, 0 },
+    };
+
+    options_t opts;
+    try {
+        int c;
+        while ((c = getopt_long(argc, argv, "d:b:f:sr:t:j:c:h", long_options, nullptr)) !=
+               -1) {
+            switch (c) {
+            case 'd':
+                opts.decimation = std::stoul(optarg);
+                break;
+            case 'b':
+                opts.bandwidth = std::stod(optarg);
+                break;
+            case 'f':
+                opts.freq = std::stod(optarg);
+                break;
+            case 's':
+                opts.sc16 = true;
+                break;
+            case 'r':
+                opts.rate = std::stod(optarg);
+                break;
+            case 't':
+                opts.start_time = std::stod(optarg);
+                break;
+            case 'j':
+                opts.threads = std::stoul(optarg);
+                break;
+            case 'c':
+                opts.chunk = std::stoull(optarg);
+                break;
+            default:
+                usage(argv[0]);
+                return (c == 'h') ? 0 : 1;
+            }
+        }
+    } catch (const std::logic_error&) {
+        usage(argv[0]);
+        return 1;
+    }
+    if ((argc - optind != 3) || (opts.decimation == 0) || (opts.chunk == 0)) {
+        usage(argv[0]);
+        return 1;
+    }
+    opts.recording = argv[optind];
+    opts.schedule = argv[optind + 1];
+    opts.output = argv[optind + 2];
+    if (opts.threads == 0) {
+        opts.threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    try {
+        return dehop(opts);
+    } catch (const std::exception& e) {
+        std::cerr << argv[0] << ": " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -32,6 +32,13 @@ namespace timing_utils {
  *
  * Subsequent tags will have an updated rx_time based on the current rx_rate.
  *
+ * For playback of recordings, the tags can instead follow the `captures` and
+ * `annotations` of a SigMF metadata file, see set_sigmf().
+ *
+ * The output may be left unconnected, in which case the block taps the
+ * upstream buffer without copying it and the time is only available through
+ * the timeline set with set_timeline().
+ *
  * Note: The block has been templatized to maintain backward compatability,
  * rather than using a generic itemsize argument to determine the size of
  * each sample.
@@ -76,6 +83,39 @@ public:
      * \return pmt dictionary of last tags emitted
      */
     virtual pmt::pmt_t last_tag() = 0;
+
+    /*! \brief Publish emitted tags to a shared sample timeline
+     *
+     * Each time the tags are emitted, the tagged sample, time and rate are
+     * published as an anchor of the named timing_utils::sample_timeline.
+     *
+     * \param name Timeline name, an empty string stops publishing
+     */
+    virtual void set_timeline(const std::string& name) = 0;
+
+    /*! \brief Tag the stream from a SigMF metadata file
+     *
+     * The captures and annotations of the file are indexed in memory, and
+     * stream offsets are taken as sample indices of the recording. Each
+     * capture is tagged at its `core:sample_start` with:
+     *  - rx_rate from `core:sample_rate` of the global object, or the rate
+     *  - rx_freq from its `core:frequency`, or that of the previous capture
+     *  - rx_time from its `core:datetime`, or extrapolated from the previous
+     *    capture (or from the epoch for the first one)
+     *
+     * Each annotation is tagged at its `core:sample_start` with an
+     * `annotation` tag holding a dictionary of its fields, keyed by their
+     * SigMF names. Fields that are numbers or booleans are converted to
+     * them, the others are kept as symbols.
+     *
+     * The initial tags from the constructor are not added while a file is
+     * loaded, but tag_now() and update_tags() still apply.
+     *
+     * \param filename SigMF metadata file (.sigmf-meta), an empty string
+     *        stops tagging from the file
+     * \throws std::runtime_error if the file can not be read or parsed
+     */
+    virtual void set_sigmf(const std::string& filename) = 0;
 };
 
 typedef add_usrp_tags<unsigned char> add_usrp_tags_b;
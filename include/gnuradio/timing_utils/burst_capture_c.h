@@ -0,0 +1,83 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_BURST_CAPTURE_C_H
+#define INCLUDED_TIMING_UTILS_BURST_CAPTURE_C_H
+
+#include <gnuradio/sync_block.h>
+#include <gnuradio/timing_utils/api.h>
+
+namespace gr {
+namespace timing_utils {
+
+/*!
+ * \brief Capture the samples around magnitude triggers as PDUs
+ * \ingroup timing_utils
+ *
+ * Triggers on the magnitude of the input with the same rules as
+ * thresh_trigger_f: a trigger fires on the `length`-th consecutive sample
+ * with a magnitude above \p hi, and no further trigger fires until the
+ * magnitude has dropped back. Each trigger publishes one PDU on the `pdu_out`
+ * port holding the \p pre samples before the triggering sample and the
+ * \p post samples starting with it. The PDU metadata contains:
+ *    - rx_sample (uint64) absolute index of the first captured sample
+ *    - trigger_sample (uint64) absolute index of the triggering sample
+ *    - rx_time (tuple uint64 secs, double frac) time of the first captured
+ *      sample, only present once an `rx_time` tag and the sample rate are known
+ *    - trigger_time (pair uint64 secs . double frac) time of the triggering
+ *      sample, under the same conditions
+ *
+ * The pre-trigger samples are kept as input history, so only captured samples
+ * are copied. Triggers that fire while a capture is still in progress are
+ * ignored. Captures that start within \p pre samples of the beginning of the
+ * stream are shortened accordingly.
+ */
+class TIMING_UTILS_API burst_capture_c : virtual public gr::sync_block
+{
+public:
+    typedef std::shared_ptr<burst_capture_c> sptr;
+
+    /*!
+     * \brief Return a shared_ptr to a new instance of timing_utils::burst_capture_c.
+     *
+     * \param hi Magnitude above which samples count towards a trigger
+     * \param lo Magnitude below which blanking stops
+     * \param length Number of consecutive samples above \p hi to trigger
+     * \param pre Number of samples captured before the triggering sample
+     * \param post Number of samples captured from the triggering sample on, at least 1
+     */
+    static sptr make(float hi, float lo, int length, int pre, int post);
+
+    /*!
+     * \brief Set the high magnitude threshold
+     */
+    virtual void set_hi(float t) = 0;
+
+    /*!
+     * \brief Set the low magnitude threshold
+     */
+    virtual void set_lo(float t) = 0;
+
+    /*!
+     * \brief Set the number of consecutive samples above the high threshold to trigger
+     */
+    virtual void set_len(int len) = 0;
+
+    /*!
+     * \brief Set the sample rate used to compute capture times
+     *
+     * \param rate Sample rate (Hz), replaced by any `rx_rate` tag received
+     */
+    virtual void set_rate(double rate) = 0;
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_BURST_CAPTURE_C_H */
@@ -0,0 +1,95 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_COINCIDENCE_TRIGGER_F_H
+#define INCLUDED_TIMING_UTILS_COINCIDENCE_TRIGGER_F_H
+
+#include <gnuradio/sync_block.h>
+#include <gnuradio/timing_utils/api.h>
+
+namespace gr {
+namespace timing_utils {
+
+/*!
+ * \brief Trigger when k of N aligned channels cross a threshold together
+ * \ingroup timing_utils
+ *
+ * Each input is a phase-aligned channel with its own hysteresis trigger,
+ * using the same rules and thresholds as thresh_trigger_f. A single trigger
+ * is emitted once \p k channels have triggered within \p window samples of
+ * each other, on the sample where the k-th channel triggers. The channels
+ * that took part are then cleared, so further triggers need new channel
+ * crossings.
+ *
+ * The trigger is published on the `trig` port as the pair
+ * (trigger_now . info), where info is a dictionary with the elements:
+ *    - trigger_sample (uint64) absolute index of the triggering sample
+ *    - trigger_time (pair uint64 secs . double frac) time of the triggering
+ *      sample, only present once an `rx_time` tag on the first input and the
+ *      sample rate are known
+ *    - channels (uint64) bit mask of the channels in the coincidence
+ *
+ * The sample rate is taken from `rx_rate` tags on the first input, or set
+ * with set_rate().
+ */
+class TIMING_UTILS_API coincidence_trigger_f : virtual public gr::sync_block
+{
+public:
+    typedef std::shared_ptr<coincidence_trigger_f> sptr;
+
+    /*!
+     * \brief Return a shared_ptr to a new instance of timing_utils::coincidence_trigger_f.
+     *
+     * \param nchan Number of input channels, at most 64
+     * \param hi High threshold
+     * \param lo Low threshold
+     * \param length Number of consecutive samples above \p hi for a channel to trigger
+     * \param k Number of channels needed for a coincidence
+     * \param window Coincidence window (samples)
+     */
+    static sptr make(int nchan, float hi, float lo, int length, int k, int window);
+
+    /*!
+     * \brief Set the high threshold of all channels
+     */
+    virtual void set_hi(float t) = 0;
+
+    /*!
+     * \brief Set the low threshold of all channels
+     */
+    virtual void set_lo(float t) = 0;
+
+    /*!
+     * \brief Set the number of consecutive samples above the high threshold for
+     * a channel to trigger
+     */
+    virtual void set_len(int len) = 0;
+
+    /*!
+     * \brief Set the number of channels needed for a coincidence
+     */
+    virtual void set_k(int k) = 0;
+
+    /*!
+     * \brief Set the coincidence window (samples)
+     */
+    virtual void set_window(int window) = 0;
+
+    /*!
+     * \brief Set the sample rate used to compute trigger times
+     *
+     * \param rate Sample rate (Hz), replaced by any `rx_rate` tag received
+     */
+    virtual void set_rate(double rate) = 0;
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_COINCIDENCE_TRIGGER_F_H */
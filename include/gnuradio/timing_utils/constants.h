@@ -39,6 +39,27 @@ TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__in();
 TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__dsp_freq();
 TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__START();
 TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__END();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__gap();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__dropped();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__filled();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__shed();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__channels();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__edge();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__edges();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__stats();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__count();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__min();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__max();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__mean();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__p50();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__p90();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__p99();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__p999();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__last();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__trace();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__diff();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__offsets();
+TIMING_UTILS_API const pmt::pmt_t PMTCONSTSTR__annotation();
 
 } // namespace timing_utils
 } // namespace gr
@@ -0,0 +1,63 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_EDGE_DETECTOR_BB_H
+#define INCLUDED_TIMING_UTILS_EDGE_DETECTOR_BB_H
+
+#include <gnuradio/sync_block.h>
+#include <gnuradio/timing_utils/api.h>
+
+namespace gr {
+namespace timing_utils {
+
+enum edge_mode_t { RISING_EDGE = 0, FALLING_EDGE = 1, ANY_EDGE = 2 };
+
+enum edge_output_t { EDGE_STREAM = 0, EDGE_TAGS = 1, EDGE_OFFSETS = 2 };
+
+/*!
+ * \brief Detect edges in a binary stream
+ * \ingroup timing_utils
+ *
+ * Nonzero input samples are high. Rising edges are samples that are high
+ * after a low sample, falling edges the reverse, and the stream is taken to
+ * start low. The edges selected by \p mode are reported as selected by
+ * \p output:
+ *
+ *  - EDGE_STREAM: the output is 1 on each edge and 0 elsewhere
+ *  - EDGE_TAGS: the output passes the input through, with an `edge` tag on
+ *    each edge whose value is true for rising and false for falling edges
+ *  - EDGE_OFFSETS: the absolute offsets of the edges in each buffer are
+ *    published as a u64vector on the `edges` message port, and the output
+ *    passes the input through
+ *
+ * The output is optional in the EDGE_TAGS and EDGE_OFFSETS modes.
+ */
+class TIMING_UTILS_API edge_detector_bb : virtual public gr::sync_block
+{
+public:
+    typedef std::shared_ptr<edge_detector_bb> sptr;
+
+    /*!
+     * \brief Return a shared_ptr to a new instance of timing_utils::edge_detector_bb.
+     *
+     * \param mode RISING_EDGE, FALLING_EDGE or ANY_EDGE
+     * \param output EDGE_STREAM, EDGE_TAGS or EDGE_OFFSETS
+     */
+    static sptr make(edge_mode_t mode, edge_output_t output = EDGE_STREAM);
+
+    /*!
+     * \brief Set which edges are detected
+     */
+    virtual void set_mode(edge_mode_t mode) = 0;
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_EDGE_DETECTOR_BB_H */
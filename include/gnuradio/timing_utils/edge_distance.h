@@ -0,0 +1,62 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_EDGE_DISTANCE_H
+#define INCLUDED_TIMING_UTILS_EDGE_DISTANCE_H
+
+#include <gnuradio/sync_block.h>
+#include <gnuradio/timing_utils/api.h>
+
+namespace gr {
+namespace timing_utils {
+
+/*!
+ * \brief Measure the distance between `START` and `END` tags
+ * \ingroup timing_utils
+ *
+ * Each `END` tag that follows a `START` tag is one measurement of the time
+ * between them, in milliseconds at the given sample rate. Other tags are not
+ * looked at. After each buffer with new measurements, the statistics of all
+ * measurements so far are published on the `stats` port as a dictionary:
+ *    - count (uint64) number of measurements
+ *    - last, min, max, mean (double) measurements (ms)
+ *    - p50, p90, p99, p999 (double) percentiles (ms), within about 1%
+ */
+class TIMING_UTILS_API edge_distance : virtual public gr::sync_block
+{
+public:
+    typedef std::shared_ptr<edge_distance> sptr;
+
+    /*!
+     * \brief Return a shared_ptr to a new instance of timing_utils::edge_distance.
+     *
+     * \param samp_rate Sample rate (Hz)
+     */
+    static sptr make(double samp_rate);
+
+    /*!
+     * \brief Set the sample rate (Hz)
+     */
+    virtual void set_rate(double samp_rate) = 0;
+
+    /*!
+     * \brief Clear the statistics
+     */
+    virtual void reset_stats() = 0;
+
+    /*!
+     * \brief Current statistics, as published on the `stats` port
+     */
+    virtual pmt::pmt_t stats() = 0;
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_EDGE_DISTANCE_H */
@@ -0,0 +1,117 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_EVENT_LOG_H
+#define INCLUDED_TIMING_UTILS_EVENT_LOG_H
+
+#include <gnuradio/timing_utils/api.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace gr {
+namespace timing_utils {
+
+/*!
+ * \brief Timing event types
+ *
+ * The meaning of the offset and value of an event depends on its type.
+ */
+enum event_type_t {
+    EVENT_TAG = 1,       /*!< time tag seen or added, value is its time (s) */
+    EVENT_TRIGGER = 2,   /*!< trigger fired, value is its time (s) or 0 */
+    EVENT_INTERRUPT = 3, /*!< interrupt fired, value is its time (s) or 0 */
+    EVENT_RETUNE = 4,    /*!< retune applied, value is the frequency (Hz) */
+    EVENT_CLOCK = 5,     /*!< clock servo update, value is the rate (Hz) */
+    EVENT_LATENCY = 6,   /*!< latency measured, value is the delta (s) */
+};
+
+/*!
+ * \brief Binary timing event record, as stored in the log files
+ */
+struct TIMING_UTILS_API event_record_t {
+    uint64_t time_ns; /*!< system time (ns since the epoch) */
+    uint32_t source;  /*!< source id, see event_log::source() */
+    uint16_t type;    /*!< event_type_t */
+    uint16_t reserved;
+    uint64_t offset; /*!< sample offset */
+    double value;
+};
+
+/*!
+ * \brief Process-wide binary event log
+ *
+ * \ingroup timing_utils
+ *
+ * A low overhead alternative to logging timing events as text from the
+ * streaming threads. While the log is open, each thread that logs an event
+ * gets its own ring of fixed size records in a memory-mapped file
+ * `events-<n>.bin` in the log directory. Logging an event is a clock read and
+ * a 32 byte store into the thread's ring with no locks or system calls, and
+ * when the log is closed it is a single relaxed load. The newest `capacity`
+ * events of each thread are kept, and since the rings are file-backed they
+ * survive a crash of the process.
+ *
+ * Source ids map to names in `sources.csv` in the same directory. The
+ * `timing_utils_event_log_to_csv` tool merges the rings of a directory into
+ * a single time ordered CSV file.
+ */
+class TIMING_UTILS_API event_log
+{
+public:
+    /*!
+     * \brief Start logging to \p directory
+     *
+     * \param directory Existing directory for the log files
+     * \param capacity Events kept per thread, rounded up to a power of two
+     * \return false if the log is already open
+     */
+    static bool open(const std::string& directory, size_t capacity = 65536);
+
+    /*!
+     * \brief Stop logging and flush the log files
+     *
+     * Must not be called while flowgraphs that log events are running.
+     */
+    static void close();
+
+    /*!
+     * \brief Whether the log is open
+     */
+    static bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    /*!
+     * \brief Register an event source
+     *
+     * \param name Source name, usually the block's symbol name
+     * \return id to log the source's events with
+     */
+    static uint32_t source(const std::string& name);
+
+    /*!
+     * \brief Log an event if the log is open
+     */
+    static void
+    log(event_type_t type, uint32_t source, uint64_t offset = 0, double value = 0.0)
+    {
+        if (enabled()) {
+            write(type, source, offset, value);
+        }
+    }
+
+private:
+    static std::atomic<bool> s_enabled;
+
+    static void write(event_type_t type, uint32_t source, uint64_t offset, double value);
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_EVENT_LOG_H */
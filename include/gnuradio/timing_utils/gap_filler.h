@@ -0,0 +1,98 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_GAP_FILLER_H
+#define INCLUDED_TIMING_UTILS_GAP_FILLER_H
+
+#include <gnuradio/block.h>
+#include <gnuradio/timing_utils/api.h>
+
+namespace gr {
+namespace timing_utils {
+
+/*!
+ * \brief Detect and optionally fill sample gaps indicated by `rx_time` tags
+ *
+ * \ingroup timing_utils
+ *
+ * When a radio overflows it drops samples and tags the next sample with a new
+ * `rx_time`. This block compares every `rx_time` tag with the time predicted
+ * by counting samples since the previous one at the current rate (taken from
+ * `rx_rate` tags if present). If the tag is later than predicted, the number
+ * of dropped samples is reported as a dictionary on the `gap` message port:
+ *
+ *  - rx_sample (uint64) output index of the first sample after the gap, and
+ *    after any zeros inserted
+ *  - rx_time (pmt time tuple) time of that sample
+ *  - dropped (uint64) number of samples dropped
+ *  - filled (uint64) number of zero samples inserted
+ *
+ * and a `gap` tag holding the dropped sample count is added to the output.
+ *
+ * If filling is enabled, gaps of up to \p max_fill samples are replaced with
+ * zeros so that sample offsets and time stay consistent downstream. Larger
+ * gaps are only reported, and the `rx_time` tag re-anchors timing downstream.
+ */
+template <class T>
+class TIMING_UTILS_API gap_filler : virtual public gr::block
+{
+public:
+    typedef std::shared_ptr<gap_filler<T>> sptr;
+
+    /*!
+     * \brief Return a shared_ptr to a new instance of timing_utils::gap_filler.
+     *
+     * \param rate Sampling rate (Hz), used until an `rx_rate` tag is received
+     * \param fill Insert zero samples in place of dropped samples
+     * \param max_fill Largest gap to fill (samples)
+     *
+     * \return Pointer to new instance
+     */
+    static sptr make(double rate, bool fill, uint64_t max_fill);
+
+    /*!
+     * \brief Enable or disable filling gaps with zero samples
+     */
+    virtual void set_fill(bool fill) = 0;
+
+    /*!
+     * \brief Set the largest gap that will be filled (samples)
+     */
+    virtual void set_max_fill(uint64_t max_fill) = 0;
+
+    /*!
+     * \brief Set the sampling rate (Hz)
+     */
+    virtual void set_rate(double rate) = 0;
+
+    /*!
+     * \brief Number of gaps detected
+     */
+    virtual uint64_t gaps() = 0;
+
+    /*!
+     * \brief Total number of samples dropped upstream
+     */
+    virtual uint64_t dropped() = 0;
+
+    /*!
+     * \brief Total number of zero samples inserted
+     */
+    virtual uint64_t filled() = 0;
+};
+
+typedef gap_filler<unsigned char> gap_filler_b;
+typedef gap_filler<short> gap_filler_s;
+typedef gap_filler<int32_t> gap_filler_i;
+typedef gap_filler<float> gap_filler_f;
+typedef gap_filler<gr_complex> gap_filler_c;
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_GAP_FILLER_H */
@@ -0,0 +1,84 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_INDEXED_FILE_SINK_H
+#define INCLUDED_TIMING_UTILS_INDEXED_FILE_SINK_H
+
+#include <gnuradio/sync_block.h>
+#include <gnuradio/timing_utils/api.h>
+
+namespace gr {
+namespace timing_utils {
+
+/*!
+ * \brief Record a stream with a time index
+ *
+ * \ingroup timing_utils
+ *
+ * Writes the raw items to `filename` in large sequential writes, optionally
+ * bypassing the page cache with O_DIRECT, and keeps a sidecar index
+ * `filename.idx` of the stream's `rx_time`, `rx_rate`, `rx_freq` and `freq`
+ * (retune) tags, so the samples at a given time can be found without reading
+ * the recording; see indexed_file_source.
+ *
+ * The index is a 32 byte header followed by a 32 byte entry per tag, all
+ * little endian:
+ *  - header: magic "TUINDEX\0", uint32 version (1), uint32 entry size,
+ *    uint64 itemsize, double nominal sample rate (Hz)
+ *  - entry: uint64 sample (items from the start of the recording),
+ *    uint32 type (1 time, 2 rate, 3 RF frequency from `rx_freq`, 4 retune
+ *    from `freq`), uint32 reserved, uint64 whole seconds (time), double
+ *    fractional seconds (time), rate (Hz), RF frequency (Hz) or the retuned
+ *    center frequency within the band (Hz)
+ *
+ * The times of samples between `rx_time` tags follow from the sample rate,
+ * so the recorded `rx_rate` tags must be the rate of the recorded stream. Some
+ * decimating blocks, timed_freq_xlating_fir among them, pass the input
+ * `rx_rate` tags through unchanged; record their output with \p use_rx_rate
+ * off.
+ *
+ * Entries are held until the samples they refer to have been written to the
+ * recording, then appended and flushed, so the index never refers to samples
+ * that are not written.
+ */
+class TIMING_UTILS_API indexed_file_sink : virtual public gr::sync_block
+{
+public:
+    typedef std::shared_ptr<indexed_file_sink> sptr;
+
+    /*!
+     * \brief Return a shared_ptr to a new instance of timing_utils::indexed_file_sink.
+     *
+     * \param filename Recording file, the index is written next to it
+     * \param itemsize Size of each item (bytes)
+     * \param samp_rate Nominal sample rate (Hz), until an `rx_rate` tag
+     * \param direct Write with O_DIRECT, if the file system supports it
+     * \param buffer_size Size of each write (bytes), rounded up to a multiple of 4096
+     * \param use_rx_rate Index `rx_rate` tags; turn off when recording the output
+     *        of a decimating block that passes its input rate tags through, such
+     *        as timed_freq_xlating_fir, and give the output rate as \p samp_rate
+     * \throws std::runtime_error if the files can not be created
+     */
+    static sptr make(const std::string& filename,
+                     size_t itemsize,
+                     double samp_rate,
+                     bool direct = false,
+                     size_t buffer_size = 4194304,
+                     bool use_rx_rate = true);
+
+    /*!
+     * \brief Number of index entries written
+     */
+    virtual uint64_t index_entries() = 0;
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_INDEXED_FILE_SINK_H */
@@ -0,0 +1,83 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_INDEXED_FILE_SOURCE_H
+#define INCLUDED_TIMING_UTILS_INDEXED_FILE_SOURCE_H
+
+#include <gnuradio/sync_block.h>
+#include <gnuradio/timing_utils/api.h>
+
+namespace gr {
+namespace timing_utils {
+
+/*!
+ * \brief Replay a time window of a recording
+ *
+ * \ingroup timing_utils
+ *
+ * Memory-maps a recording and plays it from the first sample at or after
+ * `seek_time` up to `end_time`, so a window of a large recording starts
+ * without reading what comes before it. The file is read through the
+ * mapping with sequential read-ahead advice, and pages already played are
+ * released as it goes.
+ *
+ * If the recording has an index `filename.idx`, as written by
+ * indexed_file_sink, times are looked up in it, and its time, rate, RF
+ * frequency and retune entries are replayed as `rx_time`, `rx_rate`,
+ * `rx_freq` and `freq` tags. Otherwise the first sample is taken to be at
+ * `file_time` and the samples to follow at `samp_rate`. Either way the first
+ * sample played is tagged with its `rx_time`, `rx_rate` and, if known,
+ * `rx_freq` and `freq`.
+ *
+ * When `repeat` is set, the window is played again from its start, with new
+ * tags, once its end is reached.
+ */
+class TIMING_UTILS_API indexed_file_source : virtual public gr::sync_block
+{
+public:
+    typedef std::shared_ptr<indexed_file_source> sptr;
+
+    /*!
+     * \brief Return a shared_ptr to a new instance of timing_utils::indexed_file_source.
+     *
+     * \param filename Recording file
+     * \param itemsize Size of each item (bytes)
+     * \param samp_rate Sample rate (Hz), if there is no index
+     * \param file_time Time of the first sample (s since the epoch), if there is
+     *        no index
+     * \param seek_time Time to start playing at (s since the epoch), 0 for the
+     *        start of the recording
+     * \param end_time Time to stop playing at (s since the epoch), 0 for the end
+     *        of the recording
+     * \param repeat Play the window again once its end is reached
+     * \throws std::runtime_error if the file can not be mapped
+     */
+    static sptr make(const std::string& filename,
+                     size_t itemsize,
+                     double samp_rate = 0.0,
+                     double file_time = 0.0,
+                     double seek_time = 0.0,
+                     double end_time = 0.0,
+                     bool repeat = false);
+
+    /*!
+     * \brief First sample of the window, in items from the start of the file
+     */
+    virtual uint64_t start_sample() = 0;
+
+    /*!
+     * \brief End of the window, in items from the start of the file
+     */
+    virtual uint64_t end_sample() = 0;
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_INDEXED_FILE_SOURCE_H */
@@ -29,6 +29,12 @@ namespace timing_utils {
  * emitter can more accurately emit a message without actually processing
  * the sample nearest in time to the requested interrupt.
  *
+ * Requests on the `set` port are a uint64 sample index, a (uint64 . double)
+ * time pair or tuple, or a trigger message from thresh_trigger_f. A trigger
+ * message gives the time of a sample that has already been processed, so it
+ * is armed that time plus the delay set with set_trigger_delay(); with no
+ * delay the interrupt is dropped if \p drop_late is set, and late otherwise.
+ *
  * The emitted message is a dictionary with the following elements:
  *    - trigger_time (original request type, either uint64, pair, or tuple)
  *    - trigger_sample (uint64)
@@ -94,6 +100,23 @@ public:
      *     directly to stdout
      */
     virtual void set_debug(bool value) = 0;
+
+    /*! \brief Track sample time using a shared timeline
+     *
+     * New anchors published to the named timing_utils::sample_timeline are
+     * applied in the same way as `rx_time` stream tags, so the time reference
+     * stays corrected without tags in the data stream.
+     *
+     * \param name Timeline name, an empty string reverts to stream tags only
+     */
+    virtual void set_timeline(const std::string& name) = 0;
+
+    /*! \brief Set the delay of interrupts requested by trigger messages
+     *
+     * \param delay Delay (s) after the trigger time, negative values are
+     *     treated as zero
+     */
+    virtual void set_trigger_delay(double delay) = 0;
 };
 
 typedef interrupt_emitter<unsigned char> interrupt_emitter_b;
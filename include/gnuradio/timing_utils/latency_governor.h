@@ -0,0 +1,101 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_LATENCY_GOVERNOR_H
+#define INCLUDED_TIMING_UTILS_LATENCY_GOVERNOR_H
+
+#include <gnuradio/block.h>
+#include <gnuradio/timing_utils/api.h>
+
+namespace gr {
+namespace timing_utils {
+
+/*!
+ * \brief Shed stale data to bound stream latency
+ *
+ * \ingroup timing_utils
+ *
+ * Measures how far the newest available sample lags real time, and drops
+ * whole input buffers while the lag exceeds \p max_lag seconds so downstream
+ * timed blocks work on current data rather than a growing backlog.
+ *
+ * The lag is measured from `wall_clock_time` tags (see system_time_tagger) if
+ * present. Otherwise `rx_time` tags are used: the offset between the radio
+ * and host clocks is taken as the smallest difference seen, and follows
+ * larger differences no faster than 100 ppm of wall time to track clock
+ * drift, so only the excess over that baseline counts as lag and a sustained
+ * lag keeps being shed. The clock servo of system_time_tagger is not used for
+ * this: it fits the host times at which samples arrive, so it would take a
+ * backlog in as part of the fit, while the least queued arrival seen is the
+ * reference the lag is measured against. With no time tags the stream is
+ * passed as is.
+ *
+ * While lagging, every buffer is dropped if \p keep_one_in is zero, otherwise
+ * one out of every \p keep_one_in buffers is passed. The first sample after
+ * each discontinuity is tagged with `shed` (uint64 number of samples dropped)
+ * and, if known, `rx_time`, along with the latest tag of each other key in the
+ * dropped data (such as `rx_freq`), and the same information is published as a
+ * dictionary on the `shed` message port:
+ *
+ *  - rx_sample (uint64) output index of the first sample after the gap
+ *  - dropped (uint64) number of samples dropped
+ *  - late_delta (double) lag when shedding started (s)
+ */
+template <class T>
+class TIMING_UTILS_API latency_governor : virtual public gr::block
+{
+public:
+    typedef std::shared_ptr<latency_governor<T>> sptr;
+
+    /*!
+     * \brief Return a shared_ptr to a new instance of timing_utils::latency_governor.
+     *
+     * \param rate Sampling rate (Hz), used until an `rx_rate` tag is received
+     * \param max_lag Lag budget (s)
+     * \param keep_one_in Pass one of every N buffers while lagging, zero to drop all
+     *
+     * \return Pointer to new instance
+     */
+    static sptr make(double rate, double max_lag, uint32_t keep_one_in);
+
+    /*!
+     * \brief Set the lag budget (s)
+     */
+    virtual void set_max_lag(double max_lag) = 0;
+
+    /*!
+     * \brief Set how many buffers are passed while lagging
+     */
+    virtual void set_keep_one_in(uint32_t keep_one_in) = 0;
+
+    /*!
+     * \brief Set the sampling rate (Hz)
+     */
+    virtual void set_rate(double rate) = 0;
+
+    /*!
+     * \brief Most recently measured lag (s)
+     */
+    virtual double lag() = 0;
+
+    /*!
+     * \brief Total number of samples dropped
+     */
+    virtual uint64_t dropped() = 0;
+};
+
+typedef latency_governor<unsigned char> latency_governor_b;
+typedef latency_governor<short> latency_governor_s;
+typedef latency_governor<int32_t> latency_governor_i;
+typedef latency_governor<float> latency_governor_f;
+typedef latency_governor<gr_complex> latency_governor_c;
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_LATENCY_GOVERNOR_H */
@@ -0,0 +1,152 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_SAMPLE_TIMELINE_H
+#define INCLUDED_TIMING_UTILS_SAMPLE_TIMELINE_H
+
+#include <gnuradio/timing_utils/api.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace gr {
+namespace timing_utils {
+
+/*!
+ * \brief Sample timeline anchor
+ *
+ * Maps the absolute sample index \p offset to the time (\p secs + \p frac) at
+ * which that sample was taken, with samples following at \p rate.
+ */
+struct TIMING_UTILS_API timeline_anchor_t {
+    uint64_t offset;
+    uint64_t secs;
+    double frac;
+    double rate;
+};
+
+/*!
+ * \brief Process-wide sample/time mapping shared between blocks
+ *
+ * \ingroup timing_utils
+ *
+ * Blocks that know the time of a sample (tag_uhd_offset, add_usrp_tags) publish
+ * anchors to a named timeline, and blocks that need the time of a sample
+ * (interrupt_emitter, uhd_timed_pdu_emitter) query it directly rather than
+ * relying on periodic `rx_time` tags in the data stream.
+ *
+ * The most recent anchors are kept in a fixed size ring. Publishing is
+ * serialized between writers, but queries are lock-free: each slot is
+ * guarded by its own sequence counter and readers retry if a slot was
+ * rewritten while it was being read. A query walks back from the newest
+ * anchor to the first one at or before the requested sample, so it is
+ * constant time for any sample at or after the oldest retained anchor.
+ *
+ * Sample offsets are absolute item counts of the publishing block's stream, so
+ * consumers must be on the same stream without a rate change in between.
+ */
+class TIMING_UTILS_API sample_timeline
+{
+public:
+    typedef std::shared_ptr<sample_timeline> sptr;
+
+    //! number of anchors retained by each timeline
+    static const size_t NUM_ANCHORS = 16;
+
+    /*!
+     * \brief Get the timeline registered under \p name, creating it if needed
+     *
+     * \param name Timeline name shared by publishers and consumers
+     * \return pointer to the named timeline
+     */
+    static sptr get(const std::string& name);
+
+    sample_timeline();
+    ~sample_timeline();
+
+    /*!
+     * \brief Publish a new anchor
+     *
+     * \param offset Absolute sample index
+     * \param secs Whole seconds of sample \p offset
+     * \param frac Fractional seconds of sample \p offset
+     * \param rate Sample rate (Hz)
+     * \return false, and nothing is published, if \p rate is not positive or
+     *     \p frac or \p rate is not finite
+     */
+    bool publish(uint64_t offset, uint64_t secs, double frac, double rate);
+
+    /*!
+     * \brief Remove all anchors
+     */
+    void reset();
+
+    /*!
+     * \brief Number of anchors published since creation or the last reset
+     */
+    uint64_t version() const;
+
+    /*!
+     * \brief Get the anchor that applies to \p offset
+     *
+     * The newest anchor at or before \p offset is returned, or the oldest
+     * retained anchor if \p offset precedes all of them.
+     *
+     * \return false if no anchor has been published
+     */
+    bool anchor_at(uint64_t offset, timeline_anchor_t& anchor) const;
+
+    /*!
+     * \brief Get the newest anchor
+     *
+     * \return false if no anchor has been published
+     */
+    bool latest(timeline_anchor_t& anchor) const;
+
+    /*!
+     * \brief Time of sample \p offset
+     *
+     * \return false if no anchor has been published
+     */
+    bool time_at(uint64_t offset, uint64_t& secs, double& frac) const;
+
+    /*!
+     * \brief Sample index nearest to time \p secs + \p frac
+     *
+     * \return false if no anchor has been published or the time precedes
+     *    sample zero
+     */
+    bool offset_at(uint64_t secs, double frac, uint64_t& offset) const;
+
+private:
+    struct slot_t {
+        std::atomic<uint64_t> seq;
+        std::atomic<uint64_t> offset;
+        std::atomic<uint64_t> secs;
+        std::atomic<double> frac;
+        std::atomic<double> rate;
+    };
+
+    slot_t d_slots[NUM_ANCHORS];
+    // total anchors ever written, and the index of the first one since reset
+    std::atomic<uint64_t> d_written;
+    std::atomic<uint64_t> d_first;
+    std::mutex d_writer_lock;
+
+    bool read_slot(uint64_t index, timeline_anchor_t& anchor) const;
+    template <class P>
+    bool find(P at_or_before, timeline_anchor_t& anchor) const;
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_SAMPLE_TIMELINE_H */
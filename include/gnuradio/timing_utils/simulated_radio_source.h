@@ -0,0 +1,103 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_SIMULATED_RADIO_SOURCE_H
+#define INCLUDED_TIMING_UTILS_SIMULATED_RADIO_SOURCE_H
+
+#include <gnuradio/sync_block.h>
+#include <gnuradio/timing_utils/api.h>
+
+namespace gr {
+namespace timing_utils {
+
+/*!
+ * \brief Simulated radio timing source
+ *
+ * \ingroup timing_utils
+ *
+ * Generates a complex tone with the timing behavior of a UHD source, so the
+ * timing blocks can be tested and benchmarked without hardware. Like a USRP,
+ * the first sample and the first sample after each overflow are tagged with
+ * `rx_time` (pmt time tuple (uint64_t whole seconds, double frac seconds)),
+ * `rx_rate` (double) and `rx_freq` (double), and the device time starts at
+ * the system time of the first sample.
+ *
+ * The device time advances at the nominal sample rate, but the simulated
+ * sample clock runs `ppm` parts per million fast, changing by `drift` ppm per
+ * second, so the device time drifts from the system time as it would with
+ * a free-running radio. Every `overflow_period` seconds `overflow_samples`
+ * samples are dropped, and the time tags after the overflow jump by as much.
+ *
+ * When `realtime` is set, samples are delivered no earlier than the simulated
+ * clock produces them, in bursts of `burst_size` samples (or as many as the
+ * output has room for if 0), each delayed by a further random host latency
+ * with a mean of `jitter` seconds. Otherwise samples are generated as fast as
+ * the flowgraph consumes them and only the tags model the clock.
+ */
+class TIMING_UTILS_API simulated_radio_source : virtual public gr::sync_block
+{
+public:
+    typedef std::shared_ptr<simulated_radio_source> sptr;
+
+    /*!
+     * \brief Return a shared_ptr to a new instance of
+     * timing_utils::simulated_radio_source.
+     *
+     * \param samp_rate Nominal sample rate (Hz)
+     * \param freq Center frequency reported in the `rx_freq` tags (Hz)
+     * \param tone_freq Frequency of the generated tone (Hz)
+     * \param ppm Sample clock error (ppm)
+     * \param drift Change of the sample clock error (ppm/s)
+     * \param jitter Mean host latency of each burst (s)
+     * \param overflow_period Time between overflows (s), 0 for none
+     * \param overflow_samples Samples dropped by each overflow
+     * \param burst_size Samples per burst, 0 for as many as fit
+     * \param realtime Deliver samples at the simulated clock rate
+     */
+    static sptr make(double samp_rate,
+                     double freq = 0.0,
+                     double tone_freq = 0.0,
+                     double ppm = 0.0,
+                     double drift = 0.0,
+                     double jitter = 0.0,
+                     double overflow_period = 0.0,
+                     uint32_t overflow_samples = 0,
+                     uint32_t burst_size = 0,
+                     bool realtime = true);
+
+    /*!
+     * \brief Set the sample clock error (ppm)
+     */
+    virtual void set_ppm(double ppm) = 0;
+
+    /*!
+     * \brief Set the change of the sample clock error (ppm/s)
+     */
+    virtual void set_drift(double drift) = 0;
+
+    /*!
+     * \brief Set the mean host latency of each burst (s)
+     */
+    virtual void set_jitter(double jitter) = 0;
+
+    /*!
+     * \brief Set the time between overflows (s), 0 for none
+     */
+    virtual void set_overflow_period(double overflow_period) = 0;
+
+    /*!
+     * \brief Number of overflows so far
+     */
+    virtual uint64_t overflows() = 0;
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_SIMULATED_RADIO_SOURCE_H */
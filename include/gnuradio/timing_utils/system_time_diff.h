@@ -24,8 +24,8 @@ namespace timing_utils {
  * Compute and optionally display he time difference between the system
  * time a tag is received and the time the tag was generated.  The tag is
  * typically added to a data stream by the system_time_tagger block.  If
- * output_diff option is selected, the time difference will be output to
- * stdout in the format 'diff = %.09f s'
+ * output_diff option is selected, the time difference will be logged at
+ * debug level in the format 'diff = %.09f s'
  *
  * Each tag can also optionally have its time updated in the output data
  * stream.  Rather than adding an additional tag, this allows for the
@@ -34,6 +34,23 @@ namespace timing_utils {
  * tag generation.
  *
  * The tag 'wall_clock_time' must be a double.
+ *
+ * The time differences of each buffer are published on the `diff` port as a
+ * PDU, with the differences (s) as an f64vector and the offsets of their tags
+ * as a u64vector `offsets` in the metadata. The optional diff output carries
+ * the same differences as a stream; a buffer with more time tags than the
+ * output has room for is cut short, so no difference is lost or overruns it.
+ *
+ * Only `wall_clock_time` tags are looked at, and the system time is read once
+ * per buffer holding any. When the data output is the only output connected
+ * and the time is not updated, all other tags are propagated by the runtime,
+ * except in buffers holding a `trace` tag. Otherwise the block re-adds every
+ * tag, which costs more with many tags, and `trace` tags holding a latency
+ * trace record get this block added as a hop; see trace_sink.
+ *
+ * The outputs may be left unconnected, in which case the block taps the
+ * upstream buffer without copying it. The diff output requires the data
+ * output to be connected.
  */
 template <class T>
 class TIMING_UTILS_API system_time_diff : virtual public gr::block
@@ -45,7 +62,7 @@ public:
      * \brief Return a shared_ptr to a new instance of timing_utils::system_time_diff.
      *
      * \param update_time Flag to update the time tag to the current system time
-     * \param output_diff Output the time difference to stdout
+     * \param output_diff Log the time difference at debug level
      */
     static sptr make(bool update_time, bool output_diff);
 };
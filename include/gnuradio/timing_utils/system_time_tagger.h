@@ -21,6 +21,17 @@ namespace timing_utils {
  * \ingroup timing_utils
  *
  * Inserts system time tag every N samples
+ *
+ * The time of a tag is the system time its sample arrived at this block,
+ * rather than the time of the work call that tags it. The clock is read once
+ * per work call, for the newest sample of the buffer, and a servo filters the
+ * reads into a smoothed sample rate from which the time of each tagged sample
+ * is interpolated. For about the first 50 ms, before the rate is known, tags
+ * carry the raw clock read of their buffer.
+ *
+ * When `trace` is set, each time tag is accompanied by a `trace` tag at the
+ * same offset holding a latency trace record started with this block's alias;
+ * see trace_sink.
  */
 template <class T>
 class TIMING_UTILS_API system_time_tagger : virtual public gr::sync_block
@@ -32,8 +43,9 @@ public:
      * \brief Return a shared_ptr to a new instance of timing_utils::system_time_tagger.
      *
      * @param tag_interval - number of samples between tags
+     * @param trace - start a latency trace record with each tag
      */
-    static sptr make(uint32_t tag_interval);
+    static sptr make(uint32_t tag_interval, bool trace = false);
 
     /**
      * Sets interval between tags
@@ -41,6 +53,13 @@ public:
      * @param tag_interval
      */
     virtual void set_interval(uint32_t tag_interval) = 0;
+
+    /**
+     * Start a latency trace record with each tag
+     *
+     * @param trace
+     */
+    virtual void set_trace(bool trace) = 0;
 };
 
 typedef system_time_tagger<unsigned char> system_time_tagger_b;
@@ -20,6 +20,10 @@ namespace timing_utils {
  * \brief <+description of block+>
  * \ingroup timing_utils
  *
+ * The output may be left unconnected, in which case the block taps the
+ * upstream buffer without copying it, and received `rx_time` tags are only
+ * reported on the `time` message port and the timeline set with
+ * set_timeline(). Periodic tags are not generated in this mode.
  */
 template <class T>
 class TIMING_UTILS_API tag_uhd_offset : virtual public gr::sync_block
@@ -52,6 +56,17 @@ public:
      * @param tag_key -
      */
     virtual void set_key(pmt::pmt_t tag_key) = 0;
+
+    /*!
+     * \brief Publish received `rx_time` tags to a shared sample timeline
+     *
+     * Each `rx_time` tag is published as an anchor of the named
+     * timing_utils::sample_timeline so downstream blocks can look up sample
+     * times without periodic tags.
+     *
+     * \param name Timeline name, an empty string stops publishing
+     */
+    virtual void set_timeline(const std::string& name) = 0;
 };
 
 typedef tag_uhd_offset<unsigned char> tag_uhd_offset_b;
@@ -0,0 +1,97 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_THRESH_TRIGGER_C_H
+#define INCLUDED_TIMING_UTILS_THRESH_TRIGGER_C_H
+
+#include <gnuradio/sync_block.h>
+#include <gnuradio/timing_utils/api.h>
+
+namespace gr {
+namespace timing_utils {
+
+/*!
+ * \brief Threshold trigger on the magnitude of a complex stream
+ * \ingroup timing_utils
+ *
+ * Equivalent to complex_to_mag followed by thresh_trigger_f, without the
+ * intermediate stream: the magnitude squared of each sample is computed and
+ * compared to the squared thresholds in the same pass. The thresholds are
+ * magnitudes.
+ *
+ * A trigger is emitted on the `length`-th consecutive sample with a
+ * magnitude above the high threshold as the pair (trigger_now . info), where
+ * info is a dictionary with the elements:
+ *    - trigger_sample (uint64) absolute index of the triggering sample
+ *    - trigger_time (pair uint64 secs . double frac) time of the triggering
+ *      sample, only present once an `rx_time` tag and the sample rate are known
+ *
+ * The sample rate is taken from `rx_rate` tags, or set with set_rate().
+ *
+ * In CFAR mode (see set_cfar()) the thresholds are ratios to a running
+ * estimate of the RMS noise magnitude instead of fixed levels.
+ *
+ * The output is optional. If connected, the input is passed through with a
+ * `trigger_now` tag holding the info dictionary on each triggering sample.
+ */
+class TIMING_UTILS_API thresh_trigger_c : virtual public gr::sync_block
+{
+public:
+    typedef std::shared_ptr<thresh_trigger_c> sptr;
+
+    /*!
+     * \brief Return a shared_ptr to a new instance of timing_utils::thresh_trigger_c.
+     *
+     * @param hi - high magnitude threshold
+     * @param lo - low magnitude threshold
+     * @param length -
+     */
+    static sptr make(float hi, float lo, int length);
+
+    /**
+     *
+     * @param t -
+     */
+    virtual void set_hi(float t) = 0;
+
+    /**
+     *
+     * @param t -
+     */
+    virtual void set_lo(float t) = 0;
+
+    /**
+     *
+     * @param len -
+     */
+    virtual void set_len(int len) = 0;
+
+    /*!
+     * \brief Set the sample rate used to compute trigger times
+     *
+     * \param rate Sample rate (Hz), replaced by any `rx_rate` tag received
+     */
+    virtual void set_rate(double rate) = 0;
+
+    /*!
+     * \brief Enable cell-averaging CFAR thresholds
+     *
+     * The thresholds become multiples of the RMS magnitude over the last
+     * \p window samples, in blocks of 64, leaving out blocks with a burst. A
+     * burst lasting the whole window is taken as a step in the noise floor.
+     *
+     * \param window Averaging window (samples), zero for fixed thresholds
+     */
+    virtual void set_cfar(int window) = 0;
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_THRESH_TRIGGER_C_H */
@@ -20,6 +20,20 @@ namespace timing_utils {
  * \brief <+description of block+>
  * \ingroup timing_utils
  *
+ * A trigger is emitted on the `length`-th consecutive sample above the high
+ * threshold as the pair (trigger_now . info), where info is a dictionary
+ * with the elements:
+ *    - trigger_sample (uint64) absolute index of the triggering sample
+ *    - trigger_time (pair uint64 secs . double frac) time of the triggering
+ *      sample, only present once an `rx_time` tag and the sample rate are known
+ *
+ * The sample rate is taken from `rx_rate` tags, or set with set_rate().
+ *
+ * In CFAR mode (see set_cfar()) the thresholds are ratios to a running
+ * estimate of the noise level instead of fixed levels.
+ *
+ * The output is optional. If connected, the input is passed through with a
+ * `trigger_now` tag holding the info dictionary on each triggering sample.
  */
 class TIMING_UTILS_API thresh_trigger_f : virtual public gr::sync_block
 {
@@ -52,6 +66,25 @@ public:
      * @param len -
      */
     virtual void set_len(int len) = 0;
+
+    /*!
+     * \brief Set the sample rate used to compute trigger times
+     *
+     * \param rate Sample rate (Hz), replaced by any `rx_rate` tag received
+     */
+    virtual void set_rate(double rate) = 0;
+
+    /*!
+     * \brief Enable cell-averaging CFAR thresholds
+     *
+     * The thresholds become multiples of the mean input over the last
+     * \p window samples, leaving out those from a rise above the high threshold
+     * until a fall below the low one. If that lasts a whole window, the mean
+     * restarts at the new level.
+     *
+     * \param window Averaging window (samples), zero for fixed thresholds
+     */
+    virtual void set_cfar(int window) = 0;
 };
 
 } // namespace timing_utils
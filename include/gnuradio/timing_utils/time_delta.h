@@ -17,9 +17,21 @@ namespace gr {
 namespace timing_utils {
 
 /*!
- * \brief <+description of block+>
+ * \brief Measure the latency of PDUs against their wall clock time
  * \ingroup timing_utils
  *
+ * The time between the `time_key` metadata field of each PDU and the system
+ * time it is received at is added to the metadata as `delta_key`, in
+ * milliseconds. The deltas are also kept in a fixed memory log-bucketed
+ * histogram, a snapshot of which is published on the `stats` port every
+ * `period` seconds as a dictionary:
+ *    - count (uint64) number of deltas
+ *    - last, min, max, mean (double) deltas (ms)
+ *    - p50, p90, p99, p999 (double) percentiles (ms), within about 1%
+ *
+ * When `reset_on_read` is set, each snapshot starts a new interval, while
+ * the summary logged when the flowgraph stops covers the whole run. PDUs
+ * carrying a latency trace record get this block added as a hop.
  */
 class TIMING_UTILS_API time_delta : virtual public gr::block
 {
@@ -31,8 +43,34 @@ public:
      *
      * @param delta_key - key to use for time delta metadata field
      * @param time_key - key to use as reference time for delta
+     * @param period - snapshot publication period (s), 0 to disable
+     * @param reset_on_read - clear the histogram after each snapshot
+     */
+    static sptr make(const pmt::pmt_t delta_key,
+                     const pmt::pmt_t time_key,
+                     double period = 0.0,
+                     bool reset_on_read = false);
+
+    /*!
+     * \brief Set the snapshot publication period (s), 0 to disable
+     */
+    virtual void set_period(double period) = 0;
+
+    /*!
+     * \brief Clear the histogram after each snapshot
+     */
+    virtual void set_reset_on_read(bool reset_on_read) = 0;
+
+    /*!
+     * \brief Clear the histogram
+     */
+    virtual void reset_stats() = 0;
+
+    /*!
+     * \brief Snapshot of the histogram, cleared afterwards when reset on read
+     * is set
      */
-    static sptr make(const pmt::pmt_t delta_key, const pmt::pmt_t time_key);
+    virtual pmt::pmt_t stats() = 0;
 };
 
 } // namespace timing_utils
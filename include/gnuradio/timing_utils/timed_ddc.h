@@ -0,0 +1,87 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_TIMED_DDC_H
+#define INCLUDED_TIMING_UTILS_TIMED_DDC_H
+
+#include <gnuradio/sync_decimator.h>
+#include <gnuradio/timing_utils/api.h>
+#include <pmt/pmt.h>
+
+namespace gr {
+namespace timing_utils {
+
+/*!
+ * \brief Timed digital down converter
+ *
+ * \ingroup timing_utils
+ *
+ * Combines timed_tag_retuner and timed_freq_xlating_fir in one block: the
+ * input is frequency translated from the center frequency, low pass filtered
+ * with the real \p taps and decimated, and the center frequency is retuned at
+ * the sample given by a timed command.
+ *
+ * The `command` messages are those of timed_tag_retuner: a dictionary with
+ * the LO offset (double) under \p dict_key, which retunes the center frequency
+ * to minus the offset, and optionally the time to retune at under `time`, as
+ * a pair of whole (uint64) and fractional (double) seconds. Commands without a
+ * time are applied immediately. The time of a sample is tracked from the
+ * `rx_time` tags on the input, or from the origin time until the first one.
+ *
+ * A retune applies from the first output sample centered, given the group
+ * delay of the taps, at or after the retune time, with the derotator phase
+ * kept continuous. That output sample is tagged `freq` with the new center
+ * frequency, in line with the tags propagated from the retune sample.
+ */
+class TIMING_UTILS_API timed_ddc : virtual public gr::sync_decimator
+{
+public:
+    typedef std::shared_ptr<timed_ddc> sptr;
+
+    /*!
+     * \brief Return a shared_ptr to a new instance of timing_utils::timed_ddc.
+     *
+     * \param decimation Decimation rate
+     * \param taps Low pass filter taps
+     * \param center_freq Center frequency to down convert from (Hz)
+     * \param sample_rate Input sample rate (Hz)
+     * \param dict_key Dictionary key of the LO offset in commands
+     * \param origin_t_secs Time of the first sample (integer seconds)
+     * \param origin_t_frac Time of the first sample (fractional seconds)
+     */
+    static sptr make(int decimation,
+                     const std::vector<float>& taps,
+                     double center_freq,
+                     double sample_rate,
+                     pmt::pmt_t dict_key,
+                     uint64_t origin_t_secs = 0,
+                     double origin_t_frac = 0.0);
+
+    /*!
+     * \brief Retune immediately
+     *
+     * \param center_freq Center frequency (Hz)
+     */
+    virtual void set_center_freq(double center_freq) = 0;
+
+    /*!
+     * \brief Current center frequency (Hz)
+     */
+    virtual double center_freq() const = 0;
+
+    /*!
+     * \brief Number of retunes applied
+     */
+    virtual uint64_t retunes() const = 0;
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_TIMED_DDC_H */
@@ -53,6 +53,15 @@ namespace timing_utils {
  * affect.  Use the filter's group delay to determine when the
  * transients after the change have settled down.
  *
+ * For large decimations, \p cic_decimation > 1 selects a multistage
+ * mode: the input is mixed down at the input rate, decimated by
+ * \p cic_decimation with a fourth order CIC filter, and filtered and
+ * decimated by the rest of the decimation with \p taps, which are then
+ * designed for the CIC output rate and equalized for the CIC passband
+ * droop by the block. Frequency tags take effect at exactly the tagged
+ * input sample in this mode, and the declared sample delay is the group
+ * delay of both stages.
+ *
  * @tparam I input type (short, float, complex)
  * @tparam O output type (float, complex)
  * @tparam T tap type (float, complex)
@@ -78,12 +87,15 @@ public:
      * \param center_freq Center frequency of signal to down convert from (Hz)
      * \param sampling_freq Sampling rate of signal (in Hz)
      * \param tag_key Frequency tag key
+     * \param cic_decimation CIC decimation of the multistage mode, which must
+     *        divide \p decimation; 1 for a single FIR stage
      */
     static sptr make(int decimation,
                      const std::vector<T>& taps,
                      double center_freq,
                      double sampling_freq,
-                     std::string tag_key = "set_freq");
+                     std::string tag_key = "set_freq",
+                     int cic_decimation = 1);
 
     /*!
      * \brief Set FIR filter decimation
@@ -99,6 +111,13 @@ public:
      */
     virtual int decim() const = 0;
 
+    /*!
+     * \brief Get the CIC decimation of the multistage mode
+     *
+     * \return CIC decimation rate, 1 for a single FIR stage
+     */
+    virtual int cic_decim() const = 0;
+
     /*!
      * \brief Set FIR filter sampling rate
      *
@@ -0,0 +1,56 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_TRACE_SINK_H
+#define INCLUDED_TIMING_UTILS_TRACE_SINK_H
+
+#include <gnuradio/sync_block.h>
+#include <gnuradio/timing_utils/api.h>
+
+namespace gr {
+namespace timing_utils {
+
+/*!
+ * \brief Write latency trace records as a Chrome trace / Perfetto JSON file
+ * \ingroup timing_utils
+ *
+ * Latency trace records are started by wall_clock_time (PDUs) and
+ * system_time_tagger (streams) when tracing is enabled. Each time_delta,
+ * wall_clock_time and system_time_diff block a record passes through adds its
+ * alias and the system time it saw the record at.
+ *
+ * This block adds its own entry to each record received in the metadata of a
+ * PDU on `pdu_in`, or as a `trace` tag on the optional stream input, and
+ * writes one span per hop, named `<from> -> <to>`. The file uses the JSON
+ * array trace event format and can be opened in chrome://tracing or
+ * ui.perfetto.dev, where spans with the same name share a track.
+ */
+class TIMING_UTILS_API trace_sink : virtual public gr::sync_block
+{
+public:
+    typedef std::shared_ptr<trace_sink> sptr;
+
+    /*!
+     * \brief Return a shared_ptr to a new instance of timing_utils::trace_sink.
+     *
+     * \param filename Output file, truncated if it exists
+     * \param itemsize Stream input item size (bytes)
+     */
+    static sptr make(const std::string& filename, size_t itemsize);
+
+    /*!
+     * \brief Number of trace records written
+     */
+    virtual uint64_t records() = 0;
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_TRACE_SINK_H */
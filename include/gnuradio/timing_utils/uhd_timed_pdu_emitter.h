@@ -40,6 +40,27 @@ public:
      * @param rate -
      */
     virtual void set_rate(float rate) = 0;
+
+    /*!
+     * \brief Convert between trigger samples and times using a shared timeline
+     *
+     * When the named timing_utils::sample_timeline has anchors, it is used in
+     * place of the reference time derived from `rx_time` stream tags.
+     *
+     * \param name Timeline name, an empty string reverts to stream tags
+     */
+    virtual void set_timeline(const std::string& name) = 0;
+
+    /*!
+     * \brief Set the delay of events requested by trigger messages
+     *
+     * Trigger messages give a sample that has normally been processed by the
+     * time they arrive, so without a delay the event is late.
+     *
+     * \param delay Delay (s) after the trigger, negative values are treated
+     *     as zero
+     */
+    virtual void set_trigger_delay(double delay) = 0;
 };
 
 } // namespace timing_utils
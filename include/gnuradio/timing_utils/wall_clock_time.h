@@ -21,6 +21,10 @@ namespace timing_utils {
  * \ingroup timing_utils
  *
  * Adds wall_clock_time key to PDU dict containing wall clock time in  unix epoc
+ *
+ * When `trace` is set, a latency trace record is also started in the `trace`
+ * field with this block's alias and the same time. Records already present
+ * get this block added as a hop; see trace_sink.
  */
 class TIMING_UTILS_API wall_clock_time : virtual public gr::block
 {
@@ -31,8 +35,14 @@ public:
      * \brief Return a shared_ptr to a new instance of timing_utils::wall_clock_time.
      *
      * @param key - key to use for wall clock time metadata field
+     * @param trace - start a latency trace record
+     */
+    static sptr make(const pmt::pmt_t key, bool trace = false);
+
+    /*!
+     * \brief Start a latency trace record in each PDU
      */
-    static sptr make(const pmt::pmt_t key);
+    virtual void set_trace(bool trace) = 0;
 };
 
 } // namespace timing_utils
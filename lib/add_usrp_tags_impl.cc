@@ -14,10 +14,74 @@
 #include "add_usrp_tags_impl.h"
 #include <gnuradio/io_signature.h>
 #include <gnuradio/timing_utils/constants.h>
+#include <gnuradio/timing_utils/event_log.h>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/format.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
 
 namespace gr {
 namespace timing_utils {
 
+/*
+ * Parse a SigMF `core:datetime`, an ISO 8601 UTC time such as
+ * 2021-06-01T12:00:00.123456789Z, keeping the full precision of the
+ * fractional seconds; `secs` and `frac` are left as is if it is malformed
+ */
+static bool parse_sigmf_datetime(std::string datetime, uint64_t& secs, double& frac)
+{
+    if (!datetime.empty() && (datetime.back() == 'Z')) {
+        datetime.pop_back();
+    }
+    double t_frac = 0.0;
+    size_t dot = datetime.find('.');
+    if (dot != std::string::npos) {
+        t_frac = std::atof(("0" + datetime.substr(dot)).c_str());
+        datetime = datetime.substr(0, dot);
+    }
+    uint64_t t_secs;
+    try {
+        boost::posix_time::ptime t = boost::posix_time::from_iso_extended_string(datetime);
+        boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+        t_secs = (t - epoch).total_seconds();
+    } catch (const std::exception&) {
+        return false;
+    }
+    secs = t_secs;
+    frac = t_frac;
+    return true;
+}
+
+/*
+ * SigMF values are numbers, booleans or strings, which a property tree
+ * stores alike as strings
+ */
+static pmt::pmt_t sigmf_value_to_pmt(const std::string& value)
+{
+    if (value == "true") {
+        return pmt::PMT_T;
+    }
+    if (value == "false") {
+        return pmt::PMT_F;
+    }
+    if (!value.empty()) {
+        char* end;
+        long long ivalue = std::strtoll(value.c_str(), &end, 10);
+        if (*end == '\0') {
+            return pmt::from_long(ivalue);
+        }
+        double dvalue = std::strtod(value.c_str(), &end);
+        if (*end == '\0') {
+            return pmt::from_double(dvalue);
+        }
+    }
+    return pmt::intern(value);
+}
+
 template <class T>
 typename add_usrp_tags<T>::sptr
 add_usrp_tags<T>::make(double freq, double rate, uint64_t epoch_int, double epoch_frac)
@@ -36,8 +100,9 @@ add_usrp_tags_impl<T>::add_usrp_tags_impl(double freq,
                                           double epoch_frac)
     : gr::sync_block("add_usrp_tags",
                      gr::io_signature::make(1, 1, sizeof(T)),
-                     gr::io_signature::make(1, 1, sizeof(T)))
+                     gr::io_signature::make(0, 1, sizeof(T)))
 {
+    d_event_source = event_log::source(this->symbol_name());
     d_rate_pmt = pmt::from_double(rate);
     d_freq_pmt = pmt::from_double(freq);
     d_time_pmt =
@@ -62,6 +127,8 @@ add_usrp_tags_impl<T>::~add_usrp_tags_impl()
 template <class T>
 void add_usrp_tags_impl<T>::update_tags(pmt::pmt_t update)
 {
+    gr::thread::scoped_lock l(this->d_setlock);
+
     if (!pmt::is_dict(update)) {
         GR_LOG_NOTICE(this->d_logger, "received unexpected PMT (non-dict)");
         return;
@@ -92,26 +159,187 @@ pmt::pmt_t add_usrp_tags_impl<T>::last_tag()
 }
 
 
+template <class T>
+void add_usrp_tags_impl<T>::set_timeline(const std::string& name)
+{
+    gr::thread::scoped_lock l(this->d_setlock);
+
+    if (name.empty()) {
+        d_timeline.reset();
+    } else {
+        d_timeline = sample_timeline::get(name);
+    }
+}
+
+template <class T>
+void add_usrp_tags_impl<T>::set_sigmf(const std::string& filename)
+{
+    std::vector<sigmf_entry_t> entries;
+
+    if (!filename.empty()) {
+        boost::property_tree::ptree meta;
+        try {
+            boost::property_tree::read_json(filename, meta);
+        } catch (const boost::property_tree::json_parser_error& e) {
+            throw std::runtime_error("add_usrp_tags: can not read SigMF metadata " +
+                                     filename + ": " + e.what());
+        }
+
+        // defaults from the constructor, for the fields a capture omits
+        gr::thread::scoped_lock l(this->d_setlock);
+        double rate = meta.get<double>("global.core:sample_rate",
+                                       pmt::to_double(d_rate_pmt));
+        double freq = pmt::to_double(d_freq_pmt);
+        uint64_t secs = pmt::to_uint64(pmt::tuple_ref(d_time_pmt, 0));
+        double frac = pmt::to_double(pmt::tuple_ref(d_time_pmt, 1));
+        uint64_t last_start = 0;
+        l.unlock();
+
+        boost::property_tree::ptree none;
+
+        // captures are sorted by sample_start as required by the spec
+        for (const auto& item : meta.get_child("captures", none)) {
+            const boost::property_tree::ptree& capture = item.second;
+            sigmf_entry_t entry;
+            entry.offset = capture.get<uint64_t>("core:sample_start", 0);
+            entry.capture = true;
+
+            freq = capture.get<double>("core:frequency", freq);
+            boost::optional<std::string> datetime =
+                capture.get_optional<std::string>("core:datetime");
+            if (!datetime || !parse_sigmf_datetime(*datetime, secs, frac)) {
+                frac += int64_t(entry.offset - last_start) / rate;
+            }
+            double whole_secs = std::floor(frac);
+            secs += int64_t(whole_secs);
+            frac -= whole_secs;
+            last_start = entry.offset;
+
+            entry.freq = pmt::from_double(freq);
+            entry.rate = pmt::from_double(rate);
+            entry.time = pmt::make_tuple(pmt::from_uint64(secs), pmt::from_double(frac));
+            entries.push_back(entry);
+        }
+
+        for (const auto& item : meta.get_child("annotations", none)) {
+            const boost::property_tree::ptree& annotation = item.second;
+            sigmf_entry_t entry;
+            entry.offset = annotation.get<uint64_t>("core:sample_start", 0);
+            entry.capture = false;
+            entry.annotation = pmt::make_dict();
+            for (const auto& field : annotation) {
+                if (field.second.empty()) {
+                    entry.annotation =
+                        pmt::dict_add(entry.annotation,
+                                      pmt::intern(field.first),
+                                      sigmf_value_to_pmt(field.second.data()));
+                }
+            }
+            entries.push_back(entry);
+        }
+
+        // captures come before the annotations at the same sample
+        std::stable_sort(entries.begin(),
+                         entries.end(),
+                         [](const sigmf_entry_t& a, const sigmf_entry_t& b) {
+                             return a.offset < b.offset;
+                         });
+        GR_LOG_INFO(this->d_logger,
+                    boost::format("indexed %d SigMF captures and annotations from %s") %
+                        entries.size() % filename);
+    }
+
+    gr::thread::scoped_lock l(this->d_setlock);
+    d_sigmf.swap(entries);
+    if (!d_sigmf.empty()) {
+        d_tag_now = false;
+    }
+}
+
+template <class T>
+void add_usrp_tags_impl<T>::add_tags(uint64_t offset, bool pass_through)
+{
+    if (pass_through) {
+        this->add_item_tag(0, offset, PMTCONSTSTR__rx_freq(), d_freq_pmt);
+        this->add_item_tag(0, offset, PMTCONSTSTR__rx_rate(), d_rate_pmt);
+        this->add_item_tag(0, offset, PMTCONSTSTR__rx_time(), d_time_pmt);
+        if (event_log::enabled()) {
+            event_log::log(EVENT_TAG,
+                           d_event_source,
+                           offset,
+                           pmt::to_uint64(pmt::tuple_ref(d_time_pmt, 0)) +
+                               pmt::to_double(pmt::tuple_ref(d_time_pmt, 1)));
+        }
+    }
+    d_tagged_sample = offset;
+
+    if (d_timeline) {
+        publish_timeline(d_tagged_sample);
+    }
+}
+
+template <class T>
+void add_usrp_tags_impl<T>::publish_timeline(uint64_t offset)
+{
+    if (!pmt::is_tuple(d_time_pmt) || !pmt::is_real(d_rate_pmt)) {
+        GR_LOG_DEBUG(this->d_logger, "time or rate tag malformed, timeline not updated");
+        return;
+    }
+
+    if (!d_timeline->publish(offset,
+                             pmt::to_uint64(pmt::tuple_ref(d_time_pmt, 0)),
+                             pmt::to_double(pmt::tuple_ref(d_time_pmt, 1)),
+                             pmt::to_double(d_rate_pmt))) {
+        GR_LOG_DEBUG(this->d_logger, "invalid rate, timeline not updated");
+    }
+}
+
 template <class T>
 int add_usrp_tags_impl<T>::work(int noutput_items,
                                 gr_vector_const_void_star& input_items,
                                 gr_vector_void_star& output_items)
 {
-    const T* in = (const T*)input_items[0];
-    T* out = (T*)output_items[0];
+    gr::thread::scoped_lock l(this->d_setlock);
 
-    // pass through
-    memcpy(out, in, noutput_items * sizeof(T));
+    // pass through, unless the block is only tapping the upstream buffer to
+    // publish a timeline
+    const bool pass_through = !output_items.empty();
+    if (pass_through) {
+        memcpy(output_items[0], input_items[0], noutput_items * sizeof(T));
+    }
 
     // add tags on the first sample in the output buffer if indicated
     if (d_tag_now) {
-        this->add_item_tag(0, this->nitems_read(0), PMTCONSTSTR__rx_freq(), d_freq_pmt);
-        this->add_item_tag(0, this->nitems_read(0), PMTCONSTSTR__rx_rate(), d_rate_pmt);
-        this->add_item_tag(0, this->nitems_read(0), PMTCONSTSTR__rx_time(), d_time_pmt);
-        d_tagged_sample = this->nitems_read(0);
+        add_tags(this->nitems_read(0), pass_through);
         d_tag_now = false;
     }
 
+    // captures and annotations of a SigMF recording in this buffer
+    if (!d_sigmf.empty()) {
+        const uint64_t start = this->nitems_read(0);
+        const uint64_t end = start + noutput_items;
+        auto entry = std::lower_bound(d_sigmf.begin(),
+                                      d_sigmf.end(),
+                                      start,
+                                      [](const sigmf_entry_t& e, uint64_t offset) {
+                                          return e.offset < offset;
+                                      });
+        for (; (entry != d_sigmf.end()) && (entry->offset < end); ++entry) {
+            if (entry->capture) {
+                d_freq_pmt = entry->freq;
+                d_rate_pmt = entry->rate;
+                d_time_pmt = entry->time;
+                d_pmt_dict = pmt::dict_add(d_pmt_dict, PMTCONSTSTR__rx_rate(), d_rate_pmt);
+                d_pmt_dict = pmt::dict_add(d_pmt_dict, PMTCONSTSTR__rx_freq(), d_freq_pmt);
+                d_pmt_dict = pmt::dict_add(d_pmt_dict, PMTCONSTSTR__rx_time(), d_time_pmt);
+                add_tags(entry->offset, pass_through);
+            } else if (pass_through) {
+                this->add_item_tag(
+                    0, entry->offset, PMTCONSTSTR__annotation(), entry->annotation);
+            }
+        }
+    }
+
     // Tell runtime system how many output items we produced.
     return noutput_items;
 }
@@ -11,20 +11,42 @@
 #define INCLUDED_TIMING_UTILS_ADD_USRP_TAGS_IMPL_H
 
 #include <gnuradio/timing_utils/add_usrp_tags.h>
+#include <gnuradio/timing_utils/sample_timeline.h>
 
 namespace gr {
 namespace timing_utils {
 
+/*
+ * A capture or annotation of a SigMF recording
+ */
+struct sigmf_entry_t {
+    uint64_t offset;
+    bool capture;
+    // rx_freq, rx_rate and rx_time of a capture
+    pmt::pmt_t freq;
+    pmt::pmt_t rate;
+    pmt::pmt_t time;
+    // fields of an annotation
+    pmt::pmt_t annotation;
+};
+
 template <class T>
 class add_usrp_tags_impl : public add_usrp_tags<T>
 {
 private:
+    uint32_t d_event_source;
     pmt::pmt_t d_freq_pmt;
     pmt::pmt_t d_rate_pmt;
     pmt::pmt_t d_time_pmt;
     pmt::pmt_t d_pmt_dict;
     uint64_t d_tagged_sample;
     bool d_tag_now;
+    sample_timeline::sptr d_timeline;
+    // sorted by offset
+    std::vector<sigmf_entry_t> d_sigmf;
+
+    void publish_timeline(uint64_t offset);
+    void add_tags(uint64_t offset, bool pass_through);
 
 public:
     /*!
@@ -43,6 +65,8 @@ public:
     void tag_now(uint32_t dummy) { d_tag_now = true; }
     void update_tags(pmt::pmt_t update);
     pmt::pmt_t last_tag();
+    void set_timeline(const std::string& name);
+    void set_sigmf(const std::string& filename);
 
     // Where all the action really happens
     int work(int noutput_items,
@@ -0,0 +1,204 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "burst_capture_c_impl.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/timing_utils/constants.h>
+#include <gnuradio/timing_utils/event_log.h>
+#include <boost/format.hpp>
+#include <algorithm>
+
+namespace gr {
+namespace timing_utils {
+
+burst_capture_c::sptr burst_capture_c::make(float hi, float lo, int length, int pre, int post)
+{
+    return gnuradio::make_block_sptr<burst_capture_c_impl>(hi, lo, length, pre, post);
+}
+
+/*
+ * The private constructor
+ */
+burst_capture_c_impl::burst_capture_c_impl(
+    float hi, float lo, int length, int pre, int post)
+    : gr::sync_block("burst_capture_c",
+                     gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                     gr::io_signature::make(0, 0, 0)),
+      d_trigger(mag_squared_thresh(hi), mag_squared_thresh(lo), length),
+      d_pre(std::max(pre, 0)),
+      d_post(std::max(post, 1)),
+      d_tag_idx(0),
+      d_capturing(false),
+      d_meta(pmt::PMT_NIL),
+      d_samples(pmt::PMT_NIL),
+      d_capture_start(0),
+      d_capture_next(0),
+      d_capture_end(0),
+      d_in(nullptr),
+      d_nread(0)
+{
+    d_event_source = event_log::source(symbol_name());
+    // the upstream buffer holds the pre-trigger samples
+    set_history(d_pre + 1);
+
+    message_port_register_out(PMTCONSTSTR__pdu_out());
+    message_port_register_in(PMTCONSTSTR__disarm());
+    set_msg_handler(PMTCONSTSTR__disarm(), [this](pmt::pmt_t msg) { this->disarm(msg); });
+}
+
+/*
+ * Our virtual destructor.
+ */
+burst_capture_c_impl::~burst_capture_c_impl() {}
+
+void burst_capture_c_impl::disarm(pmt::pmt_t msg)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_trigger.disarm();
+    GR_LOG_INFO(d_logger, "disarmed!");
+}
+
+void burst_capture_c_impl::set_hi(float t)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_trigger.set_hi(mag_squared_thresh(t));
+}
+
+void burst_capture_c_impl::set_lo(float t)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_trigger.set_lo(mag_squared_thresh(t));
+}
+
+void burst_capture_c_impl::set_len(int len)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_trigger.set_length(len);
+}
+
+void burst_capture_c_impl::set_rate(double rate)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_clock.set_rate(rate);
+}
+
+/*
+ * Apply rx_time and rx_rate tags up to and including sample `offset`
+ */
+void burst_capture_c_impl::update_time(uint64_t offset)
+{
+    for (; (d_tag_idx < d_tags.size()) && (d_tags[d_tag_idx].offset <= offset);
+         d_tag_idx++) {
+        const tag_t& tag = d_tags[d_tag_idx];
+        if (!d_clock.update(tag) && pmt::eq(tag.key, PMTCONSTSTR__rx_time())) {
+            GR_LOG_ERROR(d_logger, "Invalid rx_time tag value");
+        }
+    }
+}
+
+/*
+ * Begin a capture around the trigger on sample `offset`
+ */
+void burst_capture_c_impl::start_capture(uint64_t offset)
+{
+    // finish the previous capture first, the trigger is dropped if it overlaps
+    advance_capture(offset);
+    if (d_capturing) {
+        GR_LOG_DEBUG(d_logger,
+                     boost::format("trigger at %d ignored, capture in progress") % offset);
+        return;
+    }
+
+    d_capture_start = (offset > d_pre) ? (offset - d_pre) : 0;
+    d_capture_next = d_capture_start;
+    d_capture_end = offset + d_post;
+    d_samples = pmt::make_c32vector(d_capture_end - d_capture_start, gr_complex(0, 0));
+    d_capturing = true;
+
+    update_time(offset);
+    d_meta = pmt::make_dict();
+    d_meta = pmt::dict_add(d_meta, PMTCONSTSTR__rx_sample(), pmt::from_uint64(d_capture_start));
+    d_meta = pmt::dict_add(d_meta, PMTCONSTSTR__trigger_sample(), pmt::from_uint64(offset));
+    uint64_t secs;
+    double frac;
+    if (d_clock.time_at(d_capture_start, secs, frac)) {
+        d_meta = pmt::dict_add(d_meta,
+                               PMTCONSTSTR__rx_time(),
+                               pmt::make_tuple(pmt::from_uint64(secs), pmt::from_double(frac)));
+    }
+    if (d_clock.time_at(offset, secs, frac)) {
+        d_meta = pmt::dict_add(d_meta,
+                               PMTCONSTSTR__trigger_time(),
+                               pmt::cons(pmt::from_uint64(secs), pmt::from_double(frac)));
+        event_log::log(EVENT_TRIGGER, d_event_source, offset, secs + frac);
+    } else {
+        event_log::log(EVENT_TRIGGER, d_event_source, offset);
+    }
+}
+
+/*
+ * Copy the captured samples before `offset` out of the input, and publish the
+ * PDU once it is complete
+ */
+void burst_capture_c_impl::advance_capture(uint64_t offset)
+{
+    if (!d_capturing) {
+        return;
+    }
+
+    uint64_t stop = std::min(offset, d_capture_end);
+    if (stop > d_capture_next) {
+        size_t len;
+        gr_complex* dst = pmt::c32vector_writable_elements(d_samples, len);
+        memcpy(dst + (d_capture_next - d_capture_start),
+               d_in + int64_t(d_capture_next - d_nread),
+               (stop - d_capture_next) * sizeof(gr_complex));
+        d_capture_next = stop;
+    }
+
+    if (d_capture_next == d_capture_end) {
+        message_port_pub(PMTCONSTSTR__pdu_out(), pmt::cons(d_meta, d_samples));
+        d_meta = pmt::PMT_NIL;
+        d_samples = pmt::PMT_NIL;
+        d_capturing = false;
+    }
+}
+
+int burst_capture_c_impl::work(int noutput_items,
+                               gr_vector_const_void_star& input_items,
+                               gr_vector_void_star& output_items)
+{
+    gr::thread::scoped_lock l(d_setlock);
+
+    const size_t nitems = noutput_items;
+    d_nread = nitems_read(0);
+    d_in = (const gr_complex*)input_items[0] + d_pre;
+
+    get_tags_in_range(d_tags, 0, d_nread, d_nread + nitems);
+    std::sort(d_tags.begin(), d_tags.end(), tag_t::offset_compare);
+    d_tag_idx = 0;
+
+    // the trigger compares the magnitude squared to squared thresholds
+    d_trigger.scan(d_in, nitems, [this](size_t idx) { this->start_capture(d_nread + idx); });
+
+    advance_capture(d_nread + nitems);
+
+    // keep the time reference current for the next buffer
+    update_time(d_nread + nitems - 1);
+
+    // Tell runtime system how many output items we produced.
+    return noutput_items;
+}
+
+} /* namespace timing_utils */
+} /* namespace gr */
@@ -0,0 +1,78 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_BURST_CAPTURE_C_IMPL_H
+#define INCLUDED_TIMING_UTILS_BURST_CAPTURE_C_IMPL_H
+
+#include "hysteresis_trigger.h"
+#include "tag_clock.h"
+#include <gnuradio/timing_utils/burst_capture_c.h>
+
+namespace gr {
+namespace timing_utils {
+
+class burst_capture_c_impl : public burst_capture_c
+{
+private:
+    uint32_t d_event_source;
+    hysteresis_trigger d_trigger;
+    tag_clock d_clock;
+    uint64_t d_pre;
+    uint64_t d_post;
+
+    std::vector<tag_t> d_tags;
+    size_t d_tag_idx;
+
+    // capture in progress, d_samples holds absolute samples
+    // [d_capture_start, d_capture_end) and is filled up to d_capture_next
+    bool d_capturing;
+    pmt::pmt_t d_meta;
+    pmt::pmt_t d_samples;
+    uint64_t d_capture_start;
+    uint64_t d_capture_next;
+    uint64_t d_capture_end;
+
+    // input of the current work call, d_in points at sample d_nread and is
+    // preceded by d_pre samples of history
+    const gr_complex* d_in;
+    uint64_t d_nread;
+
+    void update_time(uint64_t offset);
+    void start_capture(uint64_t offset);
+    void advance_capture(uint64_t offset);
+
+public:
+    /**
+     * Constructor
+     *
+     * @param hi - high magnitude threshold
+     * @param lo - low magnitude threshold
+     * @param length - samples above the high threshold to trigger
+     * @param pre - samples captured before the trigger
+     * @param post - samples captured from the trigger on
+     */
+    burst_capture_c_impl(float hi, float lo, int length, int pre, int post);
+    ~burst_capture_c_impl();
+
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items);
+
+    void disarm(pmt::pmt_t);
+
+    void set_hi(float t);
+    void set_lo(float t);
+    void set_len(int len);
+    void set_rate(double rate);
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_BURST_CAPTURE_C_IMPL_H */
@@ -0,0 +1,127 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_CLOCK_SERVO_H
+#define INCLUDED_TIMING_UTILS_CLOCK_SERVO_H
+
+#include <cmath>
+#include <cstdint>
+
+namespace gr {
+namespace timing_utils {
+
+/*
+ * Smoothed mapping from sample offsets to host time
+ *
+ * Each update is a clock read `t` taken once sample `offset` is available.
+ * The reads are filtered by a second order loop (a delay-locked loop as
+ * used to filter audio callback times), which tracks both the time of the
+ * latest update and the sample period, so that the time of any sample can be
+ * interpolated without jumps at buffer boundaries. Until the sample period is
+ * known, after updates spanning `MIN_SPAN` seconds, times are the raw reads.
+ * A read more than `MAX_ERROR` seconds from the prediction, after a stall or
+ * an overflow, moves the time estimate to it but keeps the period.
+ */
+class clock_servo
+{
+public:
+    static constexpr double MIN_SPAN = 0.05;
+    static constexpr double MAX_ERROR = 0.5;
+
+    clock_servo(double bandwidth = 0.02)
+    {
+        set_bandwidth(bandwidth);
+        reset();
+    }
+
+    /*
+     * Loop gain per update, between 0 and 1; lower is smoother but slower
+     * to follow changes of the sample rate
+     */
+    void set_bandwidth(double bandwidth)
+    {
+        d_b = bandwidth;
+        d_c = bandwidth * bandwidth / 2.0;
+    }
+
+    void reset()
+    {
+        d_started = false;
+        d_locked = false;
+        d_offset = 0;
+        d_time = 0.0;
+        d_period = 0.0;
+        d_first_offset = 0;
+        d_first_time = 0.0;
+    }
+
+    void update(uint64_t offset, double t)
+    {
+        if (!d_started) {
+            d_started = true;
+            d_first_offset = offset;
+            d_first_time = t;
+            d_offset = offset;
+            d_time = t;
+            return;
+        }
+        if (!d_locked) {
+            // initial period from the average over the first updates
+            d_offset = offset;
+            d_time = t;
+            if ((t - d_first_time >= MIN_SPAN) && (offset > d_first_offset)) {
+                d_period = (t - d_first_time) / double(offset - d_first_offset);
+                d_locked = true;
+            }
+            return;
+        }
+
+        const int64_t nsamples = int64_t(offset - d_offset);
+        const double predicted = time_at(offset);
+        const double error = t - predicted;
+        d_offset = offset;
+        if (std::fabs(error) > MAX_ERROR || nsamples <= 0) {
+            d_time = t;
+            return;
+        }
+        d_time = predicted + d_b * error;
+        const double period = d_period + d_c * error / double(nsamples);
+        if (period > 0.0) {
+            d_period = period;
+        }
+    }
+
+    // time of sample `offset`
+    double time_at(uint64_t offset) const
+    {
+        return d_time + double(int64_t(offset - d_offset)) * d_period;
+    }
+
+    // true once the sample period is known
+    bool locked() const { return d_locked; }
+
+    // estimated sample rate, 0 until locked
+    double rate() const { return d_locked ? 1.0 / d_period : 0.0; }
+
+private:
+    double d_b;
+    double d_c;
+    bool d_started;
+    bool d_locked;
+    uint64_t d_offset;
+    double d_time;
+    double d_period;
+    uint64_t d_first_offset;
+    double d_first_time;
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_CLOCK_SERVO_H */
@@ -0,0 +1,208 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "coincidence_trigger_f_impl.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/timing_utils/constants.h>
+#include <gnuradio/timing_utils/event_log.h>
+#include <boost/format.hpp>
+#include <algorithm>
+
+namespace gr {
+namespace timing_utils {
+
+coincidence_trigger_f::sptr
+coincidence_trigger_f::make(int nchan, float hi, float lo, int length, int k, int window)
+{
+    return gnuradio::make_block_sptr<coincidence_trigger_f_impl>(
+        nchan, hi, lo, length, k, window);
+}
+
+/*
+ * The private constructor
+ */
+coincidence_trigger_f_impl::coincidence_trigger_f_impl(
+    int nchan, float hi, float lo, int length, int k, int window)
+    : gr::sync_block("coincidence_trigger_f",
+                     gr::io_signature::make(std::min(std::max(nchan, 1), MAX_CHANNELS),
+                                            std::min(std::max(nchan, 1), MAX_CHANNELS),
+                                            sizeof(float)),
+                     gr::io_signature::make(0, 0, 0)),
+      d_triggers(std::min(std::max(nchan, 1), MAX_CHANNELS),
+                 hysteresis_trigger(hi, lo, length)),
+      d_k(std::max(k, 1)),
+      d_window(std::max(window, 0)),
+      d_armed(0),
+      d_last(d_triggers.size(), 0),
+      d_tag_idx(0)
+{
+    d_event_source = event_log::source(symbol_name());
+    if ((nchan < 1) || (nchan > MAX_CHANNELS)) {
+        GR_LOG_WARN(d_logger,
+                    boost::format("%d channels not supported, using %d") % nchan %
+                        d_triggers.size());
+    }
+
+    message_port_register_out(PMTCONSTSTR__trig());
+    message_port_register_in(PMTCONSTSTR__disarm());
+    set_msg_handler(PMTCONSTSTR__disarm(), [this](pmt::pmt_t msg) { this->disarm(msg); });
+}
+
+/*
+ * Our virtual destructor.
+ */
+coincidence_trigger_f_impl::~coincidence_trigger_f_impl() {}
+
+void coincidence_trigger_f_impl::disarm(pmt::pmt_t msg)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    for (hysteresis_trigger& trigger : d_triggers) {
+        trigger.disarm();
+    }
+    d_armed = 0;
+    GR_LOG_INFO(d_logger, "disarmed!");
+}
+
+void coincidence_trigger_f_impl::set_hi(float t)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    for (hysteresis_trigger& trigger : d_triggers) {
+        trigger.set_hi(t);
+    }
+}
+
+void coincidence_trigger_f_impl::set_lo(float t)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    for (hysteresis_trigger& trigger : d_triggers) {
+        trigger.set_lo(t);
+    }
+}
+
+void coincidence_trigger_f_impl::set_len(int len)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    for (hysteresis_trigger& trigger : d_triggers) {
+        trigger.set_length(len);
+    }
+}
+
+void coincidence_trigger_f_impl::set_k(int k)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_k = std::max(k, 1);
+}
+
+void coincidence_trigger_f_impl::set_window(int window)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_window = std::max(window, 0);
+}
+
+void coincidence_trigger_f_impl::set_rate(double rate)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_clock.set_rate(rate);
+}
+
+/*
+ * Apply rx_time and rx_rate tags up to and including sample `offset`
+ */
+void coincidence_trigger_f_impl::update_time(uint64_t offset)
+{
+    for (; (d_tag_idx < d_tags.size()) && (d_tags[d_tag_idx].offset <= offset);
+         d_tag_idx++) {
+        const tag_t& tag = d_tags[d_tag_idx];
+        if (!d_clock.update(tag) && pmt::eq(tag.key, PMTCONSTSTR__rx_time())) {
+            GR_LOG_ERROR(d_logger, "Invalid rx_time tag value");
+        }
+    }
+}
+
+/*
+ * Record a trigger of channel `chan` on sample `offset`, and publish a trigger
+ * if it completes a coincidence
+ */
+void coincidence_trigger_f_impl::channel_trigger(uint64_t offset, int chan)
+{
+    d_last[chan] = offset;
+    d_armed |= (uint64_t(1) << chan);
+
+    uint64_t mask = 0;
+    uint32_t count = 0;
+    for (size_t ii = 0; ii < d_last.size(); ii++) {
+        if ((d_armed & (uint64_t(1) << ii)) && (offset - d_last[ii] <= d_window)) {
+            mask |= (uint64_t(1) << ii);
+            count++;
+        }
+    }
+    if (count < d_k) {
+        return;
+    }
+    d_armed &= ~mask;
+
+    update_time(offset);
+    pmt::pmt_t info = pmt::make_dict();
+    info = pmt::dict_add(info, PMTCONSTSTR__trigger_sample(), pmt::from_uint64(offset));
+    uint64_t secs;
+    double frac;
+    if (d_clock.time_at(offset, secs, frac)) {
+        info = pmt::dict_add(info,
+                             PMTCONSTSTR__trigger_time(),
+                             pmt::cons(pmt::from_uint64(secs), pmt::from_double(frac)));
+        event_log::log(EVENT_TRIGGER, d_event_source, offset, secs + frac);
+    } else {
+        event_log::log(EVENT_TRIGGER, d_event_source, offset);
+    }
+    info = pmt::dict_add(info, PMTCONSTSTR__channels(), pmt::from_uint64(mask));
+    message_port_pub(PMTCONSTSTR__trig(), pmt::cons(PMTCONSTSTR__trigger_now(), info));
+}
+
+int coincidence_trigger_f_impl::work(int noutput_items,
+                                     gr_vector_const_void_star& input_items,
+                                     gr_vector_void_star& output_items)
+{
+    gr::thread::scoped_lock l(d_setlock);
+
+    const size_t nitems = noutput_items;
+    const uint64_t nread = nitems_read(0);
+
+    get_tags_in_range(d_tags, 0, nread, nread + nitems);
+    std::sort(d_tags.begin(), d_tags.end(), tag_t::offset_compare);
+    d_tag_idx = 0;
+
+    // Each channel is scanned over the whole buffer with the vectorized
+    // hysteresis scan, which only reports the sparse channel triggers. The
+    // coincidence logic then runs over those in sample order.
+    d_events.clear();
+    for (size_t chan = 0; chan < d_triggers.size(); chan++) {
+        d_triggers[chan].scan((const float*)input_items[chan],
+                              nitems,
+                              [this, nread, chan](size_t idx) {
+                                  d_events.emplace_back(nread + idx, int(chan));
+                              });
+    }
+    std::sort(d_events.begin(), d_events.end());
+    for (const auto& event : d_events) {
+        channel_trigger(event.first, event.second);
+    }
+
+    // keep the time reference current for the next buffer
+    update_time(nread + nitems - 1);
+
+    // Tell runtime system how many output items we produced.
+    return noutput_items;
+}
+
+} /* namespace timing_utils */
+} /* namespace gr */
@@ -0,0 +1,75 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_COINCIDENCE_TRIGGER_F_IMPL_H
+#define INCLUDED_TIMING_UTILS_COINCIDENCE_TRIGGER_F_IMPL_H
+
+#include "hysteresis_trigger.h"
+#include "tag_clock.h"
+#include <gnuradio/timing_utils/coincidence_trigger_f.h>
+
+namespace gr {
+namespace timing_utils {
+
+class coincidence_trigger_f_impl : public coincidence_trigger_f
+{
+private:
+    uint32_t d_event_source;
+    static constexpr int MAX_CHANNELS = 64;
+
+    std::vector<hysteresis_trigger> d_triggers;
+    uint32_t d_k;
+    uint64_t d_window;
+    tag_clock d_clock;
+
+    // last trigger of each channel not yet used in a coincidence
+    uint64_t d_armed;
+    std::vector<uint64_t> d_last;
+
+    // channel triggers in the current buffer, as (offset, channel)
+    std::vector<std::pair<uint64_t, int>> d_events;
+
+    std::vector<tag_t> d_tags;
+    size_t d_tag_idx;
+
+    void update_time(uint64_t offset);
+    void channel_trigger(uint64_t offset, int chan);
+
+public:
+    /**
+     * Constructor
+     *
+     * @param nchan - number of channels
+     * @param hi - high threshold
+     * @param lo - low threshold
+     * @param length - samples above the high threshold for a channel to trigger
+     * @param k - channels needed for a coincidence
+     * @param window - coincidence window in samples
+     */
+    coincidence_trigger_f_impl(int nchan, float hi, float lo, int length, int k, int window);
+    ~coincidence_trigger_f_impl();
+
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items);
+
+    void disarm(pmt::pmt_t);
+
+    void set_hi(float t);
+    void set_lo(float t);
+    void set_len(int len);
+    void set_k(int k);
+    void set_window(int window);
+    void set_rate(double rate);
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_COINCIDENCE_TRIGGER_F_IMPL_H */
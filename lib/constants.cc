@@ -127,6 +127,111 @@ const pmt::pmt_t PMTCONSTSTR__END()
   static const pmt::pmt_t val = pmt::mp("END");
   return val;
 }
+const pmt::pmt_t PMTCONSTSTR__gap()
+{
+	static const pmt::pmt_t val = pmt::mp("gap");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__dropped()
+{
+	static const pmt::pmt_t val = pmt::mp("dropped");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__filled()
+{
+	static const pmt::pmt_t val = pmt::mp("filled");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__shed()
+{
+	static const pmt::pmt_t val = pmt::mp("shed");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__channels()
+{
+	static const pmt::pmt_t val = pmt::mp("channels");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__edge()
+{
+	static const pmt::pmt_t val = pmt::mp("edge");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__edges()
+{
+	static const pmt::pmt_t val = pmt::mp("edges");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__stats()
+{
+	static const pmt::pmt_t val = pmt::mp("stats");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__count()
+{
+	static const pmt::pmt_t val = pmt::mp("count");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__min()
+{
+	static const pmt::pmt_t val = pmt::mp("min");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__max()
+{
+	static const pmt::pmt_t val = pmt::mp("max");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__mean()
+{
+	static const pmt::pmt_t val = pmt::mp("mean");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__p50()
+{
+	static const pmt::pmt_t val = pmt::mp("p50");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__p90()
+{
+	static const pmt::pmt_t val = pmt::mp("p90");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__p99()
+{
+	static const pmt::pmt_t val = pmt::mp("p99");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__p999()
+{
+	static const pmt::pmt_t val = pmt::mp("p999");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__last()
+{
+	static const pmt::pmt_t val = pmt::mp("last");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__trace()
+{
+	static const pmt::pmt_t val = pmt::mp("trace");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__diff()
+{
+	static const pmt::pmt_t val = pmt::mp("diff");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__offsets()
+{
+	static const pmt::pmt_t val = pmt::mp("offsets");
+	return val;
+}
+const pmt::pmt_t PMTCONSTSTR__annotation()
+{
+	static const pmt::pmt_t val = pmt::mp("annotation");
+	return val;
+}
 
 }
 }
@@ -0,0 +1,170 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "edge_detector_bb_impl.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/timing_utils/constants.h>
+
+namespace gr {
+namespace timing_utils {
+
+edge_detector_bb::sptr edge_detector_bb::make(edge_mode_t mode, edge_output_t output)
+{
+    return gnuradio::make_block_sptr<edge_detector_bb_impl>(mode, output);
+}
+
+/*
+ * The private constructor
+ */
+edge_detector_bb_impl::edge_detector_bb_impl(edge_mode_t mode, edge_output_t output)
+    : gr::sync_block("edge_detector_bb",
+                     gr::io_signature::make(1, 1, sizeof(uint8_t)),
+                     gr::io_signature::make(
+                         (output == EDGE_STREAM) ? 1 : 0, 1, sizeof(uint8_t))),
+      d_mode(mode),
+      d_output(output)
+{
+    // the previous sample is kept as history, the stream starts low
+    set_history(2);
+
+    if (d_output == EDGE_OFFSETS) {
+        message_port_register_out(PMTCONSTSTR__edges());
+    }
+}
+
+/*
+ * Our virtual destructor.
+ */
+edge_detector_bb_impl::~edge_detector_bb_impl() {}
+
+void edge_detector_bb_impl::set_mode(edge_mode_t mode)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_mode = mode;
+}
+
+/*
+ * Edges are found by comparing the stream with itself shifted by one sample.
+ * The per sample test is branch-free so the compiler can vectorize the loops.
+ */
+static const size_t EDGE_CHUNK = 32;
+
+template <int MODE>
+static inline uint8_t is_edge(uint8_t prev, uint8_t cur)
+{
+    const uint8_t p = (prev != 0);
+    const uint8_t c = (cur != 0);
+    if (MODE == RISING_EDGE) {
+        return c & (p ^ 1);
+    } else if (MODE == FALLING_EDGE) {
+        return p & (c ^ 1);
+    }
+    return p ^ c;
+}
+
+// dense edge flags, `in[-1]` is the previous sample
+template <int MODE>
+static void mark_edges(const uint8_t* in, uint8_t* out, size_t n)
+{
+    for (size_t ii = 0; ii < n; ii++) {
+        out[ii] = is_edge<MODE>(in[ii - 1], in[ii]);
+    }
+}
+
+// indices of the edges, `in[-1]` is the previous sample
+template <int MODE>
+static void find_edges(const uint8_t* in, size_t n, std::vector<uint64_t>& edges)
+{
+    size_t ii = 0;
+    for (; ii + EDGE_CHUNK <= n; ii += EDGE_CHUNK) {
+        uint8_t hit = 0;
+        for (size_t jj = 0; jj < EDGE_CHUNK; jj++) {
+            hit |= is_edge<MODE>(in[ii + jj - 1], in[ii + jj]);
+        }
+        if (!hit) {
+            continue;
+        }
+        for (size_t jj = 0; jj < EDGE_CHUNK; jj++) {
+            if (is_edge<MODE>(in[ii + jj - 1], in[ii + jj])) {
+                edges.push_back(ii + jj);
+            }
+        }
+    }
+    for (; ii < n; ii++) {
+        if (is_edge<MODE>(in[ii - 1], in[ii])) {
+            edges.push_back(ii);
+        }
+    }
+}
+
+int edge_detector_bb_impl::work(int noutput_items,
+                                gr_vector_const_void_star& input_items,
+                                gr_vector_void_star& output_items)
+{
+    gr::thread::scoped_lock l(d_setlock);
+
+    // skip the history sample
+    const uint8_t* in = (const uint8_t*)input_items[0] + 1;
+    const size_t nitems = noutput_items;
+
+    if (d_output == EDGE_STREAM) {
+        uint8_t* out = (uint8_t*)output_items[0];
+        switch (d_mode) {
+        case RISING_EDGE:
+            mark_edges<RISING_EDGE>(in, out, nitems);
+            break;
+        case FALLING_EDGE:
+            mark_edges<FALLING_EDGE>(in, out, nitems);
+            break;
+        default:
+            mark_edges<ANY_EDGE>(in, out, nitems);
+        }
+        return noutput_items;
+    }
+
+    if (!output_items.empty()) {
+        memcpy(output_items[0], in, nitems);
+    }
+
+    d_edges.clear();
+    switch (d_mode) {
+    case RISING_EDGE:
+        find_edges<RISING_EDGE>(in, nitems, d_edges);
+        break;
+    case FALLING_EDGE:
+        find_edges<FALLING_EDGE>(in, nitems, d_edges);
+        break;
+    default:
+        find_edges<ANY_EDGE>(in, nitems, d_edges);
+    }
+
+    const uint64_t nread = nitems_read(0);
+    if (d_output == EDGE_TAGS) {
+        if (!output_items.empty()) {
+            for (uint64_t idx : d_edges) {
+                add_item_tag(0, nread + idx, PMTCONSTSTR__edge(), pmt::from_bool(in[idx] != 0));
+            }
+        }
+    } else if (!d_edges.empty()) {
+        for (uint64_t& idx : d_edges) {
+            idx += nread;
+        }
+        message_port_pub(PMTCONSTSTR__edges(), pmt::init_u64vector(d_edges.size(), d_edges));
+    }
+
+    // Tell runtime system how many output items we produced.
+    return noutput_items;
+}
+
+} /* namespace timing_utils */
+} /* namespace gr */
@@ -0,0 +1,45 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_EDGE_DETECTOR_BB_IMPL_H
+#define INCLUDED_TIMING_UTILS_EDGE_DETECTOR_BB_IMPL_H
+
+#include <gnuradio/timing_utils/edge_detector_bb.h>
+
+namespace gr {
+namespace timing_utils {
+
+class edge_detector_bb_impl : public edge_detector_bb
+{
+private:
+    edge_mode_t d_mode;
+    edge_output_t d_output;
+    std::vector<uint64_t> d_edges;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param mode - edges to detect
+     * @param output - how edges are reported
+     */
+    edge_detector_bb_impl(edge_mode_t mode, edge_output_t output);
+    ~edge_detector_bb_impl();
+
+    void set_mode(edge_mode_t mode);
+
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items);
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_EDGE_DETECTOR_BB_IMPL_H */
@@ -0,0 +1,109 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "edge_distance_impl.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/timing_utils/constants.h>
+#include <boost/format.hpp>
+#include <algorithm>
+
+namespace gr {
+namespace timing_utils {
+
+edge_distance::sptr edge_distance::make(double samp_rate)
+{
+    return gnuradio::make_block_sptr<edge_distance_impl>(samp_rate);
+}
+
+/*
+ * The private constructor
+ */
+edge_distance_impl::edge_distance_impl(double samp_rate)
+    : gr::sync_block("edge_distance",
+                     gr::io_signature::make(1, 1, sizeof(float)),
+                     gr::io_signature::make(0, 0, 0)),
+      d_rate(samp_rate),
+      d_started(false),
+      d_start_offset(0)
+{
+    message_port_register_out(PMTCONSTSTR__stats());
+}
+
+/*
+ * Our virtual destructor.
+ */
+edge_distance_impl::~edge_distance_impl() {}
+
+void edge_distance_impl::set_rate(double samp_rate)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_rate = samp_rate;
+}
+
+void edge_distance_impl::reset_stats()
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_hist.reset();
+}
+
+pmt::pmt_t edge_distance_impl::stats()
+{
+    gr::thread::scoped_lock l(d_setlock);
+    return d_hist.to_dict();
+}
+
+int edge_distance_impl::work(int noutput_items,
+                             gr_vector_const_void_star& input_items,
+                             gr_vector_void_star& output_items)
+{
+    gr::thread::scoped_lock l(d_setlock);
+
+    const uint64_t start = nitems_read(0);
+    const uint64_t end = start + noutput_items;
+
+    // only the START and END tags are fetched, then merged in offset order
+    get_tags_in_range(d_tags, 0, start, end, PMTCONSTSTR__START());
+    get_tags_in_range(d_end_tags, 0, start, end, PMTCONSTSTR__END());
+    if (d_end_tags.empty()) {
+        if (!d_tags.empty()) {
+            d_started = true;
+            d_start_offset = d_tags.back().offset;
+        }
+        return noutput_items;
+    }
+    d_tags.insert(d_tags.end(), d_end_tags.begin(), d_end_tags.end());
+    std::stable_sort(d_tags.begin(), d_tags.end(), tag_t::offset_compare);
+
+    uint64_t before = d_hist.count();
+    for (const tag_t& tag : d_tags) {
+        if (pmt::eq(tag.key, PMTCONSTSTR__START())) {
+            d_started = true;
+            d_start_offset = tag.offset;
+        } else if (d_started) {
+            double distance = (tag.offset - d_start_offset) * 1000.0 / d_rate;
+            GR_LOG_DEBUG(d_logger, boost::format("edge distance %0.3f ms") % distance);
+            d_hist.add(distance);
+            d_started = false;
+        }
+    }
+
+    if (d_hist.count() != before) {
+        message_port_pub(PMTCONSTSTR__stats(), d_hist.to_dict());
+    }
+
+    // Tell runtime system how many output items we produced.
+    return noutput_items;
+}
+
+} /* namespace timing_utils */
+} /* namespace gr */
@@ -0,0 +1,51 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_EDGE_DISTANCE_IMPL_H
+#define INCLUDED_TIMING_UTILS_EDGE_DISTANCE_IMPL_H
+
+#include "log_histogram.h"
+#include <gnuradio/timing_utils/edge_distance.h>
+
+namespace gr {
+namespace timing_utils {
+
+class edge_distance_impl : public edge_distance
+{
+private:
+    double d_rate;
+    bool d_started;
+    uint64_t d_start_offset;
+    log_histogram d_hist;
+
+    std::vector<tag_t> d_tags;
+    std::vector<tag_t> d_end_tags;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param samp_rate - sample rate
+     */
+    edge_distance_impl(double samp_rate);
+    ~edge_distance_impl();
+
+    void set_rate(double samp_rate);
+    void reset_stats();
+    pmt::pmt_t stats();
+
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items);
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_EDGE_DISTANCE_IMPL_H */
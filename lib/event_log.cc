@@ -0,0 +1,209 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/timing_utils/event_log.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace gr {
+namespace timing_utils {
+
+static_assert(sizeof(event_record_t) == 32, "event records must be 32 bytes");
+
+/*
+ * Log file layout: a 64 byte header followed by `capacity` records. The
+ * record for event `n` of the thread is at index `n % capacity`, and
+ * `written` is only advanced once a record is complete, so a reader sees
+ * the newest min(written, capacity) records.
+ */
+struct event_log_header_t {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t capacity;
+    std::atomic<uint64_t> written;
+    uint64_t thread_id;
+    uint64_t start_ns;
+    uint64_t reserved[2];
+};
+
+static_assert(sizeof(event_log_header_t) == 64, "event log header must be 64 bytes");
+
+static const char EVENT_LOG_MAGIC[8] = { 'T', 'U', 'E', 'V', 'L', 'O', 'G', '\0' };
+
+struct event_ring_t {
+    event_log_header_t* header;
+    event_record_t* records;
+    uint64_t mask;
+    size_t length;
+};
+
+std::atomic<bool> event_log::s_enabled(false);
+
+// everything but the per-thread writes is serialized by this lock
+static std::mutex s_lock;
+static std::string s_directory;
+static uint64_t s_capacity;
+static std::vector<event_ring_t> s_rings;
+static std::vector<std::string> s_sources;
+// incremented on every open so threads drop rings from an earlier one
+static std::atomic<uint64_t> s_generation(0);
+
+static thread_local event_ring_t* t_ring = nullptr;
+static thread_local uint64_t t_generation = 0;
+
+static uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000ull + uint64_t(ts.tv_nsec);
+}
+
+// must be called with s_lock held
+static void write_sources()
+{
+    std::string path = s_directory + "/sources.csv";
+    FILE* fp = fopen(path.c_str(), "w");
+    if (!fp) {
+        return;
+    }
+    fputs("source,name\n", fp);
+    for (size_t ii = 0; ii < s_sources.size(); ii++) {
+        fprintf(fp, "%zu,%s\n", ii, s_sources[ii].c_str());
+    }
+    fclose(fp);
+}
+
+// must be called with s_lock held, returns nullptr if the file can't be mapped
+static event_ring_t* create_ring()
+{
+    std::string path =
+        s_directory + "/events-" + std::to_string(s_rings.size()) + ".bin";
+    size_t length = sizeof(event_log_header_t) + s_capacity * sizeof(event_record_t);
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return nullptr;
+    }
+    void* base = MAP_FAILED;
+    if (ftruncate(fd, length) == 0) {
+        base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        return nullptr;
+    }
+
+    event_log_header_t* header = new (base) event_log_header_t;
+    memcpy(header->magic, EVENT_LOG_MAGIC, sizeof(header->magic));
+    header->version = 1;
+    header->record_size = sizeof(event_record_t);
+    header->capacity = s_capacity;
+    header->written.store(0, std::memory_order_relaxed);
+    header->thread_id = uint64_t(syscall(SYS_gettid));
+    header->start_ns = now_ns();
+
+    event_ring_t ring;
+    ring.header = header;
+    ring.records = (event_record_t*)((char*)base + sizeof(event_log_header_t));
+    ring.mask = s_capacity - 1;
+    ring.length = length;
+    s_rings.push_back(ring);
+    return &s_rings.back();
+}
+
+bool event_log::open(const std::string& directory, size_t capacity)
+{
+    std::lock_guard<std::mutex> l(s_lock);
+    if (s_enabled) {
+        return false;
+    }
+
+    s_directory = directory;
+    s_capacity = 1;
+    while (s_capacity < capacity) {
+        s_capacity <<= 1;
+    }
+    // rings are handed out by pointer, so the vector must never reallocate
+    s_rings.clear();
+    s_rings.reserve(1024);
+    write_sources();
+
+    s_generation++;
+    s_enabled = true;
+    return true;
+}
+
+void event_log::close()
+{
+    std::lock_guard<std::mutex> l(s_lock);
+    if (!s_enabled) {
+        return;
+    }
+    s_enabled = false;
+
+    for (event_ring_t& ring : s_rings) {
+        msync(ring.header, ring.length, MS_SYNC);
+        munmap(ring.header, ring.length);
+    }
+    s_rings.clear();
+    write_sources();
+}
+
+uint32_t event_log::source(const std::string& name)
+{
+    std::lock_guard<std::mutex> l(s_lock);
+    s_sources.push_back(name);
+    if (s_enabled) {
+        write_sources();
+    }
+    return uint32_t(s_sources.size() - 1);
+}
+
+void event_log::write(event_type_t type, uint32_t source, uint64_t offset, double value)
+{
+    // the first event of each thread creates its ring
+    if (t_generation != s_generation.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> l(s_lock);
+        if (!s_enabled) {
+            return;
+        }
+        // threads beyond the reserved number of rings are not logged
+        t_ring = (s_rings.size() < s_rings.capacity()) ? create_ring() : nullptr;
+        t_generation = s_generation;
+    }
+    if (!t_ring) {
+        return;
+    }
+
+    const uint64_t idx = t_ring->header->written.load(std::memory_order_relaxed);
+    event_record_t& rec = t_ring->records[idx & t_ring->mask];
+    rec.time_ns = now_ns();
+    rec.source = source;
+    rec.type = uint16_t(type);
+    rec.reserved = 0;
+    rec.offset = offset;
+    rec.value = value;
+    t_ring->header->written.store(idx + 1, std::memory_order_release);
+}
+
+} /* namespace timing_utils */
+} /* namespace gr */
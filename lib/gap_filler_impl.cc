@@ -0,0 +1,269 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gap_filler_impl.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/timing_utils/constants.h>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace gr {
+namespace timing_utils {
+
+template <class T>
+typename gap_filler<T>::sptr gap_filler<T>::make(double rate, bool fill, uint64_t max_fill)
+{
+    return gnuradio::make_block_sptr<gap_filler_impl<T>>(rate, fill, max_fill);
+}
+
+/*
+ * The private constructor
+ */
+template <class T>
+gap_filler_impl<T>::gap_filler_impl(double rate, bool fill, uint64_t max_fill)
+    : gr::block("gap_filler",
+                gr::io_signature::make(1, 1, sizeof(T)),
+                gr::io_signature::make(1, 1, sizeof(T))),
+      d_rate(rate),
+      d_fill(fill),
+      d_max_fill(max_fill),
+      d_anchored(false),
+      d_anchor_offset(0),
+      d_anchor_secs(0),
+      d_anchor_frac(0.0),
+      d_next_unchecked(0),
+      d_fill_remaining(0),
+      d_inserted(0),
+      d_gaps(0),
+      d_dropped(0),
+      d_filled(0)
+{
+    this->message_port_register_out(PMTCONSTSTR__gap());
+
+    // output offsets move when samples are inserted, so tags are propagated
+    // in the work function
+    this->set_tag_propagation_policy(gr::block::TPP_DONT);
+}
+
+/*
+ * Our virtual destructor.
+ */
+template <class T>
+gap_filler_impl<T>::~gap_filler_impl()
+{
+}
+
+template <class T>
+void gap_filler_impl<T>::set_fill(bool fill)
+{
+    gr::thread::scoped_lock l(this->d_setlock);
+    d_fill = fill;
+}
+
+template <class T>
+void gap_filler_impl<T>::set_max_fill(uint64_t max_fill)
+{
+    gr::thread::scoped_lock l(this->d_setlock);
+    d_max_fill = max_fill;
+}
+
+template <class T>
+void gap_filler_impl<T>::set_rate(double rate)
+{
+    gr::thread::scoped_lock l(this->d_setlock);
+    d_rate = rate;
+}
+
+template <class T>
+void gap_filler_impl<T>::forecast(int noutput_items, gr_vector_int& ninput_items_required)
+{
+    // pending zero samples are produced without consuming any input
+    uint64_t needed = noutput_items;
+    ninput_items_required[0] =
+        (needed > d_fill_remaining) ? static_cast<int>(needed - d_fill_remaining) : 0;
+}
+
+/*
+ * Compare the timing tags on input sample `in_offset` with the time predicted
+ * by the sample count, and schedule zero samples if samples were dropped.
+ */
+template <class T>
+void gap_filler_impl<T>::check_timing(uint64_t in_offset, uint64_t out_offset)
+{
+    pmt::pmt_t time_pmt = pmt::PMT_NIL;
+    pmt::pmt_t rate_pmt = pmt::PMT_NIL;
+    for (const tag_t& tag : d_tags) {
+        if (tag.offset != in_offset) {
+            continue;
+        }
+        if (pmt::eq(tag.key, PMTCONSTSTR__rx_time())) {
+            time_pmt = tag.value;
+        } else if (pmt::eq(tag.key, PMTCONSTSTR__rx_rate())) {
+            rate_pmt = tag.value;
+        }
+    }
+
+    // time of this sample predicted from the current anchor
+    uint64_t pred_secs = 0;
+    double pred_frac = 0.0;
+    if (d_anchored) {
+        double t_frac = d_anchor_frac + (in_offset - d_anchor_offset) / d_rate;
+        double whole_secs = std::floor(t_frac);
+        pred_secs = d_anchor_secs + uint64_t(whole_secs);
+        pred_frac = t_frac - whole_secs;
+    }
+
+    if (pmt::is_real(rate_pmt) && pmt::to_double(rate_pmt) > 0.0) {
+        d_rate = pmt::to_double(rate_pmt);
+    }
+
+    if (pmt::is_null(time_pmt)) {
+        // a rate change only re-anchors at the predicted time
+        if (d_anchored && !pmt::is_null(rate_pmt)) {
+            d_anchor_offset = in_offset;
+            d_anchor_secs = pred_secs;
+            d_anchor_frac = pred_frac;
+        }
+        return;
+    }
+
+    uint64_t secs;
+    double frac;
+    try {
+        secs = pmt::to_uint64(pmt::tuple_ref(time_pmt, 0));
+        frac = pmt::to_double(pmt::tuple_ref(time_pmt, 1));
+    } catch (...) {
+        GR_LOG_ERROR(this->d_logger, "Invalid rx_time tag value");
+        return;
+    }
+
+    if (d_anchored) {
+        double late = int64_t(secs - pred_secs) + (frac - pred_frac);
+        int64_t missing = std::llround(late * d_rate);
+
+        if (missing > 0) {
+            uint64_t filled = (d_fill && uint64_t(missing) <= d_max_fill) ? missing : 0;
+            d_fill_remaining = filled;
+            d_gaps++;
+            d_dropped += missing;
+            d_filled += filled;
+
+            GR_LOG_WARN(this->d_logger,
+                        boost::format("%d samples dropped before sample %d, %d filled") %
+                            missing % out_offset % filled);
+
+            // the tagged sample follows the inserted zeros
+            pmt::pmt_t dict = pmt::make_dict();
+            dict = pmt::dict_add(
+                dict, PMTCONSTSTR__rx_sample(), pmt::from_uint64(out_offset + filled));
+            dict = pmt::dict_add(dict, PMTCONSTSTR__rx_time(), time_pmt);
+            dict = pmt::dict_add(dict, PMTCONSTSTR__dropped(), pmt::from_uint64(missing));
+            dict = pmt::dict_add(dict, PMTCONSTSTR__filled(), pmt::from_uint64(filled));
+            this->message_port_pub(PMTCONSTSTR__gap(), dict);
+
+            this->add_item_tag(
+                0, out_offset, PMTCONSTSTR__gap(), pmt::from_uint64(missing));
+        } else if (missing < 0) {
+            GR_LOG_WARN(this->d_logger,
+                        boost::format("rx_time at sample %d is %d samples earlier than "
+                                      "expected, re-anchoring") %
+                            out_offset % -missing);
+        }
+    }
+
+    d_anchored = true;
+    d_anchor_offset = in_offset;
+    d_anchor_secs = secs;
+    d_anchor_frac = frac;
+}
+
+template <class T>
+int gap_filler_impl<T>::general_work(int noutput_items,
+                                     gr_vector_int& ninput_items,
+                                     gr_vector_const_void_star& input_items,
+                                     gr_vector_void_star& output_items)
+{
+    gr::thread::scoped_lock l(this->d_setlock);
+
+    const T* in = (const T*)input_items[0];
+    T* out = (T*)output_items[0];
+
+    const uint64_t nread = this->nitems_read(0);
+    const uint64_t nwritten = this->nitems_written(0);
+    const uint64_t in_end = nread + ninput_items[0];
+
+    this->get_tags_in_range(d_tags, 0, nread, in_end);
+    std::sort(d_tags.begin(), d_tags.end(), tag_t::offset_compare);
+
+    size_t tag_idx = 0;
+    int nconsumed = 0;
+    int nproduced = 0;
+    while (nproduced < noutput_items) {
+        if (d_fill_remaining) {
+            uint64_t nzeros = std::min(d_fill_remaining, uint64_t(noutput_items - nproduced));
+            std::fill(out + nproduced, out + nproduced + nzeros, T());
+            nproduced += nzeros;
+            d_fill_remaining -= nzeros;
+            d_inserted += nzeros;
+            continue;
+        }
+
+        uint64_t offset = nread + nconsumed;
+        if (offset == in_end) {
+            break;
+        }
+
+        if (offset >= d_next_unchecked) {
+            check_timing(offset, nwritten + nproduced);
+            d_next_unchecked = offset + 1;
+            if (d_fill_remaining) {
+                continue;
+            }
+        }
+
+        // copy up to the next sample with a timing tag
+        uint64_t run_end = in_end;
+        for (size_t ii = tag_idx; ii < d_tags.size(); ii++) {
+            if ((d_tags[ii].offset > offset) &&
+                (pmt::eq(d_tags[ii].key, PMTCONSTSTR__rx_time()) ||
+                 pmt::eq(d_tags[ii].key, PMTCONSTSTR__rx_rate()))) {
+                run_end = d_tags[ii].offset;
+                break;
+            }
+        }
+        int ncopy = std::min(run_end - offset, uint64_t(noutput_items - nproduced));
+        memcpy(out + nproduced, in + nconsumed, ncopy * sizeof(T));
+
+        // propagate tags on the copied samples to their new offsets
+        while ((tag_idx < d_tags.size()) && (d_tags[tag_idx].offset < offset + ncopy)) {
+            const tag_t& tag = d_tags[tag_idx++];
+            this->add_item_tag(0, tag.offset + d_inserted, tag.key, tag.value, tag.srcid);
+        }
+
+        nconsumed += ncopy;
+        nproduced += ncopy;
+        d_next_unchecked = std::max(d_next_unchecked, offset + ncopy);
+    }
+
+    this->consume(0, nconsumed);
+    return nproduced;
+}
+
+template class gap_filler<unsigned char>;
+template class gap_filler<short>;
+template class gap_filler<int32_t>;
+template class gap_filler<float>;
+template class gap_filler<gr_complex>;
+} /* namespace timing_utils */
+} /* namespace gr */
@@ -0,0 +1,77 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_GAP_FILLER_IMPL_H
+#define INCLUDED_TIMING_UTILS_GAP_FILLER_IMPL_H
+
+#include <gnuradio/timing_utils/gap_filler.h>
+
+namespace gr {
+namespace timing_utils {
+
+template <class T>
+class gap_filler_impl : public gap_filler<T>
+{
+private:
+    double d_rate;
+    bool d_fill;
+    uint64_t d_max_fill;
+
+    // time of the last rx_time tag (or rate change), by input sample
+    bool d_anchored;
+    uint64_t d_anchor_offset;
+    uint64_t d_anchor_secs;
+    double d_anchor_frac;
+
+    // input samples before this one have had their timing tags checked
+    uint64_t d_next_unchecked;
+    // zero samples still to be written before the next input sample
+    uint64_t d_fill_remaining;
+    // difference between output and input sample indices
+    uint64_t d_inserted;
+
+    uint64_t d_gaps;
+    uint64_t d_dropped;
+    uint64_t d_filled;
+
+    std::vector<tag_t> d_tags;
+
+    void check_timing(uint64_t in_offset, uint64_t out_offset);
+
+public:
+    /*!
+     * Constructor
+     *
+     * \param rate Sampling rate (Hz)
+     * \param fill Insert zero samples in place of dropped samples
+     * \param max_fill Largest gap to fill (samples)
+     */
+    gap_filler_impl(double rate, bool fill, uint64_t max_fill);
+    ~gap_filler_impl();
+
+    void set_fill(bool fill);
+    void set_max_fill(uint64_t max_fill);
+    void set_rate(double rate);
+    uint64_t gaps() { return d_gaps; }
+    uint64_t dropped() { return d_dropped; }
+    uint64_t filled() { return d_filled; }
+
+    void forecast(int noutput_items, gr_vector_int& ninput_items_required);
+
+    // Where all the action really happens
+    int general_work(int noutput_items,
+                     gr_vector_int& ninput_items,
+                     gr_vector_const_void_star& input_items,
+                     gr_vector_void_star& output_items);
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_GAP_FILLER_IMPL_H */
@@ -0,0 +1,344 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_HYSTERESIS_TRIGGER_H
+#define INCLUDED_TIMING_UTILS_HYSTERESIS_TRIGGER_H
+
+#include <gnuradio/gr_complex.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gr {
+namespace timing_utils {
+
+/*
+ * Threshold scans over a whole buffer. Samples are tested in fixed size chunks
+ * with branch-free reductions so the compiler can vectorize the compares, and
+ * only the chunk containing the match is searched sample by sample. Complex
+ * samples are compared by magnitude squared, computed in the same pass.
+ */
+static const size_t SCAN_CHUNK = 16;
+
+inline float trigger_level(float x) { return x; }
+inline float trigger_level(const gr_complex& x)
+{
+    return x.real() * x.real() + x.imag() * x.imag();
+}
+
+// index of the first sample above `thresh`, or `n` if there is none
+template <class T>
+size_t find_above(const T* x, size_t n, float thresh)
+{
+    size_t ii = 0;
+    for (; ii + SCAN_CHUNK <= n; ii += SCAN_CHUNK) {
+        bool hit = false;
+        for (size_t jj = 0; jj < SCAN_CHUNK; jj++) {
+            hit |= (trigger_level(x[ii + jj]) > thresh);
+        }
+        if (hit) {
+            break;
+        }
+    }
+    for (; ii < n; ii++) {
+        if (trigger_level(x[ii]) > thresh) {
+            return ii;
+        }
+    }
+    return n;
+}
+
+// index of the first sample not above `thresh`, or `n` if there is none
+template <class T>
+size_t find_not_above(const T* x, size_t n, float thresh)
+{
+    size_t ii = 0;
+    for (; ii + SCAN_CHUNK <= n; ii += SCAN_CHUNK) {
+        bool hit = false;
+        for (size_t jj = 0; jj < SCAN_CHUNK; jj++) {
+            hit |= !(trigger_level(x[ii + jj]) > thresh);
+        }
+        if (hit) {
+            break;
+        }
+    }
+    for (; ii < n; ii++) {
+        if (!(trigger_level(x[ii]) > thresh)) {
+            return ii;
+        }
+    }
+    return n;
+}
+
+// true if any sample is below `thresh`
+template <class T>
+bool any_below(const T* x, size_t n, float thresh)
+{
+    bool hit = false;
+    for (size_t ii = 0; ii < n; ii++) {
+        hit |= (trigger_level(x[ii]) < thresh);
+    }
+    return hit;
+}
+
+// sum of the sample levels, accumulated in lanes so the compiler can vectorize it
+template <class T>
+float level_sum(const T* x, size_t n)
+{
+    float acc[SCAN_CHUNK] = {};
+    size_t ii = 0;
+    for (; ii + SCAN_CHUNK <= n; ii += SCAN_CHUNK) {
+        for (size_t jj = 0; jj < SCAN_CHUNK; jj++) {
+            acc[jj] += trigger_level(x[ii + jj]);
+        }
+    }
+    float sum = 0;
+    for (size_t jj = 0; jj < SCAN_CHUNK; jj++) {
+        sum += acc[jj];
+    }
+    for (; ii < n; ii++) {
+        sum += trigger_level(x[ii]);
+    }
+    return sum;
+}
+
+/*
+ * Threshold on the magnitude squared equivalent to `thresh` on the magnitude,
+ * negative thresholds keep their meaning of always (or never) being crossed
+ */
+inline float mag_squared_thresh(float thresh)
+{
+    return (thresh < 0) ? -(thresh * thresh) : (thresh * thresh);
+}
+
+/*
+ * Hysteresis trigger state shared by the threshold trigger blocks
+ *
+ * A trigger fires on the `length`-th consecutive sample above the high
+ * threshold. Blanking starts above the high threshold and stops below the
+ * low threshold. State carries over between calls to scan(), so a stream can
+ * be fed in buffers or chunks of any size. Complex samples are tested by
+ * magnitude squared, see mag_squared_thresh().
+ */
+class hysteresis_trigger
+{
+public:
+    hysteresis_trigger(float hi, float lo, uint64_t length)
+        : d_thresh_hi(hi),
+          d_thresh_lo(lo),
+          d_blank(false),
+          d_blanked(false),
+          d_length_thresh(length),
+          d_length(0)
+    {
+    }
+
+    void set_hi(float t) { d_thresh_hi = t; }
+    void set_lo(float t) { d_thresh_lo = t; }
+    void set_length(uint64_t len) { d_length_thresh = len; }
+    float hi() const { return d_thresh_hi; }
+    float lo() const { return d_thresh_lo; }
+    bool blanking() const { return d_blank; }
+
+    // true if the trigger has been blanking at any point since mark_blanking()
+    bool blanked() const { return d_blanked; }
+    void mark_blanking() { d_blanked = d_blank; }
+
+    // effectively disables the trigger until the current run ends
+    void disarm() { d_length = d_length_thresh + 1; }
+
+    /*
+     * Scan `n` samples, calling `on_trigger(index)` with the index in `x` of
+     * each triggering sample
+     */
+    template <class T, class F>
+    void scan(const T* x, size_t n, F on_trigger)
+    {
+        // The samples are handled as alternating runs above and not above the
+        // high threshold. d_length counts the samples in the current run above
+        // it, and carries over into the next call if the run is not finished.
+        size_t ii = 0;
+        while (ii < n) {
+            if (d_length || (trigger_level(x[ii]) > d_thresh_hi)) {
+                // blank while over the high threshold
+                size_t run = find_not_above(x + ii, n - ii, d_thresh_hi);
+                if (run) {
+                    d_blank = true;
+                    d_blanked = true;
+                }
+
+                // trigger on the `length`-th sample of the run
+                if ((d_length < d_length_thresh) && (d_length_thresh - d_length <= run)) {
+                    on_trigger(ii + (d_length_thresh - d_length - 1));
+                }
+                d_length += run;
+                ii += run;
+                if (ii == n) {
+                    break;
+                }
+            }
+
+            // the run is over, stop blanking when under the low threshold
+            size_t gap = find_above(x + ii, n - ii, d_thresh_hi);
+            if (any_below(x + ii, gap, d_thresh_lo)) {
+                d_blank = false;
+            }
+            d_length = 0;
+            ii += gap;
+        }
+    }
+
+private:
+    float d_thresh_hi;
+    float d_thresh_lo;
+    bool d_blank;
+    bool d_blanked;
+    uint64_t d_length_thresh;
+    uint64_t d_length;
+};
+
+/*
+ * Cell-averaging CFAR for a hysteresis_trigger
+ *
+ * The noise level is the mean sample level over the last `window` samples,
+ * kept as a ring of sums over CHUNK samples so each update is O(1). Before each
+ * chunk is scanned, the trigger thresholds are set to the high and low ratios
+ * times the noise level of the previous chunks. Chunks where the trigger is
+ * blanking are left out of the estimate so signals do not raise the noise
+ * floor, unless a whole window in a row would be left out, which happens when
+ * the noise floor steps up. No triggers fire until one chunk has been
+ * measured.
+ */
+class ca_cfar
+{
+public:
+    static const size_t CHUNK = 64;
+
+    ca_cfar(float hi, float lo)
+        : d_hi(hi),
+          d_lo(lo),
+          d_idx(0),
+          d_count(0),
+          d_total(0.0),
+          d_partial(0.0f),
+          d_partial_n(0),
+          d_skipped(0)
+    {
+    }
+
+    void set_hi(float ratio) { d_hi = ratio; }
+    void set_lo(float ratio) { d_lo = ratio; }
+    float hi() const { return d_hi; }
+    float lo() const { return d_lo; }
+
+    // window length in samples, rounded up to whole chunks, zero disables
+    void set_window(size_t window)
+    {
+        d_sums.assign((window + CHUNK - 1) / CHUNK, 0.0f);
+        restart();
+        d_partial = 0.0f;
+        d_partial_n = 0;
+        d_skipped = 0;
+    }
+    bool enabled() const { return !d_sums.empty(); }
+
+    // mean sample level, zero until a chunk has been measured
+    float noise() const { return d_count ? float(d_total / (d_count * CHUNK)) : 0.0f; }
+
+    /*
+     * Scan `n` samples with adaptive thresholds, calling `on_trigger(index)`
+     * with the index in `x` of each triggering sample
+     */
+    template <class T, class F>
+    void scan(hysteresis_trigger& trigger, const T* x, size_t n, F on_trigger)
+    {
+        size_t ii = 0;
+        while (ii < n) {
+            const size_t len = std::min(CHUNK - d_partial_n, n - ii);
+            if (d_partial_n == 0) {
+                trigger.mark_blanking();
+            }
+
+            if (d_count) {
+                const float level = noise();
+                trigger.set_hi(d_hi * level);
+                trigger.set_lo(d_lo * level);
+                trigger.scan(x + ii, len, [&](size_t idx) { on_trigger(ii + idx); });
+            }
+
+            d_partial += level_sum(x + ii, len);
+            d_partial_n += len;
+            ii += len;
+
+            if (d_partial_n == CHUNK) {
+                // after a window of blanked chunks the floor has moved, so the
+                // estimate restarts at the new level and follows it until the
+                // trigger settles
+                if (!trigger.blanked()) {
+                    d_skipped = 0;
+                } else if (d_skipped < d_sums.size()) {
+                    d_skipped++;
+                    if (d_skipped == d_sums.size()) {
+                        restart();
+                    }
+                }
+                if ((d_skipped == 0 || d_skipped == d_sums.size()) &&
+                    std::isfinite(d_partial)) {
+                    push(d_partial);
+                }
+                d_partial = 0.0f;
+                d_partial_n = 0;
+            }
+        }
+    }
+
+private:
+    float d_hi;
+    float d_lo;
+
+    std::vector<float> d_sums;
+    size_t d_idx;
+    size_t d_count;
+    double d_total;
+
+    float d_partial;
+    size_t d_partial_n;
+    size_t d_skipped;
+
+    void restart()
+    {
+        std::fill(d_sums.begin(), d_sums.end(), 0.0f);
+        d_idx = 0;
+        d_count = 0;
+        d_total = 0.0;
+    }
+
+    void push(float sum)
+    {
+        d_total += sum - d_sums[d_idx];
+        d_sums[d_idx] = sum;
+        d_idx = (d_idx + 1) % d_sums.size();
+        d_count = std::min(d_count + 1, d_sums.size());
+
+        // recompute once per window so rounding errors do not accumulate
+        if (d_idx == 0) {
+            d_total = 0.0;
+            for (float s : d_sums) {
+                d_total += s;
+            }
+        }
+    }
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_HYSTERESIS_TRIGGER_H */
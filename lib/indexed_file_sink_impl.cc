@@ -0,0 +1,254 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "indexed_file_sink_impl.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/timing_utils/constants.h>
+#include <boost/format.hpp>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace gr {
+namespace timing_utils {
+
+// O_DIRECT transfers must be aligned to the logical block size of the device
+static const size_t DIRECT_ALIGNMENT = 4096;
+
+indexed_file_sink::sptr indexed_file_sink::make(const std::string& filename,
+                                                size_t itemsize,
+                                                double samp_rate,
+                                                bool direct,
+                                                size_t buffer_size,
+                                                bool use_rx_rate)
+{
+    return gnuradio::make_block_sptr<indexed_file_sink_impl>(
+        filename, itemsize, samp_rate, direct, buffer_size, use_rx_rate);
+}
+
+/*
+ * The private constructor
+ */
+indexed_file_sink_impl::indexed_file_sink_impl(const std::string& filename,
+                                               size_t itemsize,
+                                               double samp_rate,
+                                               bool direct,
+                                               size_t buffer_size,
+                                               bool use_rx_rate)
+    : gr::sync_block("indexed_file_sink",
+                     gr::io_signature::make(1, 1, itemsize),
+                     gr::io_signature::make(0, 0, 0)),
+      d_itemsize(itemsize),
+      d_direct(direct),
+      d_use_rx_rate(use_rx_rate),
+      d_index_fp(nullptr),
+      d_buffer(nullptr),
+      d_buffer_fill(0),
+      d_bytes_written(0),
+      d_index_entries(0)
+{
+    d_buffer_size =
+        std::max((buffer_size + DIRECT_ALIGNMENT - 1) / DIRECT_ALIGNMENT, size_t(1)) *
+        DIRECT_ALIGNMENT;
+
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+    d_fd = ::open(filename.c_str(), flags | (d_direct ? O_DIRECT : 0), 0644);
+    if ((d_fd < 0) && d_direct && (errno == EINVAL)) {
+        GR_LOG_WARN(d_logger,
+                    boost::format("O_DIRECT not supported for %s, using buffered writes") %
+                        filename);
+        d_direct = false;
+        d_fd = ::open(filename.c_str(), flags, 0644);
+    }
+    if (d_fd < 0) {
+        throw std::runtime_error((boost::format("can't open recording %s: %s") %
+                                  filename % strerror(errno))
+                                     .str());
+    }
+
+    std::string index_filename = filename + ".idx";
+    d_index_fp = fopen(index_filename.c_str(), "wb");
+    if (!d_index_fp) {
+        ::close(d_fd);
+        throw std::runtime_error((boost::format("can't open index %s: %s") %
+                                  index_filename % strerror(errno))
+                                     .str());
+    }
+    record_index_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, RECORD_INDEX_MAGIC, sizeof(header.magic));
+    header.version = RECORD_INDEX_VERSION;
+    header.entry_size = sizeof(record_index_entry_t);
+    header.itemsize = itemsize;
+    header.rate = samp_rate;
+    fwrite(&header, sizeof(header), 1, d_index_fp);
+    fflush(d_index_fp);
+
+    if (posix_memalign((void**)&d_buffer, DIRECT_ALIGNMENT, d_buffer_size) != 0) {
+        ::close(d_fd);
+        fclose(d_index_fp);
+        throw std::bad_alloc();
+    }
+}
+
+/*
+ * Our virtual destructor.
+ */
+indexed_file_sink_impl::~indexed_file_sink_impl()
+{
+    ::close(d_fd);
+    fclose(d_index_fp);
+    free(d_buffer);
+}
+
+uint64_t indexed_file_sink_impl::index_entries()
+{
+    gr::thread::scoped_lock l(d_setlock);
+    return d_index_entries;
+}
+
+void indexed_file_sink_impl::add_entry(uint64_t sample,
+                                       record_index_type_t type,
+                                       uint64_t secs,
+                                       double value)
+{
+    record_index_entry_t entry;
+    entry.sample = sample;
+    entry.type = type;
+    entry.reserved = 0;
+    entry.secs = secs;
+    entry.value = value;
+    d_entries.push_back(entry);
+}
+
+/*
+ * Write the entries for the samples written so far
+ */
+void indexed_file_sink_impl::write_entries()
+{
+    const uint64_t nitems = d_bytes_written / d_itemsize;
+    size_t n = 0;
+    while ((n < d_entries.size()) && (d_entries[n].sample < nitems)) {
+        n++;
+    }
+    if (n) {
+        fwrite(d_entries.data(), sizeof(record_index_entry_t), n, d_index_fp);
+        fflush(d_index_fp);
+        d_entries.erase(d_entries.begin(), d_entries.begin() + n);
+        d_index_entries += n;
+    }
+}
+
+/*
+ * Write the first `nbytes` of the buffer, which must be the whole buffer
+ * while writing with O_DIRECT
+ */
+bool indexed_file_sink_impl::write_buffer(size_t nbytes)
+{
+    size_t written = 0;
+    while (written < nbytes) {
+        ssize_t n = ::write(d_fd, d_buffer + written, nbytes - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            GR_LOG_ERROR(d_logger,
+                         boost::format("recording write failed: %s") % strerror(errno));
+            return false;
+        }
+        written += n;
+    }
+    d_bytes_written += nbytes;
+
+    // the index only refers to samples already written
+    write_entries();
+    return true;
+}
+
+bool indexed_file_sink_impl::stop()
+{
+    gr::thread::scoped_lock l(d_setlock);
+
+    // the last partial buffer can not be written with O_DIRECT
+    if (d_buffer_fill) {
+        if (d_direct) {
+            fcntl(d_fd, F_SETFL, fcntl(d_fd, F_GETFL) & ~O_DIRECT);
+            d_direct = false;
+        }
+        write_buffer(d_buffer_fill);
+        d_buffer_fill = 0;
+    }
+    return true;
+}
+
+int indexed_file_sink_impl::work(int noutput_items,
+                                 gr_vector_const_void_star& input_items,
+                                 gr_vector_void_star& output_items)
+{
+    gr::thread::scoped_lock l(d_setlock);
+
+    const char* in = (const char*)input_items[0];
+
+    // index the timing tags, in offset order
+    const uint64_t nread = nitems_read(0);
+    get_tags_in_range(d_tags, 0, nread, nread + noutput_items);
+    for (const tag_t& tag : d_tags) {
+        if (pmt::eq(tag.key, PMTCONSTSTR__rx_time())) {
+            if (pmt::is_tuple(tag.value) && (pmt::length(tag.value) >= 2) &&
+                pmt::is_uint64(pmt::tuple_ref(tag.value, 0)) &&
+                pmt::is_real(pmt::tuple_ref(tag.value, 1))) {
+                add_entry(tag.offset,
+                          INDEX_TIME,
+                          pmt::to_uint64(pmt::tuple_ref(tag.value, 0)),
+                          pmt::to_double(pmt::tuple_ref(tag.value, 1)));
+            }
+        } else if (pmt::eq(tag.key, PMTCONSTSTR__rx_rate())) {
+            if (d_use_rx_rate && pmt::is_real(tag.value)) {
+                add_entry(tag.offset, INDEX_RATE, 0, pmt::to_double(tag.value));
+            }
+        } else if (pmt::eq(tag.key, PMTCONSTSTR__rx_freq())) {
+            if (pmt::is_real(tag.value)) {
+                add_entry(tag.offset, INDEX_FREQ, 0, pmt::to_double(tag.value));
+            }
+        } else if (pmt::eq(tag.key, PMTCONSTSTR__freq())) {
+            if (pmt::is_real(tag.value)) {
+                add_entry(tag.offset, INDEX_RETUNE, 0, pmt::to_double(tag.value));
+            }
+        }
+    }
+
+    // fill the buffer, writing it out whenever it is full
+    size_t nbytes = noutput_items * d_itemsize;
+    while (nbytes) {
+        size_t n = std::min(nbytes, d_buffer_size - d_buffer_fill);
+        memcpy(d_buffer + d_buffer_fill, in, n);
+        d_buffer_fill += n;
+        in += n;
+        nbytes -= n;
+        if (d_buffer_fill == d_buffer_size) {
+            if (!write_buffer(d_buffer_size)) {
+                return WORK_DONE;
+            }
+            d_buffer_fill = 0;
+        }
+    }
+
+    // Tell runtime system how many output items we produced.
+    return noutput_items;
+}
+
+} /* namespace timing_utils */
+} /* namespace gr */
@@ -0,0 +1,74 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_INDEXED_FILE_SINK_IMPL_H
+#define INCLUDED_TIMING_UTILS_INDEXED_FILE_SINK_IMPL_H
+
+#include "record_index.h"
+#include <gnuradio/timing_utils/indexed_file_sink.h>
+#include <cstdio>
+
+namespace gr {
+namespace timing_utils {
+
+class indexed_file_sink_impl : public indexed_file_sink
+{
+private:
+    size_t d_itemsize;
+    bool d_direct;
+    bool d_use_rx_rate;
+    int d_fd;
+    FILE* d_index_fp;
+    char* d_buffer;
+    size_t d_buffer_size;
+    size_t d_buffer_fill;
+    uint64_t d_bytes_written;
+    uint64_t d_index_entries;
+
+    std::vector<tag_t> d_tags;
+    // entries for samples not yet written, in sample order
+    std::vector<record_index_entry_t> d_entries;
+
+    void add_entry(uint64_t sample, record_index_type_t type, uint64_t secs, double value);
+    void write_entries();
+    bool write_buffer(size_t nbytes);
+
+public:
+    /**
+     * Constructor
+     *
+     * @param filename - recording file
+     * @param itemsize - size of each item (bytes)
+     * @param samp_rate - nominal sample rate (Hz)
+     * @param direct - write with O_DIRECT
+     * @param buffer_size - size of each write (bytes)
+     * @param use_rx_rate - index rx_rate tags
+     */
+    indexed_file_sink_impl(const std::string& filename,
+                           size_t itemsize,
+                           double samp_rate,
+                           bool direct,
+                           size_t buffer_size,
+                           bool use_rx_rate);
+    ~indexed_file_sink_impl();
+
+    uint64_t index_entries();
+
+    // overloaded functions
+    bool stop();
+
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items);
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_INDEXED_FILE_SINK_IMPL_H */
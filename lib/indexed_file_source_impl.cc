@@ -0,0 +1,251 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "indexed_file_source_impl.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/timing_utils/constants.h>
+#include <boost/format.hpp>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace gr {
+namespace timing_utils {
+
+// bytes advised to be read ahead of the play position
+static const size_t READ_AHEAD = 64 << 20;
+
+indexed_file_source::sptr indexed_file_source::make(const std::string& filename,
+                                                    size_t itemsize,
+                                                    double samp_rate,
+                                                    double file_time,
+                                                    double seek_time,
+                                                    double end_time,
+                                                    bool repeat)
+{
+    return gnuradio::make_block_sptr<indexed_file_source_impl>(
+        filename, itemsize, samp_rate, file_time, seek_time, end_time, repeat);
+}
+
+/*
+ * The private constructor
+ */
+indexed_file_source_impl::indexed_file_source_impl(const std::string& filename,
+                                                   size_t itemsize,
+                                                   double samp_rate,
+                                                   double file_time,
+                                                   double seek_time,
+                                                   double end_time,
+                                                   bool repeat)
+    : gr::sync_block("indexed_file_source",
+                     gr::io_signature::make(0, 0, 0),
+                     gr::io_signature::make(1, 1, itemsize)),
+      d_itemsize(itemsize),
+      d_repeat(repeat),
+      d_fd(-1),
+      d_base(nullptr),
+      d_length(0),
+      d_index(samp_rate),
+      d_page_size(sysconf(_SC_PAGESIZE))
+{
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    struct stat st;
+    if ((fd < 0) || (fstat(fd, &st) != 0)) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        throw std::runtime_error((boost::format("can't open recording %s: %s") %
+                                  filename % strerror(errno))
+                                     .str());
+    }
+    d_length = st.st_size;
+    if (d_length < d_itemsize) {
+        ::close(fd);
+        throw std::runtime_error(
+            (boost::format("recording %s holds no items") % filename).str());
+    }
+    void* base = mmap(nullptr, d_length, PROT_READ, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error((boost::format("can't map recording %s: %s") %
+                                  filename % strerror(errno))
+                                     .str());
+    }
+    d_fd = fd;
+    d_base = (const char*)base;
+    madvise(base, d_length, MADV_SEQUENTIAL);
+
+    // without an index, the time follows from the first sample and the rate
+    if (!d_index.load(filename + ".idx")) {
+        record_index_entry_t entry;
+        entry.sample = 0;
+        entry.type = INDEX_TIME;
+        entry.reserved = 0;
+        entry.secs = uint64_t(std::floor(file_time));
+        entry.value = file_time - std::floor(file_time);
+        d_index.add(entry);
+    }
+
+    if (((seek_time > 0.0) || (end_time > 0.0)) && !d_index.timed()) {
+        munmap(base, d_length);
+        ::close(fd);
+        throw std::runtime_error(
+            (boost::format("recording %s has no index or sample rate to seek with") %
+             filename)
+                .str());
+    }
+
+    const uint64_t nitems = d_length / d_itemsize;
+    d_start = 0;
+    if (seek_time > 0.0) {
+        d_start = std::min(
+            d_index.sample_at(uint64_t(seek_time), seek_time - std::floor(seek_time)),
+            nitems);
+    }
+    d_end = nitems;
+    if (end_time > 0.0) {
+        d_end = std::min(
+            d_index.sample_at(uint64_t(end_time), end_time - std::floor(end_time)),
+            nitems);
+    }
+    d_end = std::max(d_end, d_start);
+    GR_LOG_DEBUG(d_logger,
+                 boost::format("playing samples %d to %d of %d") % d_start % d_end %
+                     nitems);
+
+    seek(d_start);
+}
+
+/*
+ * Our virtual destructor.
+ */
+indexed_file_source_impl::~indexed_file_source_impl()
+{
+    munmap((void*)d_base, d_length);
+    ::close(d_fd);
+}
+
+void indexed_file_source_impl::seek(uint64_t sample)
+{
+    d_pos = sample;
+    d_tag_now = true;
+
+    // entries at the first sample are covered by its tags
+    const std::vector<record_index_entry_t>& entries = d_index.entries();
+    d_next_entry = std::upper_bound(entries.begin(),
+                                    entries.end(),
+                                    sample,
+                                    [](uint64_t s, const record_index_entry_t& e) {
+                                        return s < e.sample;
+                                    }) -
+                   entries.begin();
+
+    d_ahead = page_floor(d_pos * d_itemsize);
+    d_released = d_ahead;
+}
+
+void indexed_file_source_impl::add_time_tag(uint64_t offset, uint64_t secs, double frac)
+{
+    add_item_tag(0,
+                 offset,
+                 PMTCONSTSTR__rx_time(),
+                 pmt::make_tuple(pmt::from_uint64(secs), pmt::from_double(frac)));
+}
+
+int indexed_file_source_impl::work(int noutput_items,
+                                   gr_vector_const_void_star& input_items,
+                                   gr_vector_void_star& output_items)
+{
+    if (d_pos >= d_end) {
+        if (!d_repeat || (d_start == d_end)) {
+            return WORK_DONE;
+        }
+        seek(d_start);
+    }
+
+    const uint64_t nitems = std::min(uint64_t(noutput_items), d_end - d_pos);
+    const uint64_t offset = nitems_written(0);
+
+    // the first sample played carries the full set of tags
+    if (d_tag_now) {
+        uint64_t secs;
+        double frac;
+        if (d_index.time_at(d_pos, secs, frac)) {
+            add_time_tag(offset, secs, frac);
+        }
+        double rate = d_index.rate_at(d_pos);
+        if (rate > 0.0) {
+            add_item_tag(0, offset, PMTCONSTSTR__rx_rate(), pmt::from_double(rate));
+        }
+        double freq;
+        if (d_index.freq_at(d_pos, freq)) {
+            add_item_tag(0, offset, PMTCONSTSTR__rx_freq(), pmt::from_double(freq));
+        }
+        if (d_index.retune_at(d_pos, freq)) {
+            add_item_tag(0, offset, PMTCONSTSTR__freq(), pmt::from_double(freq));
+        }
+        d_tag_now = false;
+    }
+
+    // replay the index entries in this buffer
+    const std::vector<record_index_entry_t>& entries = d_index.entries();
+    while ((d_next_entry < entries.size()) &&
+           (entries[d_next_entry].sample < d_pos + nitems)) {
+        const record_index_entry_t& entry = entries[d_next_entry++];
+        const uint64_t entry_offset = offset + (entry.sample - d_pos);
+        if (entry.type == INDEX_TIME) {
+            add_time_tag(entry_offset, entry.secs, entry.value);
+        } else if (entry.type == INDEX_RATE) {
+            add_item_tag(
+                0, entry_offset, PMTCONSTSTR__rx_rate(), pmt::from_double(entry.value));
+        } else if (entry.type == INDEX_FREQ) {
+            add_item_tag(
+                0, entry_offset, PMTCONSTSTR__rx_freq(), pmt::from_double(entry.value));
+        } else if (entry.type == INDEX_RETUNE) {
+            add_item_tag(
+                0, entry_offset, PMTCONSTSTR__freq(), pmt::from_double(entry.value));
+        }
+    }
+
+    memcpy(output_items[0], d_base + d_pos * d_itemsize, nitems * d_itemsize);
+    d_pos += nitems;
+
+    // keep READ_AHEAD bytes ahead of the play position coming in
+    const size_t pos_bytes = d_pos * d_itemsize;
+    if ((d_ahead < d_length) && (pos_bytes + READ_AHEAD / 2 >= d_ahead)) {
+        const size_t ahead =
+            std::min(page_ceil(pos_bytes + READ_AHEAD), page_ceil(d_length));
+        madvise((void*)(d_base + d_ahead), ahead - d_ahead, MADV_WILLNEED);
+        d_ahead = ahead;
+    }
+    // release what has been played: MADV_DONTNEED only unmaps the pages
+    // from this process, so the file's pages are then dropped from the page
+    // cache as well
+    const size_t played = page_floor(pos_bytes);
+    if (played >= d_released + READ_AHEAD) {
+        madvise((void*)(d_base + d_released), played - d_released, MADV_DONTNEED);
+        posix_fadvise(d_fd, d_released, played - d_released, POSIX_FADV_DONTNEED);
+        d_released = played;
+    }
+
+    // Tell runtime system how many output items we produced.
+    return int(nitems);
+}
+
+} /* namespace timing_utils */
+} /* namespace gr */
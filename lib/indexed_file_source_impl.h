@@ -0,0 +1,79 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_INDEXED_FILE_SOURCE_IMPL_H
+#define INCLUDED_TIMING_UTILS_INDEXED_FILE_SOURCE_IMPL_H
+
+#include "record_index.h"
+#include <gnuradio/timing_utils/indexed_file_source.h>
+
+namespace gr {
+namespace timing_utils {
+
+class indexed_file_source_impl : public indexed_file_source
+{
+private:
+    size_t d_itemsize;
+    bool d_repeat;
+    // kept open to drop played pages from the page cache
+    int d_fd;
+    const char* d_base;
+    size_t d_length;
+    record_index d_index;
+
+    uint64_t d_start;
+    uint64_t d_end;
+    // next sample to play
+    uint64_t d_pos;
+    // next index entry to replay
+    size_t d_next_entry;
+    bool d_tag_now;
+    size_t d_page_size;
+    // end of the range advised to be read ahead, and of the range released
+    size_t d_ahead;
+    size_t d_released;
+
+    size_t page_floor(size_t bytes) const { return bytes / d_page_size * d_page_size; }
+    size_t page_ceil(size_t bytes) const { return page_floor(bytes + d_page_size - 1); }
+    void add_time_tag(uint64_t offset, uint64_t secs, double frac);
+    void seek(uint64_t sample);
+
+public:
+    /**
+     * Constructor
+     *
+     * @param filename - recording file
+     * @param itemsize - size of each item (bytes)
+     * @param samp_rate - sample rate (Hz), if there is no index
+     * @param file_time - time of the first sample (s), if there is no index
+     * @param seek_time - time to start playing at (s), 0 for the start
+     * @param end_time - time to stop playing at (s), 0 for the end
+     * @param repeat - play the window again once its end is reached
+     */
+    indexed_file_source_impl(const std::string& filename,
+                             size_t itemsize,
+                             double samp_rate,
+                             double file_time,
+                             double seek_time,
+                             double end_time,
+                             bool repeat);
+    ~indexed_file_source_impl();
+
+    uint64_t start_sample() { return d_start; }
+    uint64_t end_sample() { return d_end; }
+
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items);
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_INDEXED_FILE_SOURCE_IMPL_H */
@@ -14,6 +14,8 @@
 #include "interrupt_emitter_impl.h"
 #include <gnuradio/io_signature.h>
 #include <gnuradio/timing_utils/constants.h>
+#include <gnuradio/timing_utils/event_log.h>
+#include <algorithm>
 #include <cmath>
 
 namespace gr {
@@ -39,8 +41,10 @@ interrupt_emitter_impl<T>::interrupt_emitter_impl(double rate,
       reference_timer(),
       d_rate(rate),
       d_drop_late(drop_late),
-      d_gain(loop_gain)
+      d_gain(loop_gain),
+      d_trigger_delay(0.0)
 {
+    d_event_source = event_log::source(this->symbol_name());
     this->message_port_register_out(PMTCONSTSTR__trig());
     this->message_port_register_in(PMTCONSTSTR__set());
 
@@ -51,6 +55,7 @@ interrupt_emitter_impl<T>::interrupt_emitter_impl(double rate,
     timer_thread = new boost::thread(boost::bind(&boost::asio::io_service::run, &io));
     d_last_tag_time = 0; // time,sample starts at 0,0 unless we get an rx_time tag
     d_last_tag_samp = 0;
+    d_timeline_offset = UINT64_MAX;
     debug = false;
 }
 
@@ -114,6 +119,34 @@ void interrupt_emitter_impl<T>::handle_set_time(pmt::pmt_t time_pmt)
     if (debug)
         std::cout << "Received msg: " << time_pmt << std::endl;
 
+    // trigger messages (trigger_now . info) arm on the triggering sample, by time
+    // if it is known, delayed as that sample has already been processed
+    if (pmt::is_pair(time_pmt) &&
+        pmt::eq(pmt::car(time_pmt), PMTCONSTSTR__trigger_now())) {
+        double delay;
+        {
+            gr::thread::scoped_lock l(this->d_setlock);
+            delay = d_trigger_delay;
+        }
+        pmt::pmt_t info = pmt::cdr(time_pmt);
+        pmt::pmt_t time = pmt::dict_ref(info, PMTCONSTSTR__trigger_time(), pmt::PMT_NIL);
+        pmt::pmt_t sample =
+            pmt::dict_ref(info, PMTCONSTSTR__trigger_sample(), pmt::PMT_NIL);
+        if (pmt::is_pair(time) && pmt::is_uint64(pmt::car(time)) &&
+            pmt::is_real(pmt::cdr(time))) {
+            double t_frac = pmt::to_double(pmt::cdr(time)) + delay;
+            double whole_secs = std::floor(t_frac);
+            time_pmt = pmt::cons(
+                pmt::from_uint64(pmt::to_uint64(pmt::car(time)) + uint64_t(whole_secs)),
+                pmt::from_double(t_frac - whole_secs));
+        } else if (pmt::is_uint64(sample)) {
+            time_pmt = pmt::from_uint64(pmt::to_uint64(sample) +
+                                        uint64_t(std::llround(delay * d_rate)));
+        } else {
+            return;
+        }
+    }
+
     uint64_t trigger_sample;
     pmt::pmt_t trigger_time = pmt::PMT_NIL;
     uint64_t t_int;
@@ -200,9 +233,53 @@ void interrupt_emitter_impl<T>::process_interrupt()
     pmt::pmt_t time_pmt = pmt::dict_ref(d_out_pmt, PMTCONSTSTR__trigger_time(), pmt::PMT_NIL);
     double int_time =
         pmt::to_uint64(pmt::car(time_pmt)) + pmt::to_double(pmt::cdr(time_pmt));
+    const uint64_t int_sample = time_to_samples(int_time);
     d_out_pmt = pmt::dict_add(
-        d_out_pmt, PMTCONSTSTR__trigger_sample(), pmt::from_uint64(time_to_samples(int_time)));
+        d_out_pmt, PMTCONSTSTR__trigger_sample(), pmt::from_uint64(int_sample));
     this->message_port_pub(PMTCONSTSTR__trig(), d_out_pmt);
+    event_log::log(EVENT_INTERRUPT, d_event_source, int_sample, int_time);
+}
+
+template <class T>
+void interrupt_emitter_impl<T>::set_trigger_delay(double delay)
+{
+    gr::thread::scoped_lock l(this->d_setlock);
+    d_trigger_delay = std::max(delay, 0.0);
+}
+
+template <class T>
+void interrupt_emitter_impl<T>::set_timeline(const std::string& name)
+{
+    gr::thread::scoped_lock l(this->d_setlock);
+
+    d_timeline_offset = UINT64_MAX;
+    if (name.empty()) {
+        d_timeline.reset();
+    } else {
+        d_timeline = sample_timeline::get(name);
+    }
+}
+
+template <class T>
+void interrupt_emitter_impl<T>::update_reference(uint64_t samp,
+                                                 double tag_time,
+                                                 double current_time,
+                                                 uint64_t end_sample)
+{
+    d_last_tag_time = tag_time;
+    d_last_tag_samp = samp;
+    // printf("Tag at time: %f, sample: %ld, offset: %f, time:%f\n", tag_time,
+    // samp, d_time_offset, current_time);
+    // What time did we expect to see samp at??
+    // Note that we expect to receive the whole buffer at the same time, so we
+    // need to reref to the last sample
+    double expect_samp = current_time - (end_sample - samp) / d_rate;
+    double error = expect_samp - tag_time;
+    d_time_offset += error;
+    d_start_time -= error;
+    UpdateTimer(error);
+    if (debug)
+        printf("tag_error = %f\n", error);
 }
 
 template <class T>
@@ -221,7 +298,10 @@ int interrupt_emitter_impl<T>::work(int noutput_items,
 
     //const T* in = (const T*)input_items[0];
 
+    gr::thread::scoped_lock l(this->d_setlock);
+
     std::vector<tag_t> tags;
+    timeline_anchor_t anchor;
 
     // check for uhd rx_time tags to set baseline time and correct for overflows
     this->get_tags_in_range(tags,
@@ -236,22 +316,16 @@ int interrupt_emitter_impl<T>::work(int noutput_items,
         double t_frac = pmt::to_double(pmt::tuple_ref(last_tag.value, 1));
         uint64_t samp = last_tag.offset;
 
-        d_last_tag_time = t_int + t_frac;
-        d_last_tag_samp = samp;
-        // printf("Tag at time: %f, sample: %ld, offset: %f, time:%f\n", t_int+t_frac,
-        // samp, d_time_offset, current_time);
-        // What time did we expect to see samp at??
-        // Note that we expect to receive the whole buffer at the same time, so we
-        // need to reref to the last sample
-        double expect_samp =
-            current_time - (this->nitems_read(0) + noutput_items - samp) / d_rate;
-        double error = expect_samp - t_int - t_frac;
-        d_time_offset += error;
-        d_start_time -= error;
-        current_ptime -= boost::posix_time::microseconds(static_cast<long>(1e6 * error));
-        UpdateTimer(error);
-        if (debug)
-            printf("tag_error = %f\n", error);
+        update_reference(samp, t_int + t_frac, current_time, d_start_sample);
+        // the same anchor may also have been published to the timeline
+        d_timeline_offset = samp;
+    } else if (d_timeline && d_timeline->anchor_at(d_start_sample - 1, anchor) &&
+               (anchor.offset != d_timeline_offset) && (anchor.offset < d_start_sample)) {
+        // a new anchor was published for a sample we have now processed, it is
+        // applied just like an rx_time tag
+        d_timeline_offset = anchor.offset;
+        update_reference(
+            anchor.offset, anchor.secs + anchor.frac, current_time, d_start_sample);
     } else {
         // estimate time_now using the last rx_time tag and the samples we have processed since that time.
         double radio_time_est = d_last_tag_time + ((this->nitems_read(0) + noutput_items - d_last_tag_samp) / d_rate);
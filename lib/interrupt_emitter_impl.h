@@ -12,6 +12,7 @@
 
 #include "reference_timer.h"
 #include <gnuradio/timing_utils/interrupt_emitter.h>
+#include <gnuradio/timing_utils/sample_timeline.h>
 
 namespace gr {
 namespace timing_utils {
@@ -20,6 +21,7 @@ template <class T>
 class interrupt_emitter_impl : public interrupt_emitter<T>, public reference_timer
 {
 private:
+    uint32_t d_event_source;
     boost::thread* timer_thread;
     double d_rate;
     bool d_drop_late;
@@ -38,9 +40,21 @@ private:
     double d_last_tag_time;
     uint64_t d_last_tag_samp;
 
+    // shared timeline and the offset of the last anchor applied from it
+    sample_timeline::sptr d_timeline;
+    uint64_t d_timeline_offset;
+
+    void update_reference(uint64_t samp,
+                          double tag_time,
+                          double current_time,
+                          uint64_t end_sample);
+
     // integral loop gain for tracking time offset error
     double d_gain;
 
+    // delay (s) of interrupts requested by trigger messages
+    double d_trigger_delay;
+
 public:
     /*!
      * Constructor
@@ -57,6 +71,8 @@ public:
 
     void set_rate(double rate) { d_rate = rate; }
     void set_debug(bool value) { debug = value; }
+    void set_timeline(const std::string& name);
+    void set_trigger_delay(double delay);
     void handle_set_time(pmt::pmt_t int_time);
     bool isLoaded() { return loaded; }
 
@@ -0,0 +1,309 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "latency_governor_impl.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/timing_utils/constants.h>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace gr {
+namespace timing_utils {
+
+template <class T>
+typename latency_governor<T>::sptr
+latency_governor<T>::make(double rate, double max_lag, uint32_t keep_one_in)
+{
+    return gnuradio::make_block_sptr<latency_governor_impl<T>>(rate, max_lag, keep_one_in);
+}
+
+/*
+ * The private constructor
+ */
+template <class T>
+latency_governor_impl<T>::latency_governor_impl(double rate,
+                                                double max_lag,
+                                                uint32_t keep_one_in)
+    : gr::block("latency_governor",
+                gr::io_signature::make(1, 1, sizeof(T)),
+                gr::io_signature::make(1, 1, sizeof(T))),
+      d_rate(rate),
+      d_max_lag(max_lag),
+      d_keep_one_in(keep_one_in),
+      d_radio_valid(false),
+      d_radio_offset(0),
+      d_radio_secs(0),
+      d_radio_frac(0.0),
+      d_baseline_valid(false),
+      d_baseline(0.0),
+      d_baseline_time(0.0),
+      d_wall_valid(false),
+      d_wall_offset(0),
+      d_wall_time(0.0),
+      d_lag(0.0),
+      d_shed_lag(0.0),
+      d_lagging_buffers(0),
+      d_pending(0),
+      d_dropped(0)
+{
+    // get posix time
+    boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+    d_epoch = epoch;
+
+    this->message_port_register_out(PMTCONSTSTR__shed());
+
+    // output offsets move when buffers are dropped, so tags are propagated
+    // in the work function
+    this->set_tag_propagation_policy(gr::block::TPP_DONT);
+}
+
+/*
+ * Our virtual destructor.
+ */
+template <class T>
+latency_governor_impl<T>::~latency_governor_impl()
+{
+}
+
+template <class T>
+void latency_governor_impl<T>::set_max_lag(double max_lag)
+{
+    gr::thread::scoped_lock l(this->d_setlock);
+    d_max_lag = max_lag;
+}
+
+template <class T>
+void latency_governor_impl<T>::set_keep_one_in(uint32_t keep_one_in)
+{
+    gr::thread::scoped_lock l(this->d_setlock);
+    d_keep_one_in = keep_one_in;
+}
+
+template <class T>
+void latency_governor_impl<T>::set_rate(double rate)
+{
+    gr::thread::scoped_lock l(this->d_setlock);
+    d_rate = rate;
+}
+
+/*
+ * Update the time anchors from the tags on the available input
+ */
+template <class T>
+void latency_governor_impl<T>::update_anchors()
+{
+    for (const tag_t& tag : d_tags) {
+        if (pmt::eq(tag.key, PMTCONSTSTR__wall_clock_time())) {
+            if (pmt::is_real(tag.value)) {
+                d_wall_valid = true;
+                d_wall_offset = tag.offset;
+                d_wall_time = pmt::to_double(tag.value);
+            }
+        } else if (pmt::eq(tag.key, PMTCONSTSTR__rx_time())) {
+            try {
+                d_radio_secs = pmt::to_uint64(pmt::tuple_ref(tag.value, 0));
+                d_radio_frac = pmt::to_double(pmt::tuple_ref(tag.value, 1));
+                d_radio_offset = tag.offset;
+                d_radio_valid = true;
+            } catch (...) {
+                GR_LOG_ERROR(this->d_logger, "Invalid rx_time tag value");
+            }
+        } else if (pmt::eq(tag.key, PMTCONSTSTR__rx_rate())) {
+            if (!pmt::is_real(tag.value) || !(pmt::to_double(tag.value) > 0.0)) {
+                continue;
+            }
+            // re-anchor at the rate change so earlier samples keep the old rate
+            double rate = pmt::to_double(tag.value);
+            if (d_radio_valid && (tag.offset > d_radio_offset)) {
+                double t_frac = d_radio_frac + (tag.offset - d_radio_offset) / d_rate;
+                double whole_secs = std::floor(t_frac);
+                d_radio_secs += uint64_t(whole_secs);
+                d_radio_frac = t_frac - whole_secs;
+                d_radio_offset = tag.offset;
+            }
+            if (d_wall_valid && (tag.offset > d_wall_offset)) {
+                d_wall_time += (tag.offset - d_wall_offset) / d_rate;
+                d_wall_offset = tag.offset;
+            }
+            d_rate = rate;
+        }
+    }
+}
+
+/*
+ * Lag of sample `offset` behind real time, zero if it can not be measured
+ */
+template <class T>
+double latency_governor_impl<T>::measure_lag(uint64_t offset, double now)
+{
+    if (d_wall_valid) {
+        return now - (d_wall_time + int64_t(offset - d_wall_offset) / d_rate);
+    }
+
+    if (d_radio_valid) {
+        // whole seconds are removed before converting to double to keep precision
+        double radio_time =
+            d_radio_frac + int64_t(offset - d_radio_offset) / d_rate;
+        double diff = (now - double(d_radio_secs)) - radio_time;
+        if (!d_baseline_valid || diff < d_baseline) {
+            d_baseline = diff;
+            d_baseline_valid = true;
+        } else {
+            // rise no faster than the clocks can drift, so a sustained lag is
+            // not mistaken for a clock offset
+            d_baseline +=
+                std::min(diff - d_baseline, MAX_DRIFT * (now - d_baseline_time));
+        }
+        d_baseline_time = now;
+        return diff - d_baseline;
+    }
+
+    return 0.0;
+}
+
+/*
+ * Keep the latest tag of each key in the data being dropped, other than the
+ * timing tags tracked by the anchors
+ */
+template <class T>
+void latency_governor_impl<T>::carry_tags()
+{
+    for (const tag_t& tag : d_tags) {
+        if (pmt::eq(tag.key, PMTCONSTSTR__rx_time()) ||
+            pmt::eq(tag.key, PMTCONSTSTR__rx_rate()) ||
+            pmt::eq(tag.key, PMTCONSTSTR__wall_clock_time())) {
+            continue;
+        }
+        auto it = std::find_if(d_carried.begin(), d_carried.end(), [&](const tag_t& t) {
+            return pmt::eq(t.key, tag.key);
+        });
+        if (it == d_carried.end()) {
+            d_carried.push_back(tag);
+        } else {
+            *it = tag;
+        }
+    }
+}
+
+/*
+ * Tag and report the first sample passed after dropping data
+ */
+template <class T>
+void latency_governor_impl<T>::mark_discontinuity(uint64_t in_offset, uint64_t out_offset)
+{
+    GR_LOG_WARN(this->d_logger,
+                boost::format("dropped %d samples, %0.6f s behind") % d_pending %
+                    d_shed_lag);
+
+    this->add_item_tag(0, out_offset, PMTCONSTSTR__shed(), pmt::from_uint64(d_pending));
+
+    // restore timing and the other dropped tags downstream, unless this
+    // sample already carries them
+    auto has_tag = [&](const pmt::pmt_t& key) {
+        for (const tag_t& tag : d_tags) {
+            if ((tag.offset == in_offset) && pmt::eq(tag.key, key)) {
+                return true;
+            }
+        }
+        return false;
+    };
+    for (const tag_t& tag : d_carried) {
+        if (!has_tag(tag.key)) {
+            this->add_item_tag(0, out_offset, tag.key, tag.value, tag.srcid);
+        }
+    }
+    d_carried.clear();
+    bool has_time = has_tag(PMTCONSTSTR__rx_time());
+    if (d_radio_valid && !has_time) {
+        double t_frac = d_radio_frac + int64_t(in_offset - d_radio_offset) / d_rate;
+        double whole_secs = std::floor(t_frac);
+        this->add_item_tag(0,
+                           out_offset,
+                           PMTCONSTSTR__rx_time(),
+                           pmt::make_tuple(pmt::from_uint64(d_radio_secs + whole_secs),
+                                           pmt::from_double(t_frac - whole_secs)));
+        this->add_item_tag(0, out_offset, PMTCONSTSTR__rx_rate(), pmt::from_double(d_rate));
+    }
+
+    pmt::pmt_t dict = pmt::make_dict();
+    dict = pmt::dict_add(dict, PMTCONSTSTR__rx_sample(), pmt::from_uint64(out_offset));
+    dict = pmt::dict_add(dict, PMTCONSTSTR__dropped(), pmt::from_uint64(d_pending));
+    dict = pmt::dict_add(dict, PMTCONSTSTR__late_delta(), pmt::from_double(d_shed_lag));
+    this->message_port_pub(PMTCONSTSTR__shed(), dict);
+
+    d_pending = 0;
+}
+
+template <class T>
+int latency_governor_impl<T>::general_work(int noutput_items,
+                                           gr_vector_int& ninput_items,
+                                           gr_vector_const_void_star& input_items,
+                                           gr_vector_void_star& output_items)
+{
+    gr::thread::scoped_lock l(this->d_setlock);
+
+    const T* in = (const T*)input_items[0];
+    T* out = (T*)output_items[0];
+
+    const uint64_t nread = this->nitems_read(0);
+    const int navail = ninput_items[0];
+
+    this->get_tags_in_range(d_tags, 0, nread, nread + navail);
+    std::sort(d_tags.begin(), d_tags.end(), tag_t::offset_compare);
+    update_anchors();
+
+    // lag of the newest sample available
+    double now = (boost::get_system_time() - d_epoch).total_microseconds() / 1e6;
+    d_lag = measure_lag(nread + navail - 1, now);
+
+    if (d_lag > d_max_lag) {
+        if (d_lagging_buffers == 0) {
+            d_shed_lag = d_lag;
+        }
+        d_lagging_buffers++;
+        if ((d_keep_one_in == 0) || (d_lagging_buffers % d_keep_one_in)) {
+            // drop everything that is queued
+            carry_tags();
+            d_pending += navail;
+            d_dropped += navail;
+            this->consume(0, navail);
+            return 0;
+        }
+    } else {
+        d_lagging_buffers = 0;
+    }
+
+    int nitems = std::min(navail, noutput_items);
+    if (d_pending) {
+        mark_discontinuity(nread, this->nitems_written(0));
+    }
+
+    memcpy(out, in, nitems * sizeof(T));
+    for (const tag_t& tag : d_tags) {
+        if (tag.offset < nread + nitems) {
+            this->add_item_tag(0, tag.offset - d_dropped, tag.key, tag.value, tag.srcid);
+        }
+    }
+
+    this->consume(0, nitems);
+    return nitems;
+}
+
+template class latency_governor<unsigned char>;
+template class latency_governor<short>;
+template class latency_governor<int32_t>;
+template class latency_governor<float>;
+template class latency_governor<gr_complex>;
+} /* namespace timing_utils */
+} /* namespace gr */
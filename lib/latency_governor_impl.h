@@ -0,0 +1,88 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_LATENCY_GOVERNOR_IMPL_H
+#define INCLUDED_TIMING_UTILS_LATENCY_GOVERNOR_IMPL_H
+
+#include <gnuradio/timing_utils/latency_governor.h>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+namespace gr {
+namespace timing_utils {
+
+template <class T>
+class latency_governor_impl : public latency_governor<T>
+{
+private:
+    // fastest the radio/host clock offset may rise to follow drift (s/s)
+    static constexpr double MAX_DRIFT = 1e-4;
+
+    double d_rate;
+    double d_max_lag;
+    uint32_t d_keep_one_in;
+    boost::posix_time::ptime d_epoch;
+
+    // last rx_time anchor, by input sample
+    bool d_radio_valid;
+    uint64_t d_radio_offset;
+    uint64_t d_radio_secs;
+    double d_radio_frac;
+    // smallest host minus radio time seen, with drift
+    bool d_baseline_valid;
+    double d_baseline;
+    double d_baseline_time;
+
+    // last wall_clock_time anchor, by input sample
+    bool d_wall_valid;
+    uint64_t d_wall_offset;
+    double d_wall_time;
+
+    double d_lag;
+    double d_shed_lag;
+    uint64_t d_lagging_buffers;
+    uint64_t d_pending;
+    uint64_t d_dropped;
+
+    std::vector<tag_t> d_tags;
+    // latest tag of each other key in the dropped data
+    std::vector<tag_t> d_carried;
+
+    void update_anchors();
+    void carry_tags();
+    double measure_lag(uint64_t offset, double now);
+    void mark_discontinuity(uint64_t in_offset, uint64_t out_offset);
+
+public:
+    /*!
+     * Constructor
+     *
+     * \param rate Sampling rate (Hz)
+     * \param max_lag Lag budget (s)
+     * \param keep_one_in Pass one of every N buffers while lagging
+     */
+    latency_governor_impl(double rate, double max_lag, uint32_t keep_one_in);
+    ~latency_governor_impl();
+
+    void set_max_lag(double max_lag);
+    void set_keep_one_in(uint32_t keep_one_in);
+    void set_rate(double rate);
+    double lag() { return d_lag; }
+    uint64_t dropped() { return d_dropped; }
+
+    // Where all the action really happens
+    int general_work(int noutput_items,
+                     gr_vector_int& ninput_items,
+                     gr_vector_const_void_star& input_items,
+                     gr_vector_void_star& output_items);
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_LATENCY_GOVERNOR_IMPL_H */
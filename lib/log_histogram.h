@@ -0,0 +1,154 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_LOG_HISTOGRAM_H
+#define INCLUDED_TIMING_UTILS_LOG_HISTOGRAM_H
+
+#include <gnuradio/timing_utils/constants.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace gr {
+namespace timing_utils {
+
+/*
+ * Streaming statistics with log-bucketed quantiles
+ *
+ * Each power of two from 2^MIN_EXP to 2^MAX_EXP is split into SUB_BUCKETS
+ * linear buckets, so quantiles are within 1/SUB_BUCKETS of the true value
+ * relative to its size, with constant memory and O(1) updates. Values at or
+ * below 2^MIN_EXP, including zero and negative values, share the lowest
+ * bucket. Count, min, max and mean are exact, the mean and variance are
+ * updated with Welford's method so they do not lose precision over long runs.
+ */
+class log_histogram
+{
+public:
+    static const int MIN_EXP = -40;
+    static const int MAX_EXP = 40;
+    static const int SUB_BUCKETS = 64;
+    static const size_t NUM_BUCKETS = 2 + size_t(MAX_EXP - MIN_EXP) * SUB_BUCKETS;
+
+    log_histogram() : d_counts(NUM_BUCKETS, 0) { reset(); }
+
+    void reset()
+    {
+        std::fill(d_counts.begin(), d_counts.end(), 0);
+        d_count = 0;
+        d_mean = 0.0;
+        d_m2 = 0.0;
+        d_min = std::numeric_limits<double>::infinity();
+        d_max = -std::numeric_limits<double>::infinity();
+        d_last = 0.0;
+    }
+
+    void add(double value)
+    {
+        if (std::isnan(value)) {
+            return;
+        }
+        d_counts[bucket(value)]++;
+        d_count++;
+        const double delta = value - d_mean;
+        d_mean += delta / d_count;
+        d_m2 += delta * (value - d_mean);
+        d_min = std::min(d_min, value);
+        d_max = std::max(d_max, value);
+        d_last = value;
+    }
+
+    uint64_t count() const { return d_count; }
+    double min() const { return d_count ? d_min : 0.0; }
+    double max() const { return d_count ? d_max : 0.0; }
+    double mean() const { return d_mean; }
+    double variance() const { return d_count ? d_m2 / d_count : 0.0; }
+    double last() const { return d_last; }
+
+    // value below which a fraction `q` of the values fall
+    double quantile(double q) const
+    {
+        if (!d_count) {
+            return 0.0;
+        }
+        uint64_t target = std::max(uint64_t(std::ceil(q * d_count)), uint64_t(1));
+        uint64_t seen = 0;
+        for (size_t idx = 0; idx < NUM_BUCKETS; idx++) {
+            seen += d_counts[idx];
+            if (seen >= target) {
+                return std::min(std::max(bucket_value(idx), d_min), d_max);
+            }
+        }
+        return d_max;
+    }
+
+    /*
+     * Dictionary of count, last, min, max, mean and the p50, p90, p99 and
+     * p999 percentiles
+     */
+    pmt::pmt_t to_dict() const
+    {
+        pmt::pmt_t dict = pmt::make_dict();
+        dict = pmt::dict_add(dict, PMTCONSTSTR__count(), pmt::from_uint64(count()));
+        dict = pmt::dict_add(dict, PMTCONSTSTR__last(), pmt::from_double(last()));
+        dict = pmt::dict_add(dict, PMTCONSTSTR__min(), pmt::from_double(min()));
+        dict = pmt::dict_add(dict, PMTCONSTSTR__max(), pmt::from_double(max()));
+        dict = pmt::dict_add(dict, PMTCONSTSTR__mean(), pmt::from_double(mean()));
+        dict = pmt::dict_add(dict, PMTCONSTSTR__p50(), pmt::from_double(quantile(0.5)));
+        dict = pmt::dict_add(dict, PMTCONSTSTR__p90(), pmt::from_double(quantile(0.9)));
+        dict = pmt::dict_add(dict, PMTCONSTSTR__p99(), pmt::from_double(quantile(0.99)));
+        dict = pmt::dict_add(dict, PMTCONSTSTR__p999(), pmt::from_double(quantile(0.999)));
+        return dict;
+    }
+
+private:
+    std::vector<uint64_t> d_counts;
+    uint64_t d_count;
+    double d_mean;
+    double d_m2;
+    double d_min;
+    double d_max;
+    double d_last;
+
+    static size_t bucket(double value)
+    {
+        int exp;
+        double mant = std::frexp(value, &exp); // value = mant * 2^exp, mant in [0.5, 1)
+        exp -= 1;
+        if (!(value > 0.0) || (exp < MIN_EXP)) {
+            return 0;
+        }
+        if (exp >= MAX_EXP) {
+            return NUM_BUCKETS - 1;
+        }
+        size_t sub = size_t((2.0 * mant - 1.0) * SUB_BUCKETS);
+        return 1 + size_t(exp - MIN_EXP) * SUB_BUCKETS + sub;
+    }
+
+    // center of bucket `idx`
+    static double bucket_value(size_t idx)
+    {
+        if (idx == 0) {
+            return std::ldexp(1.0, MIN_EXP);
+        }
+        if (idx == NUM_BUCKETS - 1) {
+            return std::ldexp(1.0, MAX_EXP);
+        }
+        int exp = MIN_EXP + int((idx - 1) / SUB_BUCKETS);
+        double sub = double((idx - 1) % SUB_BUCKETS);
+        return std::ldexp(1.0 + (sub + 0.5) / SUB_BUCKETS, exp);
+    }
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_LOG_HISTOGRAM_H */
@@ -0,0 +1,234 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_RECORD_INDEX_H
+#define INCLUDED_TIMING_UTILS_RECORD_INDEX_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace gr {
+namespace timing_utils {
+
+/*
+ * Sidecar index of a recording, `<recording>.idx`: a 32 byte header followed
+ * by 32 byte entries in sample order. Samples count items from the start of
+ * the recording.
+ */
+enum record_index_type_t {
+    INDEX_TIME = 1,   // rx_time, secs and value the whole and fractional seconds
+    INDEX_RATE = 2,   // rx_rate, value the rate (Hz)
+    INDEX_FREQ = 3,   // rx_freq, value the RF center frequency (Hz)
+    INDEX_RETUNE = 4, // freq, value the center frequency within the band (Hz)
+};
+
+struct record_index_header_t {
+    char magic[8];
+    uint32_t version;
+    uint32_t entry_size;
+    uint64_t itemsize;
+    double rate; // nominal sample rate (Hz), until the first INDEX_RATE entry
+};
+
+struct record_index_entry_t {
+    uint64_t sample;
+    uint32_t type;
+    uint32_t reserved;
+    uint64_t secs;
+    double value;
+};
+
+static_assert(sizeof(record_index_header_t) == 32, "index header must be 32 bytes");
+static_assert(sizeof(record_index_entry_t) == 32, "index entries must be 32 bytes");
+
+static const char RECORD_INDEX_MAGIC[8] = { 'T', 'U', 'I', 'N', 'D', 'E', 'X', '\0' };
+static const uint32_t RECORD_INDEX_VERSION = 1;
+
+/*
+ * Time lookups in a recording index
+ *
+ * The time of a sample is extrapolated from the last time entry at or before
+ * it, at the rate of the last rate entry at or before that time entry (or the
+ * nominal rate). Times of the time entries must increase with their samples.
+ */
+class record_index
+{
+public:
+    record_index(double rate = 0.0) : d_rate(rate) {}
+
+    /*
+     * Read `filename`, returns false if it is missing or malformed
+     */
+    bool load(const std::string& filename)
+    {
+        FILE* fp = fopen(filename.c_str(), "rb");
+        if (!fp) {
+            return false;
+        }
+        record_index_header_t header;
+        bool valid =
+            (fread(&header, sizeof(header), 1, fp) == 1) &&
+            (memcmp(header.magic, RECORD_INDEX_MAGIC, sizeof(header.magic)) == 0) &&
+            (header.version == RECORD_INDEX_VERSION) &&
+            (header.entry_size == sizeof(record_index_entry_t));
+        if (valid) {
+            d_rate = header.rate;
+            d_entries.clear();
+            for (std::vector<record_index_entry_t>& typed : d_typed) {
+                typed.clear();
+            }
+            record_index_entry_t entry;
+            while (fread(&entry, sizeof(entry), 1, fp) == 1) {
+                add(entry);
+            }
+        }
+        fclose(fp);
+        return valid;
+    }
+
+    // entries must be added in sample order
+    void add(const record_index_entry_t& entry)
+    {
+        d_entries.push_back(entry);
+        if ((entry.type >= INDEX_TIME) && (entry.type <= INDEX_RETUNE)) {
+            d_typed[entry.type - INDEX_TIME].push_back(entry);
+        }
+    }
+
+    // in sample order
+    const std::vector<record_index_entry_t>& entries() const { return d_entries; }
+
+    // true if times can be looked up
+    bool timed() const
+    {
+        for (const record_index_entry_t& entry : typed(INDEX_TIME)) {
+            if (rate_at(entry.sample) > 0.0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    double rate_at(uint64_t sample) const
+    {
+        const record_index_entry_t* entry = last(INDEX_RATE, sample);
+        return entry ? entry->value : d_rate;
+    }
+
+    /*
+     * Frequency at `sample`, returns false without a frequency entry at or
+     * before it
+     */
+    bool freq_at(uint64_t sample, double& freq) const
+    {
+        const record_index_entry_t* entry = last(INDEX_FREQ, sample);
+        if (entry) {
+            freq = entry->value;
+        }
+        return entry != nullptr;
+    }
+
+    /*
+     * Retuned center frequency at `sample`, returns false without a retune
+     * entry at or before it
+     */
+    bool retune_at(uint64_t sample, double& freq) const
+    {
+        const record_index_entry_t* entry = last(INDEX_RETUNE, sample);
+        if (entry) {
+            freq = entry->value;
+        }
+        return entry != nullptr;
+    }
+
+    /*
+     * Time of `sample`, returns false without a time entry at or before it
+     */
+    bool time_at(uint64_t sample, uint64_t& secs, double& frac) const
+    {
+        const record_index_entry_t* anchor = last(INDEX_TIME, sample);
+        const double rate = anchor ? rate_at(anchor->sample) : 0.0;
+        if (!anchor || !(rate > 0.0)) {
+            return false;
+        }
+        double t_frac = anchor->value + double(sample - anchor->sample) / rate;
+        double whole_secs = std::floor(t_frac);
+        secs = anchor->secs + int64_t(whole_secs);
+        frac = t_frac - whole_secs;
+        return true;
+    }
+
+    /*
+     * First sample at or after a time; a time in a gap between time entries
+     * maps to the sample after the gap, and a time before the first entry
+     * to its sample
+     */
+    uint64_t sample_at(uint64_t secs, double frac) const
+    {
+        const std::vector<record_index_entry_t>& anchors = typed(INDEX_TIME);
+        if (anchors.empty()) {
+            return 0;
+        }
+
+        // last time entry at or before the time
+        auto next = std::upper_bound(
+            anchors.begin(),
+            anchors.end(),
+            std::make_pair(secs, frac),
+            [](const std::pair<uint64_t, double>& t, const record_index_entry_t& e) {
+                return (t.first < e.secs) ||
+                       ((t.first == e.secs) && (t.second < e.value));
+            });
+        if (next == anchors.begin()) {
+            return anchors.front().sample;
+        }
+        const record_index_entry_t* anchor = &*(next - 1);
+        const double rate = rate_at(anchor->sample);
+        double dt = double(int64_t(secs - anchor->secs)) + (frac - anchor->value);
+        uint64_t sample = anchor->sample + uint64_t(std::ceil(dt * rate - 1e-6));
+        if ((next != anchors.end()) && (sample > next->sample)) {
+            sample = next->sample;
+        }
+        return sample;
+    }
+
+private:
+    double d_rate;
+    std::vector<record_index_entry_t> d_entries;
+    // entries of each type in sample order, for binary searches
+    std::vector<record_index_entry_t> d_typed[INDEX_RETUNE - INDEX_TIME + 1];
+
+    const std::vector<record_index_entry_t>& typed(record_index_type_t type) const
+    {
+        return d_typed[type - INDEX_TIME];
+    }
+
+    // last entry of a type at or before `sample`
+    const record_index_entry_t* last(record_index_type_t type, uint64_t sample) const
+    {
+        const std::vector<record_index_entry_t>& entries = typed(type);
+        auto end = std::upper_bound(entries.begin(),
+                                    entries.end(),
+                                    sample,
+                                    [](uint64_t s, const record_index_entry_t& e) {
+                                        return s < e.sample;
+                                    });
+        return (end == entries.begin()) ? nullptr : &*(end - 1);
+    }
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_RECORD_INDEX_H */
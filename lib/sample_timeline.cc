@@ -0,0 +1,188 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/timing_utils/sample_timeline.h>
+#include <cmath>
+#include <map>
+
+namespace gr {
+namespace timing_utils {
+
+const size_t sample_timeline::NUM_ANCHORS;
+
+sample_timeline::sptr sample_timeline::get(const std::string& name)
+{
+    // timelines are looked up when blocks are configured, not while streaming,
+    // so a simple locked registry is sufficient here
+    static std::mutex registry_lock;
+    static std::map<std::string, sptr> registry;
+
+    std::lock_guard<std::mutex> l(registry_lock);
+    sptr& timeline = registry[name];
+    if (!timeline) {
+        timeline = std::make_shared<sample_timeline>();
+    }
+    return timeline;
+}
+
+sample_timeline::sample_timeline() : d_written(0), d_first(0)
+{
+    for (size_t ii = 0; ii < NUM_ANCHORS; ii++) {
+        d_slots[ii].seq.store(0);
+        d_slots[ii].offset.store(0);
+        d_slots[ii].secs.store(0);
+        d_slots[ii].frac.store(0.0);
+        d_slots[ii].rate.store(0.0);
+    }
+}
+
+sample_timeline::~sample_timeline() {}
+
+bool sample_timeline::publish(uint64_t offset, uint64_t secs, double frac, double rate)
+{
+    // lookups divide and multiply by the rate
+    if (!std::isfinite(frac) || !std::isfinite(rate) || !(rate > 0.0)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> l(d_writer_lock);
+
+    // the sequence number of a slot is odd while it is being written and
+    // identifies which anchor index it holds once complete
+    uint64_t index = d_written.load(std::memory_order_relaxed);
+    slot_t& slot = d_slots[index % NUM_ANCHORS];
+    slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.offset.store(offset, std::memory_order_relaxed);
+    slot.secs.store(secs, std::memory_order_relaxed);
+    slot.frac.store(frac, std::memory_order_relaxed);
+    slot.rate.store(rate, std::memory_order_relaxed);
+    slot.seq.store(2 * index + 2, std::memory_order_release);
+
+    d_written.store(index + 1, std::memory_order_release);
+    return true;
+}
+
+void sample_timeline::reset()
+{
+    std::lock_guard<std::mutex> l(d_writer_lock);
+    d_first.store(d_written.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+uint64_t sample_timeline::version() const
+{
+    return d_written.load(std::memory_order_acquire) -
+           d_first.load(std::memory_order_acquire);
+}
+
+bool sample_timeline::read_slot(uint64_t index, timeline_anchor_t& anchor) const
+{
+    const slot_t& slot = d_slots[index % NUM_ANCHORS];
+    uint64_t seq = slot.seq.load(std::memory_order_acquire);
+    if (seq != 2 * index + 2) {
+        // being written, or already reused for a newer anchor
+        return false;
+    }
+    anchor.offset = slot.offset.load(std::memory_order_relaxed);
+    anchor.secs = slot.secs.load(std::memory_order_relaxed);
+    anchor.frac = slot.frac.load(std::memory_order_relaxed);
+    anchor.rate = slot.rate.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.seq.load(std::memory_order_relaxed) == seq;
+}
+
+template <class P>
+bool sample_timeline::find(P at_or_before, timeline_anchor_t& anchor) const
+{
+    while (true) {
+        uint64_t written = d_written.load(std::memory_order_acquire);
+        uint64_t first = d_first.load(std::memory_order_acquire);
+        if (written == first) {
+            return false;
+        }
+        if (written - first > NUM_ANCHORS) {
+            first = written - NUM_ANCHORS;
+        }
+
+        // walk back from the newest anchor, the oldest retained anchor is used
+        // if the request precedes all of them
+        bool consistent = true;
+        for (uint64_t index = written; index > first; index--) {
+            if (!read_slot(index - 1, anchor)) {
+                consistent = false;
+                break;
+            }
+            if (at_or_before(anchor)) {
+                return true;
+            }
+        }
+        if (consistent) {
+            return true;
+        }
+        // a writer lapped this reader, start over from the new newest anchor
+    }
+}
+
+bool sample_timeline::anchor_at(uint64_t offset, timeline_anchor_t& anchor) const
+{
+    return find([offset](const timeline_anchor_t& a) { return a.offset <= offset; },
+                anchor);
+}
+
+bool sample_timeline::latest(timeline_anchor_t& anchor) const
+{
+    return find([](const timeline_anchor_t& a) { return true; }, anchor);
+}
+
+bool sample_timeline::time_at(uint64_t offset, uint64_t& secs, double& frac) const
+{
+    timeline_anchor_t anchor;
+    if (!anchor_at(offset, anchor)) {
+        return false;
+    }
+
+    // signed sample delta in case the request precedes the oldest anchor
+    double t_frac = anchor.frac + int64_t(offset - anchor.offset) / anchor.rate;
+    double whole_secs = std::floor(t_frac);
+    if (int64_t(anchor.secs) + int64_t(whole_secs) < 0) {
+        secs = 0;
+        frac = 0.0;
+    } else {
+        secs = anchor.secs + int64_t(whole_secs);
+        frac = t_frac - whole_secs;
+    }
+    return true;
+}
+
+bool sample_timeline::offset_at(uint64_t secs, double frac, uint64_t& offset) const
+{
+    timeline_anchor_t anchor;
+    if (!find(
+            [secs, frac](const timeline_anchor_t& a) {
+                return (int64_t(secs - a.secs) + (frac - a.frac)) >= 0.0;
+            },
+            anchor)) {
+        return false;
+    }
+
+    double delta = (int64_t(secs - anchor.secs) + (frac - anchor.frac)) * anchor.rate;
+    int64_t samples = std::llround(delta);
+    if ((samples < 0) && (uint64_t(-samples) > anchor.offset)) {
+        return false;
+    }
+    offset = anchor.offset + samples;
+    return true;
+}
+
+} /* namespace timing_utils */
+} /* namespace gr */
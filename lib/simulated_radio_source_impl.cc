@@ -0,0 +1,240 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "simulated_radio_source_impl.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/timing_utils/constants.h>
+#include <gnuradio/timing_utils/event_log.h>
+#include <boost/format.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/thread_time.hpp>
+#include <cmath>
+#include <limits>
+
+namespace gr {
+namespace timing_utils {
+
+simulated_radio_source::sptr simulated_radio_source::make(double samp_rate,
+                                                          double freq,
+                                                          double tone_freq,
+                                                          double ppm,
+                                                          double drift,
+                                                          double jitter,
+                                                          double overflow_period,
+                                                          uint32_t overflow_samples,
+                                                          uint32_t burst_size,
+                                                          bool realtime)
+{
+    return gnuradio::make_block_sptr<simulated_radio_source_impl>(samp_rate,
+                                                                  freq,
+                                                                  tone_freq,
+                                                                  ppm,
+                                                                  drift,
+                                                                  jitter,
+                                                                  overflow_period,
+                                                                  overflow_samples,
+                                                                  burst_size,
+                                                                  realtime);
+}
+
+/*
+ * The private constructor
+ */
+simulated_radio_source_impl::simulated_radio_source_impl(double samp_rate,
+                                                         double freq,
+                                                         double tone_freq,
+                                                         double ppm,
+                                                         double drift,
+                                                         double jitter,
+                                                         double overflow_period,
+                                                         uint32_t overflow_samples,
+                                                         uint32_t burst_size,
+                                                         bool realtime)
+    : gr::sync_block("simulated_radio_source",
+                     gr::io_signature::make(0, 0, 0),
+                     gr::io_signature::make(1, 1, sizeof(gr_complex))),
+      d_samp_rate(samp_rate),
+      d_ppm(ppm),
+      d_drift(drift),
+      d_jitter(jitter),
+      d_overflow_period(overflow_period),
+      d_overflow_samples(overflow_samples),
+      d_burst_size(burst_size),
+      d_realtime(realtime),
+      d_phasor(1.0, 0.0),
+      d_rng(std::random_device()()),
+      d_started(false),
+      d_tag_now(true),
+      d_start_time(0.0),
+      d_device_samples(0),
+      d_clock_time(0.0),
+      d_overflows(0)
+{
+    d_event_source = event_log::source(symbol_name());
+
+    if (!(samp_rate > 0.0)) {
+        throw std::invalid_argument("simulated_radio_source: sample rate must be > 0");
+    }
+
+    d_rate_pmt = pmt::from_double(samp_rate);
+    d_freq_pmt = pmt::from_double(freq);
+    d_phasor_inc = std::polar(1.0f, float(2.0 * M_PI * tone_freq / samp_rate));
+
+    // get posix time
+    boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+    d_epoch = epoch;
+
+    schedule_overflow();
+}
+
+/*
+ * Our virtual destructor.
+ */
+simulated_radio_source_impl::~simulated_radio_source_impl() {}
+
+double simulated_radio_source_impl::now() const
+{
+    return (boost::get_system_time() - d_epoch).total_microseconds() / 1000000.0;
+}
+
+void simulated_radio_source_impl::schedule_overflow()
+{
+    if (d_overflow_period > 0.0) {
+        d_next_overflow = d_device_samples +
+                          std::max(uint64_t(d_overflow_period * d_samp_rate), uint64_t(1));
+    } else {
+        d_next_overflow = std::numeric_limits<uint64_t>::max();
+    }
+}
+
+void simulated_radio_source_impl::set_ppm(double ppm)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_ppm = ppm;
+}
+
+void simulated_radio_source_impl::set_drift(double drift)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_drift = drift;
+}
+
+void simulated_radio_source_impl::set_jitter(double jitter)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_jitter = jitter;
+}
+
+void simulated_radio_source_impl::set_overflow_period(double overflow_period)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_overflow_period = overflow_period;
+    schedule_overflow();
+}
+
+bool simulated_radio_source_impl::start()
+{
+    gr::thread::scoped_lock l(d_setlock);
+
+    // the device time restarts with the stream, as with a USRP
+    d_started = false;
+    d_tag_now = true;
+    d_device_samples = 0;
+    d_clock_time = 0.0;
+    schedule_overflow();
+    return sync_block::start();
+}
+
+int simulated_radio_source_impl::work(int noutput_items,
+                                      gr_vector_const_void_star& input_items,
+                                      gr_vector_void_star& output_items)
+{
+    gr::thread::scoped_lock l(d_setlock);
+
+    gr_complex* out = (gr_complex*)output_items[0];
+
+    if (!d_started) {
+        d_start_time = now();
+        d_started = true;
+    }
+
+    // one burst per call, ending at the next overflow
+    uint64_t nitems = noutput_items;
+    if (d_burst_size) {
+        nitems = std::min(nitems, uint64_t(d_burst_size));
+    }
+    nitems = std::min(nitems, d_next_overflow - d_device_samples);
+
+    // the first sample after a start or an overflow is tagged with the device
+    // time, which advances at the nominal rate
+    if (d_tag_now) {
+        const uint64_t offset = nitems_written(0);
+        const double t = d_start_time + double(d_device_samples) / d_samp_rate;
+        const double secs = std::floor(t);
+        add_item_tag(0,
+                     offset,
+                     PMTCONSTSTR__rx_time(),
+                     pmt::make_tuple(pmt::from_uint64(uint64_t(secs)),
+                                     pmt::from_double(t - secs)));
+        add_item_tag(0, offset, PMTCONSTSTR__rx_rate(), d_rate_pmt);
+        add_item_tag(0, offset, PMTCONSTSTR__rx_freq(), d_freq_pmt);
+        event_log::log(EVENT_TAG, d_event_source, offset, t);
+        d_tag_now = false;
+    }
+
+    for (uint64_t ii = 0; ii < nitems; ii++) {
+        out[ii] = d_phasor;
+        d_phasor *= d_phasor_inc;
+    }
+    d_phasor /= std::abs(d_phasor);
+
+    // the simulated sample clock runs off by the current clock error
+    const double ppm = d_ppm + d_drift * d_clock_time;
+    const double clock_rate = d_samp_rate * (1.0 + 1e-6 * ppm);
+    d_device_samples += nitems;
+    d_clock_time += nitems / clock_rate;
+    const double deliver_time = d_start_time + d_clock_time;
+
+    if (d_device_samples == d_next_overflow) {
+        // the dropped samples still take time and advance the tone
+        d_device_samples += d_overflow_samples;
+        d_clock_time += d_overflow_samples / clock_rate;
+        d_phasor *= std::pow(d_phasor_inc, float(d_overflow_samples));
+        d_overflows++;
+        d_tag_now = true;
+        schedule_overflow();
+        GR_LOG_DEBUG(d_logger,
+                     boost::format("overflow %d, dropped %d samples") % d_overflows %
+                         d_overflow_samples);
+    }
+
+    // hold the burst until the simulated clock has produced it, plus the
+    // host latency
+    if (d_realtime) {
+        double delay = deliver_time - now();
+        if (d_jitter > 0.0) {
+            delay += std::exponential_distribution<double>(1.0 / d_jitter)(d_rng);
+        }
+        l.unlock();
+        if (delay > 0.0) {
+            boost::this_thread::sleep(
+                boost::posix_time::microseconds(int64_t(1e6 * delay)));
+        }
+    }
+
+    // Tell runtime system how many output items we produced.
+    return int(nitems);
+}
+
+} /* namespace timing_utils */
+} /* namespace gr */
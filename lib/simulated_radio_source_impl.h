@@ -0,0 +1,99 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_SIMULATED_RADIO_SOURCE_IMPL_H
+#define INCLUDED_TIMING_UTILS_SIMULATED_RADIO_SOURCE_IMPL_H
+
+#include <gnuradio/timing_utils/simulated_radio_source.h>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <random>
+
+namespace gr {
+namespace timing_utils {
+
+class simulated_radio_source_impl : public simulated_radio_source
+{
+private:
+    uint32_t d_event_source;
+    double d_samp_rate;
+    double d_ppm;
+    double d_drift;
+    double d_jitter;
+    double d_overflow_period;
+    uint32_t d_overflow_samples;
+    uint32_t d_burst_size;
+    bool d_realtime;
+
+    pmt::pmt_t d_rate_pmt;
+    pmt::pmt_t d_freq_pmt;
+    gr_complex d_phasor;
+    gr_complex d_phasor_inc;
+    std::mt19937_64 d_rng;
+
+    boost::posix_time::ptime d_epoch;
+    bool d_started;
+    bool d_tag_now;
+    // system time of the first sample (s)
+    double d_start_time;
+    // device samples, including those dropped by overflows
+    uint64_t d_device_samples;
+    // simulated clock time of the next device sample, since the first (s)
+    double d_clock_time;
+    uint64_t d_next_overflow;
+    uint64_t d_overflows;
+
+    double now() const;
+    void schedule_overflow();
+
+public:
+    /**
+     * Constructor
+     *
+     * @param samp_rate - nominal sample rate (Hz)
+     * @param freq - center frequency reported in the rx_freq tags (Hz)
+     * @param tone_freq - frequency of the generated tone (Hz)
+     * @param ppm - sample clock error (ppm)
+     * @param drift - change of the sample clock error (ppm/s)
+     * @param jitter - mean host latency of each burst (s)
+     * @param overflow_period - time between overflows (s), 0 for none
+     * @param overflow_samples - samples dropped by each overflow
+     * @param burst_size - samples per burst, 0 for as many as fit
+     * @param realtime - deliver samples at the simulated clock rate
+     */
+    simulated_radio_source_impl(double samp_rate,
+                                double freq,
+                                double tone_freq,
+                                double ppm,
+                                double drift,
+                                double jitter,
+                                double overflow_period,
+                                uint32_t overflow_samples,
+                                uint32_t burst_size,
+                                bool realtime);
+    ~simulated_radio_source_impl();
+
+    void set_ppm(double ppm);
+    void set_drift(double drift);
+    void set_jitter(double jitter);
+    void set_overflow_period(double overflow_period);
+    uint64_t overflows() { return d_overflows; }
+
+    // overloaded functions
+    bool start();
+
+    // Where all the action really happens
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items);
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_SIMULATED_RADIO_SOURCE_IMPL_H */
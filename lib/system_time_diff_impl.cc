@@ -12,7 +12,9 @@
 #endif
 
 #include "system_time_diff_impl.h"
+#include "trace_record.h"
 #include <gnuradio/io_signature.h>
+#include <gnuradio/timing_utils/event_log.h>
 
 namespace gr {
 namespace timing_utils {
@@ -33,25 +35,26 @@ system_time_diff_impl<T>::system_time_diff_impl(bool update_time, bool output_di
                 gr::io_signature::make(1, 1, sizeof(T)),
                 gr::io_signature::makev(1, 2, std::vector<int>(4, sizeof(T)))),
       d_update_time(update_time),
-      d_output_diff(output_diff)
+      d_output_diff(output_diff),
+      d_retag(false),
+      d_trace_name(pmt::PMT_NIL)
 
 {
+    d_event_source = event_log::source(this->symbol_name());
     // Brute force fix of the output io_signature, because I can't get
     // an anonymous std::vector<int>() rvalue, with a const expression
     // initializing the vector, to work.  Lvalues seem to make everything
     // better.
     int output_io_sizes[2] = { sizeof(T), sizeof(float) };
     std::vector<int> output_io_sizes_vector(&output_io_sizes[0], &output_io_sizes[2]);
-    this->set_output_signature(io_signature::makev(1, 2, output_io_sizes_vector));
+    this->set_output_signature(io_signature::makev(0, 2, output_io_sizes_vector));
 
     // get posix time
     boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
     d_epoch = epoch;
 
-    // don't propagate tags - all tags will be propagated
-    // directly in work function since we can not propagate
-    // tags on only a single stream
-    this->set_tag_propagation_policy(gr::block::TPP_DONT);
+    // time differences of each buffer are published as a PDU
+    this->message_port_register_out(PMTCONSTSTR__diff());
 }
 
 /*
@@ -70,60 +73,116 @@ int system_time_diff_impl<T>::general_work(int noutput_items,
 {
     gr::thread::scoped_lock l(this->d_setlock);
 
-    // total number of input items
-    int nitems = std::min(ninput_items[0], noutput_items);
+    // with no outputs connected the block only taps the upstream buffer and
+    // reports the time difference
+    const bool pass_through = !output_items.empty();
 
-    // get input dat
-    const T* in = (const T*)input_items[0];
+    // total number of input items
+    int nitems = pass_through ? std::min(ninput_items[0], noutput_items) : ninput_items[0];
 
     // get output data only if necessary
-    T* out = (T*)output_items[0];
-    float* diff_out = (float*)output_items[1];
-
-    // check to see if there are any tags
-    std::vector<tag_t> tags;
-    this->get_tags_in_range(
-        tags, 0, this->nitems_read(0), (this->nitems_read(0) + nitems));
-    if (tags.size()) {
-        // get current system time
-        double t_now((boost::get_system_time() - d_epoch).total_microseconds() /
-                     1000000.0);
-
-        // process all tags
-        int ntime_tags = 0;
-        for (size_t ii = 0; ii < tags.size(); ii++) {
-            if (pmt::eq(PMTCONSTSTR__wall_clock_time(), tags[ii].key)) {
-                double diff = t_now - pmt::to_double(tags[ii].value);
-                if (d_output_diff) {
-                    std::cout << boost::format("diff = %0.9f s") % diff << std::endl;
-                }
-
-                // update tag if requested
-                if (d_update_time) {
-                    this->add_item_tag(0,
-                                       tags[ii].offset,
-                                       PMTCONSTSTR__wall_clock_time(),
-                                       pmt::from_double(t_now));
-                } else {
-                    this->add_item_tag(0, tags[ii].offset, tags[ii].key, tags[ii].value);
-                }
-
-
-                // output time
-                diff_out[ntime_tags++] = (float)diff;
+    float* diff_out = (output_items.size() > 1) ? (float*)output_items[1] : nullptr;
+
+    // the runtime propagates the tags of a lone data output, but can not add
+    // this block to latency traces, so buffers holding a trace are re-tagged
+    const uint64_t nread = this->nitems_read(0);
+    bool retag = d_retag;
+    if (pass_through && !d_retag) {
+        this->get_tags_in_range(d_tags, 0, nread, nread + nitems, PMTCONSTSTR__trace());
+        retag = !d_tags.empty();
+        this->set_tag_propagation_policy(retag ? gr::block::TPP_DONT
+                                               : gr::block::TPP_ONE_TO_ONE);
+    }
+
+    // only the time tags are needed unless all tags are re-added
+    if (retag) {
+        this->get_tags_in_range(d_tags, 0, nread, nread + nitems);
+    } else {
+        this->get_tags_in_range(
+            d_tags, 0, nread, nread + nitems, PMTCONSTSTR__wall_clock_time());
+    }
+
+    // the system time is read once per buffer, and only if there are time tags
+    double t_now = 0.0;
+    d_offsets.clear();
+    d_diffs.clear();
+    for (const tag_t& tag : d_tags) {
+        if (!pmt::eq(PMTCONSTSTR__wall_clock_time(), tag.key) ||
+            !pmt::is_real(tag.value)) {
+            continue;
+        }
+
+        // the diff output has room for one diff per output item, so the
+        // buffer is cut short at the first time tag that does not fit; its
+        // diff and those of earlier tags at the same offset are computed on
+        // the next call
+        if (diff_out && (d_diffs.size() >= size_t(noutput_items)) &&
+            (tag.offset > nread)) {
+            nitems = int(tag.offset - nread);
+            while (!d_offsets.empty() && (d_offsets.back() >= tag.offset)) {
+                d_offsets.pop_back();
+                d_diffs.pop_back();
+            }
+            break;
+        }
+
+        if (d_diffs.empty()) {
+            t_now = (boost::get_system_time() - d_epoch).total_microseconds() / 1000000.0;
+        }
+        double diff = t_now - pmt::to_double(tag.value);
+        d_offsets.push_back(tag.offset);
+        d_diffs.push_back(diff);
+        event_log::log(EVENT_LATENCY, d_event_source, tag.offset, diff);
+        if (d_output_diff) {
+            GR_LOG_DEBUG(this->d_logger, boost::format("diff = %0.9f s") % diff);
+        }
+    }
+
+    if (!d_diffs.empty()) {
+        pmt::pmt_t meta = pmt::make_dict();
+        meta = pmt::dict_add(meta,
+                             PMTCONSTSTR__offsets(),
+                             pmt::init_u64vector(d_offsets.size(), d_offsets));
+        this->message_port_pub(
+            PMTCONSTSTR__diff(),
+            pmt::cons(meta, pmt::init_f64vector(d_diffs.size(), d_diffs)));
+    }
+
+    // put back the tags of the items consumed
+    if (retag) {
+        if (d_diffs.empty() && !d_tags.empty()) {
+            t_now = (boost::get_system_time() - d_epoch).total_microseconds() / 1000000.0;
+        }
+        for (const tag_t& tag : d_tags) {
+            if (tag.offset >= nread + nitems) {
+                break;
+            }
+            if (d_update_time && pmt::eq(PMTCONSTSTR__wall_clock_time(), tag.key) &&
+                pmt::is_real(tag.value)) {
+                this->add_item_tag(0, tag.offset, tag.key, pmt::from_double(t_now));
+            } else if (pmt::eq(PMTCONSTSTR__trace(), tag.key) &&
+                       pmt::is_pair(tag.value)) {
+                // add this block to the latency trace
+                this->add_item_tag(
+                    0, tag.offset, tag.key, trace_add(tag.value, d_trace_name, t_now));
             } else {
-                // add tag back
-                this->add_item_tag(0, tags[ii].offset, tags[ii].key, tags[ii].value);
+                this->add_item_tag(0, tag.offset, tag.key, tag.value);
             }
         }
+    }
 
-        // update number of items produced
-        this->produce(1, ntime_tags);
-    } /* end if tags.size() */
+    // output time
+    if (diff_out) {
+        size_t ndiff = std::min(d_diffs.size(), size_t(noutput_items));
+        std::copy(d_diffs.begin(), d_diffs.begin() + ndiff, diff_out);
+        this->produce(1, ndiff);
+    }
 
     // copy all of the items to the output
-    memcpy((void*)out, (void*)in, sizeof(T) * nitems);
-    this->produce(0, nitems);
+    if (pass_through) {
+        memcpy(output_items[0], input_items[0], sizeof(T) * nitems);
+        this->produce(0, nitems);
+    }
 
     // tell the scheduler how many items were consumed
     this->consume(0, nitems);
@@ -132,6 +191,29 @@ int system_time_diff_impl<T>::general_work(int noutput_items,
     return gr::block::WORK_CALLED_PRODUCE;
 }
 
+template <class T>
+bool system_time_diff_impl<T>::check_topology(int ninputs, int noutputs)
+{
+    // the runtime can propagate tags to the data output only if it is the
+    // only output, and can not replace them, otherwise all tags are re-added
+    // in the work function
+    d_retag = (noutputs > 0) && (d_update_time || (noutputs > 1));
+    if (d_retag || (noutputs == 0)) {
+        this->set_tag_propagation_policy(gr::block::TPP_DONT);
+    } else {
+        this->set_tag_propagation_policy(gr::block::TPP_ONE_TO_ONE);
+    }
+    return true;
+}
+
+template <class T>
+bool system_time_diff_impl<T>::start()
+{
+    // the alias is set after construction
+    d_trace_name = this->alias_pmt();
+    return block::start();
+}
+
 template class system_time_diff<unsigned char>;
 template class system_time_diff<short>;
 template class system_time_diff<float>;
@@ -22,20 +22,31 @@ template <class T>
 class system_time_diff_impl : public system_time_diff<T>
 {
 private:
+    uint32_t d_event_source;
     boost::posix_time::ptime d_epoch;
     bool d_update_time;
     bool d_output_diff;
+    bool d_retag;
+    pmt::pmt_t d_trace_name;
+
+    std::vector<tag_t> d_tags;
+    std::vector<uint64_t> d_offsets;
+    std::vector<double> d_diffs;
 
 public:
     /**
      * Constructor
      *
      * \param update_time Flag to update the time tag to the current system time
-     * \param output_diff Output the time difference to stdout
+     * \param output_diff Log the time difference at debug level
      */
     system_time_diff_impl(bool update_time, bool output_diff);
     ~system_time_diff_impl();
 
+    // overloaded functions
+    bool check_topology(int ninputs, int noutputs);
+    bool start();
+
     // Where all the action really happens
     int general_work(int noutput_items,
                      gr_vector_int& ninput_items,
@@ -12,27 +12,33 @@
 #endif
 
 #include "system_time_tagger_impl.h"
+#include "trace_record.h"
 #include <gnuradio/io_signature.h>
+#include <gnuradio/timing_utils/event_log.h>
 
 namespace gr {
 namespace timing_utils {
 
 template <class T>
-typename system_time_tagger<T>::sptr system_time_tagger<T>::make(uint32_t tag_interval)
+typename system_time_tagger<T>::sptr system_time_tagger<T>::make(uint32_t tag_interval, bool trace)
 {
-    return gnuradio::make_block_sptr<system_time_tagger_impl<T>>(tag_interval);
+    return gnuradio::make_block_sptr<system_time_tagger_impl<T>>(tag_interval, trace);
 }
 
 /*
  * The private constructor
  */
 template <class T>
-system_time_tagger_impl<T>::system_time_tagger_impl(uint32_t tag_interval)
+system_time_tagger_impl<T>::system_time_tagger_impl(uint32_t tag_interval, bool trace)
     : gr::sync_block("system_time_tagger",
                      gr::io_signature::make(1, 1, sizeof(T)),
                      gr::io_signature::make(1, 1, sizeof(T))),
-      d_total_nitems_read(0)
+      d_total_nitems_read(0),
+      d_trace(trace),
+      d_trace_name(pmt::PMT_NIL)
 {
+    d_event_source = event_log::source(this->symbol_name());
+
     // set tag generating tag_interval
     set_interval(tag_interval);
 
@@ -62,17 +68,30 @@ int system_time_tagger_impl<T>::work(int noutput_items,
     // total number of items read
     d_total_nitems_read = this->nitems_read(0) + noutput_items;
 
+    // one clock read per buffer, for its newest sample; the servo smooths
+    // out the scheduling jitter of the reads and interpolates the time of
+    // each sample from them
+    double t_now((boost::get_system_time() - d_epoch).total_microseconds() / 1000000.0);
+    d_servo.update(d_total_nitems_read - 1, t_now);
+    event_log::log(EVENT_CLOCK, d_event_source, d_total_nitems_read - 1, d_servo.rate());
+
     // see if we need to add any more time tags
-    if (d_tagging_enabled) {
+    if (d_tagging_enabled && (d_next_tag_offset < d_total_nitems_read)) {
         while (d_next_tag_offset < d_total_nitems_read) {
             if (d_next_tag_offset >= this->nitems_read(0)) {
                 // add tag
-                double t_now((boost::get_system_time() - d_epoch).total_microseconds() /
-                             1000000.0);
+                double t_tag =
+                    d_servo.locked() ? d_servo.time_at(d_next_tag_offset) : t_now;
                 this->add_item_tag(0,
                                    d_next_tag_offset,
                                    PMTCONSTSTR__wall_clock_time(),
-                                   pmt::from_double(t_now));
+                                   pmt::from_double(t_tag));
+                if (d_trace) {
+                    this->add_item_tag(0,
+                                       d_next_tag_offset,
+                                       PMTCONSTSTR__trace(),
+                                       trace_add(pmt::PMT_NIL, d_trace_name, t_tag));
+                }
 
                 // set next offset
                 d_next_tag_offset += d_interval;
@@ -108,6 +127,22 @@ void system_time_tagger_impl<T>::set_interval(uint32_t interval)
     }
 }
 
+template <class T>
+void system_time_tagger_impl<T>::set_trace(bool trace)
+{
+    gr::thread::scoped_lock l(this->d_setlock);
+    d_trace = trace;
+}
+
+template <class T>
+bool system_time_tagger_impl<T>::start()
+{
+    // the alias is set after construction
+    d_trace_name = this->alias_pmt();
+    d_servo.reset();
+    return sync_block::start();
+}
+
 template class system_time_tagger<unsigned char>;
 template class system_time_tagger<short>;
 template class system_time_tagger<float>;
@@ -10,6 +10,7 @@
 #ifndef INCLUDED_TIMING_UTILS_SYSTEM_TIME_TAGGER_IMPL_H
 #define INCLUDED_TIMING_UTILS_SYSTEM_TIME_TAGGER_IMPL_H
 
+#include "clock_servo.h"
 #include <gnuradio/timing_utils/constants.h>
 #include <gnuradio/timing_utils/system_time_tagger.h>
 #include <boost/date_time/posix_time/posix_time.hpp>
@@ -22,19 +23,24 @@ template <class T>
 class system_time_tagger_impl : public system_time_tagger<T>
 {
 private:
+    uint32_t d_event_source;
     boost::posix_time::ptime d_epoch;
     uint32_t d_interval;
     uint64_t d_next_tag_offset;
     bool d_tagging_enabled;
     uint64_t d_total_nitems_read;
+    bool d_trace;
+    pmt::pmt_t d_trace_name;
+    clock_servo d_servo;
 
 public:
     /*!
      * \brief Return a shared_ptr to a new instance of timing_utils::system_time_tagger.
      *
      * @param tag_interval - number of samples between tags
+     * @param trace - start a latency trace record with each tag
      */
-    system_time_tagger_impl(uint32_t tag_interval);
+    system_time_tagger_impl(uint32_t tag_interval, bool trace);
     ~system_time_tagger_impl();
 
     // Where all the action really happens
@@ -48,6 +54,16 @@ public:
      * @param tag_interval
      */
     void set_interval(uint32_t tag_interval);
+
+    /**
+     * Start a latency trace record with each tag
+     *
+     * @param trace
+     */
+    void set_trace(bool trace);
+
+    // overloaded functions
+    bool start();
 };
 
 } // namespace timing_utils
@@ -0,0 +1,99 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_TAG_CLOCK_H
+#define INCLUDED_TIMING_UTILS_TAG_CLOCK_H
+
+#include <gnuradio/tags.h>
+#include <gnuradio/timing_utils/constants.h>
+#include <cmath>
+
+namespace gr {
+namespace timing_utils {
+
+/*
+ * Sample time derived from `rx_time` and `rx_rate` stream tags
+ *
+ * Tags must be applied in offset order. The time of any sample, before or
+ * after the last `rx_time` tag, is extrapolated at the current rate.
+ */
+class tag_clock
+{
+public:
+    tag_clock(double rate = 0.0)
+        : d_rate(rate), d_valid(false), d_offset(0), d_secs(0), d_frac(0.0)
+    {
+    }
+
+    void set_rate(double rate) { d_rate = rate; }
+    double rate() const { return d_rate; }
+
+    // true once both a time and a rate are known
+    bool valid() const { return d_valid && (d_rate > 0.0); }
+
+    /*
+     * Apply an `rx_time` or `rx_rate` tag, returns false for other or
+     * malformed tags
+     */
+    bool update(const tag_t& tag)
+    {
+        if (pmt::eq(tag.key, PMTCONSTSTR__rx_time())) {
+            if (!pmt::is_tuple(tag.value) || (pmt::length(tag.value) < 2) ||
+                !pmt::is_uint64(pmt::tuple_ref(tag.value, 0)) ||
+                !pmt::is_real(pmt::tuple_ref(tag.value, 1))) {
+                return false;
+            }
+            d_secs = pmt::to_uint64(pmt::tuple_ref(tag.value, 0));
+            d_frac = pmt::to_double(pmt::tuple_ref(tag.value, 1));
+            d_offset = tag.offset;
+            d_valid = true;
+            return true;
+        }
+        if (pmt::eq(tag.key, PMTCONSTSTR__rx_rate())) {
+            if (!pmt::is_real(tag.value) || !(pmt::to_double(tag.value) > 0.0)) {
+                return false;
+            }
+            // re-anchor so earlier samples keep the old rate
+            if (valid()) {
+                time_at(tag.offset, d_secs, d_frac);
+                d_offset = tag.offset;
+            }
+            d_rate = pmt::to_double(tag.value);
+            return true;
+        }
+        return false;
+    }
+
+    /*
+     * Time of sample `offset`, returns false if the time is not known
+     */
+    bool time_at(uint64_t offset, uint64_t& secs, double& frac) const
+    {
+        if (!valid()) {
+            return false;
+        }
+        double t_frac = d_frac + int64_t(offset - d_offset) / d_rate;
+        double whole_secs = std::floor(t_frac);
+        secs = d_secs + int64_t(whole_secs);
+        frac = t_frac - whole_secs;
+        return true;
+    }
+
+private:
+    double d_rate;
+    bool d_valid;
+    uint64_t d_offset;
+    uint64_t d_secs;
+    double d_frac;
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_TAG_CLOCK_H */
@@ -13,6 +13,7 @@
 
 #include "tag_uhd_offset_impl.h"
 #include <gnuradio/io_signature.h>
+#include <gnuradio/timing_utils/event_log.h>
 
 namespace gr {
 namespace timing_utils {
@@ -31,15 +32,18 @@ template <class T>
 tag_uhd_offset_impl<T>::tag_uhd_offset_impl(float rate, uint32_t tag_interval)
     : gr::sync_block("tag_uhd_offset",
                      gr::io_signature::make(1, 1, sizeof(T)),
-                     gr::io_signature::make(1, 1, sizeof(T))),
+                     gr::io_signature::make(0, 1, sizeof(T))),
       d_rate(rate),
       d_key(PMTCONSTSTR__rx_time()),
       d_total_nitems_read(0),
       d_time_tag_offset(0),
       d_time_tag_int_sec(0),
       d_time_tag_frac_sec(0.0),
-      d_time_tag(pmt::PMT_NIL)
+      d_time_tag(pmt::PMT_NIL),
+      d_rate_pmt(pmt::from_double(rate)),
+      d_int_sec_pmt(pmt::from_uint64(0))
 {
+    d_event_source = event_log::source(this->symbol_name());
     set_interval(tag_interval);
     GR_LOG_INFO(this->d_logger, "setting up time tagger");
 
@@ -64,10 +68,18 @@ void tag_uhd_offset_impl<T>::set_time_tag(tag_t uhd_time_tag)
         d_time_tag_offset = uhd_time_tag.offset;
         d_time_tag_int_sec = pmt::to_uint64(pmt::tuple_ref(uhd_time_tag.value, 0));
         d_time_tag_frac_sec = pmt::to_double(pmt::tuple_ref(uhd_time_tag.value, 1));
-        d_time_tag = pmt::make_tuple(pmt::tuple_ref(uhd_time_tag.value, 0),
+        d_int_sec_pmt = pmt::tuple_ref(uhd_time_tag.value, 0);
+        d_time_tag = pmt::make_tuple(d_int_sec_pmt,
                                      pmt::tuple_ref(uhd_time_tag.value, 1),
                                      pmt::from_uint64(uhd_time_tag.offset),
-                                     pmt::from_double(d_rate));
+                                     d_rate_pmt);
+
+        if (d_timeline && !d_timeline->publish(d_time_tag_offset,
+                                               d_time_tag_int_sec,
+                                               d_time_tag_frac_sec,
+                                               d_rate)) {
+            GR_LOG_DEBUG(this->d_logger, "invalid rate, timeline not updated");
+        }
     }
 }
 
@@ -88,15 +100,18 @@ void tag_uhd_offset_impl<T>::update_time_tag(uint64_t offset)
     }
     d_time_tag_frac_sec += delta;
     d_time_tag_offset = offset;
-    // fractional seconds rollover
+    // fractional seconds rollover, the whole seconds box is only rebuilt when the
+    // value actually changes
     if (d_time_tag_frac_sec >= 1.0) {
-        d_time_tag_frac_sec -= 1.0;
-        d_time_tag_int_sec += 1;
+        uint64_t whole_secs = uint64_t(d_time_tag_frac_sec);
+        d_time_tag_frac_sec -= whole_secs;
+        d_time_tag_int_sec += whole_secs;
+        d_int_sec_pmt = pmt::from_uint64(d_time_tag_int_sec);
     }
-    d_time_tag = pmt::make_tuple(pmt::from_uint64(d_time_tag_int_sec),
+    d_time_tag = pmt::make_tuple(d_int_sec_pmt,
                                  pmt::from_double(d_time_tag_frac_sec),
                                  pmt::from_uint64(d_time_tag_offset),
-                                 pmt::from_double(d_rate));
+                                 d_rate_pmt);
 }
 
 
@@ -111,10 +126,12 @@ int tag_uhd_offset_impl<T>::work(int noutput_items,
 {
     gr::thread::scoped_lock l(this->d_setlock);
 
-    const T* in = (const T*)input_items[0];
-    T* out = (T*)output_items[0];
+    // with no output connected the block is a tap on the upstream buffer, time
+    // is only published through the message port and timeline
+    const bool pass_through = !output_items.empty();
 
-    std::vector<tag_t> tags;
+    // the tag vector is a member so its storage is reused between work calls
+    std::vector<tag_t>& tags = d_tags;
     d_total_nitems_read = this->nitems_read(0) + noutput_items;
 
     // first check to see if there are any UHD time tags
@@ -126,26 +143,30 @@ int tag_uhd_offset_impl<T>::work(int noutput_items,
     if (tags.size()) {
         for (size_t ii = 0; ii < tags.size(); ii++) {
             set_time_tag(tags[ii]);
-            this->add_item_tag(0, tags[ii].offset, d_key, d_time_tag);
-            // GR_LOG_INFO(this->d_logger, boost::format("TAGGG! at sample %d") %
-            // d_time_tag_offset);
+            if (pass_through) {
+                this->add_item_tag(0, tags[ii].offset, d_key, d_time_tag);
+            }
+            event_log::log(EVENT_TAG,
+                           d_event_source,
+                           tags[ii].offset,
+                           d_time_tag_int_sec + d_time_tag_frac_sec);
             this->message_port_pub(PMTCONSTSTR__time(), pmt::cons(d_key, d_time_tag));
             d_next_tag_offset = tags[ii].offset + d_interval;
         }
     }
 
     // next see if we need to add any more time tags
-    if (d_tagging_enabled) {
+    if (d_tagging_enabled && pass_through) {
         while (d_next_tag_offset < d_total_nitems_read) {
             if (d_next_tag_offset >= this->nitems_read(0)) {
                 // necessary tag sample is within the window
                 update_time_tag(d_next_tag_offset);
                 this->add_item_tag(0, d_next_tag_offset, d_key, d_time_tag);
-                // GR_LOG_INFO(this->d_logger, boost::format("TAG! at sample %d") %
-                // d_time_tag_offset);
+                event_log::log(EVENT_TAG,
+                               d_event_source,
+                               d_next_tag_offset,
+                               d_time_tag_int_sec + d_time_tag_frac_sec);
                 d_next_tag_offset += d_interval;
-                // GR_LOG_INFO(this->d_logger, boost::format("next one at %d") %
-                // d_next_tag_offset);
             } else {
                 // we should not have gotten into this state...
                 GR_LOG_WARN(
@@ -158,7 +179,9 @@ int tag_uhd_offset_impl<T>::work(int noutput_items,
     }
 
     // then copy all of the items to the output
-    memcpy((void*)out, (void*)in, sizeof(T) * noutput_items);
+    if (pass_through) {
+        memcpy(output_items[0], input_items[0], sizeof(T) * noutput_items);
+    }
 
     // Tell runtime system how many output items we produced.
     return noutput_items;
@@ -170,6 +193,7 @@ void tag_uhd_offset_impl<T>::set_rate(float rate)
     gr::thread::scoped_lock l(this->d_setlock);
 
     d_rate = rate;
+    d_rate_pmt = pmt::from_double(rate);
 }
 
 template <class T>
@@ -194,6 +218,18 @@ void tag_uhd_offset_impl<T>::set_key(pmt::pmt_t key)
     d_key = key;
 }
 
+template <class T>
+void tag_uhd_offset_impl<T>::set_timeline(const std::string& name)
+{
+    gr::thread::scoped_lock l(this->d_setlock);
+
+    if (name.empty()) {
+        d_timeline.reset();
+    } else {
+        d_timeline = sample_timeline::get(name);
+    }
+}
+
 template class tag_uhd_offset<unsigned char>;
 template class tag_uhd_offset<short>;
 template class tag_uhd_offset<float>;
@@ -11,6 +11,7 @@
 #define INCLUDED_TIMING_UTILS_TAG_UHD_OFFSET_IMPL_H
 
 #include <gnuradio/timing_utils/constants.h>
+#include <gnuradio/timing_utils/sample_timeline.h>
 #include <gnuradio/timing_utils/tag_uhd_offset.h>
 
 namespace gr {
@@ -20,6 +21,7 @@ template <class T>
 class tag_uhd_offset_impl : public tag_uhd_offset<T>
 {
 private:
+    uint32_t d_event_source;
     float d_rate;
     pmt::pmt_t d_key;
     uint64_t d_total_nitems_read;
@@ -28,6 +30,14 @@ private:
     double d_time_tag_frac_sec;
     pmt::pmt_t d_time_tag;
 
+    // cached boxes for the time tag fields that rarely change, so periodic tags
+    // only allocate the fields that differ from one tag to the next
+    pmt::pmt_t d_rate_pmt;
+    pmt::pmt_t d_int_sec_pmt;
+    std::vector<tag_t> d_tags;
+
+    sample_timeline::sptr d_timeline;
+
     uint32_t d_interval;
     uint64_t d_next_tag_offset;
     bool d_tagging_enabled;
@@ -67,6 +77,8 @@ public:
      * @param tag_key -
      */
     void set_key(pmt::pmt_t tag_key);
+
+    void set_timeline(const std::string& name);
 };
 
 } // namespace timing_utils
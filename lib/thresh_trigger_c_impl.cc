@@ -0,0 +1,153 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "thresh_trigger_c_impl.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/timing_utils/constants.h>
+#include <gnuradio/timing_utils/event_log.h>
+#include <algorithm>
+
+namespace gr {
+namespace timing_utils {
+
+thresh_trigger_c::sptr thresh_trigger_c::make(float hi, float lo, int length)
+{
+    return gnuradio::make_block_sptr<thresh_trigger_c_impl>(hi, lo, length);
+}
+
+/*
+ * The private constructor
+ */
+thresh_trigger_c_impl::thresh_trigger_c_impl(float hi, float lo, int length)
+    : gr::sync_block("thresh_trigger_c",
+                     gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                     gr::io_signature::make(0, 1, sizeof(gr_complex))),
+      d_trigger(mag_squared_thresh(hi), mag_squared_thresh(lo), length),
+      d_cfar(mag_squared_thresh(hi), mag_squared_thresh(lo)),
+      d_tag_idx(0)
+{
+    d_event_source = event_log::source(symbol_name());
+    message_port_register_out(PMTCONSTSTR__trig());
+    message_port_register_in(PMTCONSTSTR__disarm());
+    set_msg_handler(PMTCONSTSTR__disarm(), [this](pmt::pmt_t msg) { this->disarm(msg); });
+}
+
+
+/*
+ * Our virtual destructor.
+ */
+thresh_trigger_c_impl::~thresh_trigger_c_impl() {}
+
+
+/*
+ * control message handler, handles command dictionaries or pairs
+ */
+void thresh_trigger_c_impl::disarm(pmt::pmt_t msg)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_trigger.disarm();
+    GR_LOG_INFO(d_logger, "disarmed!");
+}
+
+
+void thresh_trigger_c_impl::set_cfar(int window)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_cfar.set_window(std::max(window, 0));
+
+    // fixed thresholds again when disabled
+    if (!d_cfar.enabled()) {
+        d_trigger.set_hi(d_cfar.hi());
+        d_trigger.set_lo(d_cfar.lo());
+    }
+}
+
+/*
+ * Apply rx_time and rx_rate tags up to and including sample `offset`
+ */
+void thresh_trigger_c_impl::update_time(uint64_t offset)
+{
+    for (; (d_tag_idx < d_tags.size()) && (d_tags[d_tag_idx].offset <= offset);
+         d_tag_idx++) {
+        const tag_t& tag = d_tags[d_tag_idx];
+        if (!d_clock.update(tag) && pmt::eq(tag.key, PMTCONSTSTR__rx_time())) {
+            GR_LOG_ERROR(d_logger, "Invalid rx_time tag value");
+        }
+    }
+}
+
+/*
+ * Publish a trigger on sample `offset`, and tag it if the output is connected
+ */
+void thresh_trigger_c_impl::trigger(uint64_t offset, bool tag_output)
+{
+    update_time(offset);
+
+    pmt::pmt_t info = pmt::make_dict();
+    info = pmt::dict_add(info, PMTCONSTSTR__trigger_sample(), pmt::from_uint64(offset));
+    uint64_t secs;
+    double frac;
+    if (d_clock.time_at(offset, secs, frac)) {
+        info = pmt::dict_add(info,
+                             PMTCONSTSTR__trigger_time(),
+                             pmt::cons(pmt::from_uint64(secs), pmt::from_double(frac)));
+        event_log::log(EVENT_TRIGGER, d_event_source, offset, secs + frac);
+    } else {
+        event_log::log(EVENT_TRIGGER, d_event_source, offset);
+    }
+
+    message_port_pub(PMTCONSTSTR__trig(), pmt::cons(PMTCONSTSTR__trigger_now(), info));
+    if (tag_output) {
+        add_item_tag(0, offset, PMTCONSTSTR__trigger_now(), info);
+    }
+}
+
+int thresh_trigger_c_impl::work(int noutput_items,
+                                gr_vector_const_void_star& input_items,
+                                gr_vector_void_star& output_items)
+{
+    gr::thread::scoped_lock l(d_setlock);
+
+    const gr_complex* in = (const gr_complex*)input_items[0];
+    const size_t nitems = noutput_items;
+    const uint64_t nread = nitems_read(0);
+
+    // the output is optional, if connected it passes the input with triggers tagged
+    const bool tag_output = !output_items.empty();
+    if (tag_output) {
+        memcpy(output_items[0], in, nitems * sizeof(gr_complex));
+    }
+
+    get_tags_in_range(d_tags, 0, nread, nread + nitems);
+    std::sort(d_tags.begin(), d_tags.end(), tag_t::offset_compare);
+    d_tag_idx = 0;
+
+    auto on_trigger = [this, nread, tag_output](size_t idx) {
+        this->trigger(nread + idx, tag_output);
+    };
+    // the magnitude squared is compared to squared thresholds
+    if (d_cfar.enabled()) {
+        d_cfar.scan(d_trigger, in, nitems, on_trigger);
+    } else {
+        d_trigger.scan(in, nitems, on_trigger);
+    }
+
+    // keep the time reference current for the next buffer
+    update_time(nread + nitems - 1);
+
+    // Tell runtime system how many output items we produced.
+    return noutput_items;
+}
+
+} /* namespace timing_utils */
+} /* namespace gr */
@@ -0,0 +1,95 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_THRESH_TRIGGER_C_IMPL_H
+#define INCLUDED_TIMING_UTILS_THRESH_TRIGGER_C_IMPL_H
+
+#include "hysteresis_trigger.h"
+#include "tag_clock.h"
+#include <gnuradio/timing_utils/thresh_trigger_c.h>
+
+namespace gr {
+namespace timing_utils {
+
+class thresh_trigger_c_impl : public thresh_trigger_c
+{
+private:
+    uint32_t d_event_source;
+    hysteresis_trigger d_trigger;
+    ca_cfar d_cfar;
+    tag_clock d_clock;
+
+    std::vector<tag_t> d_tags;
+    size_t d_tag_idx;
+
+    void update_time(uint64_t offset);
+    void trigger(uint64_t offset, bool tag_output);
+
+public:
+    /**
+     * Constructor
+     *
+     * @param hi -
+     * @param lo -
+     * @param length -
+     */
+    thresh_trigger_c_impl(float hi, float lo, int length);
+    ~thresh_trigger_c_impl();
+
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items);
+
+    void disarm(pmt::pmt_t);
+
+    /**
+     *
+     * @param t -
+     */
+    void set_hi(float t)
+    {
+        gr::thread::scoped_lock l(d_setlock);
+        d_trigger.set_hi(mag_squared_thresh(t));
+        d_cfar.set_hi(mag_squared_thresh(t));
+    };
+
+    /**
+     *
+     * @param t -
+     */
+    void set_lo(float t)
+    {
+        gr::thread::scoped_lock l(d_setlock);
+        d_trigger.set_lo(mag_squared_thresh(t));
+        d_cfar.set_lo(mag_squared_thresh(t));
+    };
+
+    /**
+     *
+     * @param len -
+     */
+    void set_len(int len)
+    {
+        gr::thread::scoped_lock l(d_setlock);
+        d_trigger.set_length(len);
+    }
+
+    void set_rate(double rate)
+    {
+        gr::thread::scoped_lock l(d_setlock);
+        d_clock.set_rate(rate);
+    }
+
+    void set_cfar(int window);
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_THRESH_TRIGGER_C_IMPL_H */
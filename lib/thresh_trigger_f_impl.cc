@@ -14,6 +14,8 @@
 #include "thresh_trigger_f_impl.h"
 #include <gnuradio/io_signature.h>
 #include <gnuradio/timing_utils/constants.h>
+#include <gnuradio/timing_utils/event_log.h>
+#include <algorithm>
 
 namespace gr {
 namespace timing_utils {
@@ -31,13 +33,12 @@ thresh_trigger_f::sptr thresh_trigger_f::make(float hi, float lo, int length)
 thresh_trigger_f_impl::thresh_trigger_f_impl(float hi, float lo, int length)
     : gr::sync_block("thresh_trigger_f",
                      gr::io_signature::make(1, 1, sizeof(float)),
-                     gr::io_signature::make(0, 0, 0)),
-      d_thresh_hi(hi),
-      d_thresh_lo(lo),
-      d_blank(false),
-      d_length_thresh(length),
-      d_length(0)
+                     gr::io_signature::make(0, 1, sizeof(float))),
+      d_trigger(hi, lo, length),
+      d_cfar(hi, lo),
+      d_tag_idx(0)
 {
+    d_event_source = event_log::source(symbol_name());
     message_port_register_out(PMTCONSTSTR__trig());
     message_port_register_in(PMTCONSTSTR__disarm());
     set_msg_handler(PMTCONSTSTR__disarm(), [this](pmt::pmt_t msg) { this->disarm(msg); });
@@ -55,44 +56,98 @@ thresh_trigger_f_impl::~thresh_trigger_f_impl() {}
  */
 void thresh_trigger_f_impl::disarm(pmt::pmt_t msg)
 {
-    // effectively disables the trigger
-    d_length = d_length_thresh + 1;
+    gr::thread::scoped_lock l(d_setlock);
+    d_trigger.disarm();
     GR_LOG_INFO(d_logger, "disarmed!");
 }
 
 
+void thresh_trigger_f_impl::set_cfar(int window)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_cfar.set_window(std::max(window, 0));
+
+    // fixed thresholds again when disabled
+    if (!d_cfar.enabled()) {
+        d_trigger.set_hi(d_cfar.hi());
+        d_trigger.set_lo(d_cfar.lo());
+    }
+}
+
+/*
+ * Apply rx_time and rx_rate tags up to and including sample `offset`
+ */
+void thresh_trigger_f_impl::update_time(uint64_t offset)
+{
+    for (; (d_tag_idx < d_tags.size()) && (d_tags[d_tag_idx].offset <= offset);
+         d_tag_idx++) {
+        const tag_t& tag = d_tags[d_tag_idx];
+        if (!d_clock.update(tag) && pmt::eq(tag.key, PMTCONSTSTR__rx_time())) {
+            GR_LOG_ERROR(d_logger, "Invalid rx_time tag value");
+        }
+    }
+}
+
+/*
+ * Publish a trigger on sample `offset`, and tag it if the output is connected
+ */
+void thresh_trigger_f_impl::trigger(uint64_t offset, bool tag_output)
+{
+    update_time(offset);
+
+    pmt::pmt_t info = pmt::make_dict();
+    info = pmt::dict_add(info, PMTCONSTSTR__trigger_sample(), pmt::from_uint64(offset));
+    uint64_t secs;
+    double frac;
+    if (d_clock.time_at(offset, secs, frac)) {
+        info = pmt::dict_add(info,
+                             PMTCONSTSTR__trigger_time(),
+                             pmt::cons(pmt::from_uint64(secs), pmt::from_double(frac)));
+        event_log::log(EVENT_TRIGGER, d_event_source, offset, secs + frac);
+    } else {
+        event_log::log(EVENT_TRIGGER, d_event_source, offset);
+    }
+
+    message_port_pub(PMTCONSTSTR__trig(), pmt::cons(PMTCONSTSTR__trigger_now(), info));
+    if (tag_output) {
+        add_item_tag(0, offset, PMTCONSTSTR__trigger_now(), info);
+    }
+}
+
 int thresh_trigger_f_impl::work(int noutput_items,
                                 gr_vector_const_void_star& input_items,
                                 gr_vector_void_star& output_items)
 {
+    gr::thread::scoped_lock l(d_setlock);
+
     const float* mag = (const float*)input_items[0];
-    uint64_t nitems = std::min(64, noutput_items);
-
-    // if magnitude is greater than threshold, output zero, otherwise pass input
-    for (size_t ii = 0; ii < nitems; ii++) {
-
-        // start blanking when over the high threshold
-        if (mag[ii] > d_thresh_hi) {
-            d_blank = true;
-            d_length++;
-            if (d_length == d_length_thresh) {
-                message_port_pub(PMTCONSTSTR__trig(),
-                                 pmt::cons(PMTCONSTSTR__trigger_now(), pmt::PMT_NIL));
-                // std::cout << "TRIGGERED at offset " << (nitems_read(0) + ii) <<
-                // std::endl;
-            }
-
-            // stop blanking when under the low threshold
-        } else {
-            if (mag[ii] < d_thresh_lo) {
-                d_blank = false;
-            }
-            d_length = 0;
-        }
+    const size_t nitems = noutput_items;
+    const uint64_t nread = nitems_read(0);
+
+    // the output is optional, if connected it passes the input with triggers tagged
+    const bool tag_output = !output_items.empty();
+    if (tag_output) {
+        memcpy(output_items[0], mag, nitems * sizeof(float));
     }
 
+    get_tags_in_range(d_tags, 0, nread, nread + nitems);
+    std::sort(d_tags.begin(), d_tags.end(), tag_t::offset_compare);
+    d_tag_idx = 0;
+
+    auto on_trigger = [this, nread, tag_output](size_t idx) {
+        this->trigger(nread + idx, tag_output);
+    };
+    if (d_cfar.enabled()) {
+        d_cfar.scan(d_trigger, mag, nitems, on_trigger);
+    } else {
+        d_trigger.scan(mag, nitems, on_trigger);
+    }
+
+    // keep the time reference current for the next buffer
+    update_time(nread + nitems - 1);
+
     // Tell runtime system how many output items we produced.
-    return nitems;
+    return noutput_items;
 }
 
 } /* namespace timing_utils */
@@ -10,6 +10,8 @@
 #ifndef INCLUDED_TIMING_UTILS_THRESH_TRIGGER_F_IMPL_H
 #define INCLUDED_TIMING_UTILS_THRESH_TRIGGER_F_IMPL_H
 
+#include "hysteresis_trigger.h"
+#include "tag_clock.h"
 #include <gnuradio/timing_utils/thresh_trigger_f.h>
 
 namespace gr {
@@ -18,11 +20,16 @@ namespace timing_utils {
 class thresh_trigger_f_impl : public thresh_trigger_f
 {
 private:
-    float d_thresh_hi;
-    float d_thresh_lo;
-    bool d_blank;
-    uint64_t d_length_thresh;
-    uint64_t d_length;
+    uint32_t d_event_source;
+    hysteresis_trigger d_trigger;
+    ca_cfar d_cfar;
+    tag_clock d_clock;
+
+    std::vector<tag_t> d_tags;
+    size_t d_tag_idx;
+
+    void update_time(uint64_t offset);
+    void trigger(uint64_t offset, bool tag_output);
 
 public:
     /**
@@ -45,19 +52,41 @@ public:
      *
      * @param t -
      */
-    void set_hi(float t) { d_thresh_hi = t; };
+    void set_hi(float t)
+    {
+        gr::thread::scoped_lock l(d_setlock);
+        d_trigger.set_hi(t);
+        d_cfar.set_hi(t);
+    };
 
     /**
      *
      * @param t -
      */
-    void set_lo(float t) { d_thresh_lo = t; };
+    void set_lo(float t)
+    {
+        gr::thread::scoped_lock l(d_setlock);
+        d_trigger.set_lo(t);
+        d_cfar.set_lo(t);
+    };
 
     /**
      *
      * @param len -
      */
-    void set_len(int len) { d_length_thresh = len; }
+    void set_len(int len)
+    {
+        gr::thread::scoped_lock l(d_setlock);
+        d_trigger.set_length(len);
+    }
+
+    void set_rate(double rate)
+    {
+        gr::thread::scoped_lock l(d_setlock);
+        d_clock.set_rate(rate);
+    }
+
+    void set_cfar(int window);
 };
 
 } // namespace timing_utils
@@ -12,28 +12,40 @@
 #endif
 
 #include "time_delta_impl.h"
+#include "trace_record.h"
 #include <gnuradio/io_signature.h>
+#include <gnuradio/timing_utils/event_log.h>
+#include <boost/format.hpp>
 
 namespace gr {
 namespace timing_utils {
 
-time_delta::sptr time_delta::make(const pmt::pmt_t delta_key, const pmt::pmt_t time_key)
+time_delta::sptr time_delta::make(const pmt::pmt_t delta_key,
+                                   const pmt::pmt_t time_key,
+                                   double period,
+                                   bool reset_on_read)
 {
-    return gnuradio::make_block_sptr<time_delta_impl>(delta_key, time_key);
+    return gnuradio::make_block_sptr<time_delta_impl>(
+        delta_key, time_key, period, reset_on_read);
 }
 
 /*
  * The private constructor
  */
-time_delta_impl::time_delta_impl(const pmt::pmt_t delta_key, const pmt::pmt_t time_key)
+time_delta_impl::time_delta_impl(const pmt::pmt_t delta_key,
+                                 const pmt::pmt_t time_key,
+                                 double period,
+                                 bool reset_on_read)
     : gr::block("time_delta", io_signature::make(0, 0, 0), io_signature::make(0, 0, 0)),
       d_name(pmt::symbol_to_string(delta_key)),
       d_delta_key(delta_key),
       d_time_key(time_key),
-      d_sum_x(0.0),
-      d_sum_x2(0.0),
-      d_n(0)
+      d_trace_name(pmt::PMT_NIL),
+      d_period(period),
+      d_reset_on_read(reset_on_read),
+      d_finished(true)
 {
+    d_event_source = event_log::source(symbol_name());
     boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
     d_epoch = epoch;
 
@@ -41,6 +53,7 @@ time_delta_impl::time_delta_impl(const pmt::pmt_t delta_key, const pmt::pmt_t ti
     set_msg_handler(PMTCONSTSTR__pdu_in(),
                     [this](pmt::pmt_t msg) { this->handle_pdu(msg); });
     message_port_register_out(PMTCONSTSTR__pdu_out());
+    message_port_register_out(PMTCONSTSTR__stats());
 }
 
 /*
@@ -48,16 +61,94 @@ time_delta_impl::time_delta_impl(const pmt::pmt_t delta_key, const pmt::pmt_t ti
  */
 time_delta_impl::~time_delta_impl() {}
 
+void time_delta_impl::set_period(double period)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_period = period;
+}
+
+void time_delta_impl::set_reset_on_read(bool reset_on_read)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_reset_on_read = reset_on_read;
+}
+
+void time_delta_impl::reset_stats()
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_hist.reset();
+}
+
+pmt::pmt_t time_delta_impl::stats()
+{
+    gr::thread::scoped_lock l(d_setlock);
+    return snapshot();
+}
+
+// must be called with d_setlock held
+pmt::pmt_t time_delta_impl::snapshot()
+{
+    pmt::pmt_t dict = d_hist.to_dict();
+    if (d_reset_on_read) {
+        d_hist.reset();
+    }
+    return dict;
+}
+
+/*
+ * Publishes a snapshot every `period` seconds, the period is checked again
+ * every 100 ms while publication is disabled.
+ */
+void time_delta_impl::run()
+{
+    while (!d_finished) {
+        double period;
+        {
+            gr::thread::scoped_lock l(d_setlock);
+            period = d_period;
+        }
+        boost::this_thread::sleep(boost::posix_time::microseconds(
+            int64_t(1e6 * ((period > 0.0) ? period : 0.1))));
+        if (d_finished) {
+            return;
+        }
+        if (period > 0.0) {
+            message_port_pub(PMTCONSTSTR__stats(), stats());
+        }
+    }
+}
+
+bool time_delta_impl::start()
+{
+    // the alias is set after construction
+    d_trace_name = alias_pmt();
+
+    {
+        gr::thread::scoped_lock l(d_setlock);
+        d_total.reset();
+    }
+    d_finished = false;
+    d_thread = gr::thread::thread([this] { run(); });
+    return block::start();
+}
+
 bool time_delta_impl::stop()
 {
-    double mean = d_sum_x / (double)d_n;
-    double var = (d_sum_x2 - (d_sum_x * d_sum_x) / (double)d_n) / (double)d_n;
-
-    GR_LOG_INFO(
-        d_logger,
-        boost::format("WALL_CLOCK_TIME_DEBUG (%s): Mean = %0.6f ms, Var = %0.6f ms") %
-            d_name % mean % var);
-    return true;
+    if (!d_finished) {
+        d_finished = true;
+        d_thread.interrupt();
+        d_thread.join();
+    }
+
+    gr::thread::scoped_lock l(d_setlock);
+    GR_LOG_INFO(d_logger,
+                boost::format("WALL_CLOCK_TIME_DEBUG (%s): Count = %d, Mean = %0.6f ms, "
+                              "Var = %0.6f ms, p50 = %0.6f ms, p99 = %0.6f ms, "
+                              "p99.9 = %0.6f ms") %
+                    d_name % d_total.count() % d_total.mean() % d_total.variance() %
+                    d_total.quantile(0.5) % d_total.quantile(0.99) %
+                    d_total.quantile(0.999));
+    return block::stop();
 }
 
 void time_delta_impl::handle_pdu(pmt::pmt_t pdu)
@@ -80,6 +171,8 @@ void time_delta_impl::handle_pdu(pmt::pmt_t pdu)
         return;
     }
 
+    meta = trace_add_meta(meta, d_trace_name, t_now);
+
     pmt::pmt_t wct_pmt = pmt::dict_ref(meta, d_time_key, pmt::PMT_NIL);
     if (!pmt::is_real(wct_pmt)) {
         GR_LOG_DEBUG(d_logger,
@@ -87,18 +180,15 @@ void time_delta_impl::handle_pdu(pmt::pmt_t pdu)
     } else {
         double pdu_time = pmt::to_double(wct_pmt);
         double time_delta = (t_now - pdu_time) * 1000.0;
-        GR_LOG_DEBUG(
-            d_logger,
-            boost::format("%s PDU received at %f with time delta %f milliseconds") %
-                d_name % t_now % time_delta);
+        event_log::log(EVENT_LATENCY, d_event_source, 0, time_delta / 1000.0);
 
         // add to metadata
         meta = pmt::dict_add(meta, d_delta_key, pmt::from_double(time_delta));
 
         // update estimates
-        d_sum_x += time_delta;
-        d_sum_x2 += (time_delta * time_delta);
-        d_n++;
+        gr::thread::scoped_lock l(d_setlock);
+        d_hist.add(time_delta);
+        d_total.add(time_delta);
     }
 
     // publish
@@ -10,8 +10,11 @@
 #ifndef INCLUDED_TIMING_UTILS_TIME_DELTA_IMPL_H
 #define INCLUDED_TIMING_UTILS_TIME_DELTA_IMPL_H
 
+#include "log_histogram.h"
+#include <gnuradio/thread/thread.h>
 #include <gnuradio/timing_utils/constants.h>
 #include <gnuradio/timing_utils/time_delta.h>
+#include <atomic>
 
 namespace gr {
 namespace timing_utils {
@@ -19,24 +22,48 @@ namespace timing_utils {
 class time_delta_impl : public time_delta
 {
 private:
+    uint32_t d_event_source;
     boost::posix_time::ptime d_epoch;
     std::string d_name;
     pmt::pmt_t d_delta_key;
     pmt::pmt_t d_time_key;
+    pmt::pmt_t d_trace_name;
 
     // statistic tracking
-    double d_sum_x, d_sum_x2;
-    int d_n;
+    log_histogram d_hist;
+    log_histogram d_total; // whole run, for the summary at stop
+    double d_period;
+    bool d_reset_on_read;
+
+    // snapshot publication
+    gr::thread::thread d_thread;
+    std::atomic<bool> d_finished;
+
+    pmt::pmt_t snapshot();
+    void run();
 
 public:
     /**
      * Constructor
      *
+     * @param delta_key - key to use for time delta metadata field
+     * @param time_key - key to use as reference time for delta
+     * @param period - snapshot publication period (s), 0 to disable
+     * @param reset_on_read - clear the histogram after each snapshot
      */
-    time_delta_impl(const pmt::pmt_t delta_key, const pmt::pmt_t time_key);
+    time_delta_impl(const pmt::pmt_t delta_key,
+                    const pmt::pmt_t time_key,
+                    double period,
+                    bool reset_on_read);
     ~time_delta_impl();
 
+    void set_period(double period);
+    void set_reset_on_read(bool reset_on_read);
+    void reset_stats();
+    pmt::pmt_t stats();
+
     // overloaded functions
+    bool start();
     bool stop();
 
     void handle_pdu(pmt::pmt_t pdu);
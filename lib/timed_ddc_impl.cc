@@ -0,0 +1,254 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "timed_ddc_impl.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/timing_utils/constants.h>
+#include <gnuradio/timing_utils/event_log.h>
+#include <boost/format.hpp>
+#include <cmath>
+#include <stdexcept>
+
+#define MAX_NUM_COMMANDS 64
+
+namespace gr {
+namespace timing_utils {
+
+timed_ddc::sptr timed_ddc::make(int decimation,
+                                const std::vector<float>& taps,
+                                double center_freq,
+                                double sample_rate,
+                                pmt::pmt_t dict_key,
+                                uint64_t origin_t_secs,
+                                double origin_t_frac)
+{
+    return gnuradio::make_block_sptr<timed_ddc_impl>(decimation,
+                                                     taps,
+                                                     center_freq,
+                                                     sample_rate,
+                                                     dict_key,
+                                                     origin_t_secs,
+                                                     origin_t_frac);
+}
+
+/*
+ * The private constructor
+ */
+timed_ddc_impl::timed_ddc_impl(int decimation,
+                               const std::vector<float>& taps,
+                               double center_freq,
+                               double sample_rate,
+                               pmt::pmt_t dict_key,
+                               uint64_t origin_t_secs,
+                               double origin_t_frac)
+    : gr::sync_decimator("timed_ddc",
+                         gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                         gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                         decimation),
+      d_sample_rate(sample_rate),
+      d_center_freq(center_freq),
+      d_proto_taps(taps),
+      d_dict_key(dict_key),
+      d_retunes(0),
+      d_ref_time(origin_t_secs, origin_t_frac, 0),
+      d_ctaps(taps.size()),
+      d_fir(d_ctaps)
+{
+    d_event_source = event_log::source(symbol_name());
+    if (taps.empty() || (decimation < 1) || !(sample_rate > 0.0)) {
+        throw std::invalid_argument(
+            "timed_ddc: taps, a decimation >= 1 and a sample rate > 0 are required");
+    }
+
+    // the filter looks back over the taps, and tags follow its group delay
+    d_delay = (d_proto_taps.size() - 1) / 2;
+    set_history(d_proto_taps.size());
+    declare_sample_delay(d_delay);
+    retune(center_freq);
+
+    message_port_register_in(PMTCONSTSTR__command());
+    set_msg_handler(PMTCONSTSTR__command(),
+                    [this](pmt::pmt_t msg) { this->command_handler(msg); });
+}
+
+/*
+ * Our virtual destructor.
+ */
+timed_ddc_impl::~timed_ddc_impl() {}
+
+void timed_ddc_impl::set_center_freq(double center_freq)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_commands.push_back({ center_freq, 0, 0.0, true });
+}
+
+// the getters are const, but the lock work holds is not
+double timed_ddc_impl::center_freq() const
+{
+    gr::thread::scoped_lock l(const_cast<timed_ddc_impl*>(this)->d_setlock);
+    return d_center_freq;
+}
+
+uint64_t timed_ddc_impl::retunes() const
+{
+    gr::thread::scoped_lock l(const_cast<timed_ddc_impl*>(this)->d_setlock);
+    return d_retunes;
+}
+
+void timed_ddc_impl::command_handler(pmt::pmt_t msg)
+{
+    gr::thread::scoped_lock l(d_setlock);
+
+    if (!pmt::is_dict(msg)) {
+        GR_LOG_ERROR(d_logger, "Retune commands must be dictionaries");
+        return;
+    }
+    pmt::pmt_t lo_offset = pmt::dict_ref(msg, d_dict_key, pmt::PMT_NIL);
+    if (!pmt::is_real(lo_offset)) {
+        return;
+    }
+
+    ddc_command_t command = { -pmt::to_double(lo_offset), 0, 0.0, true };
+    pmt::pmt_t time = pmt::dict_ref(msg, PMTCONSTSTR__time(), pmt::PMT_NIL);
+    if (pmt::is_pair(time) &&
+        (pmt::is_uint64(pmt::car(time)) || pmt::is_integer(pmt::car(time))) &&
+        pmt::is_real(pmt::cdr(time))) {
+        command.secs = pmt::to_uint64(pmt::car(time));
+        command.frac = pmt::to_double(pmt::cdr(time));
+        command.now = false;
+    } else if (!pmt::equal(time, pmt::PMT_NIL)) {
+        GR_LOG_ERROR(d_logger, "Unable to determine retune time.  Retuning now");
+    }
+
+    if (d_commands.size() < MAX_NUM_COMMANDS) {
+        d_commands.push_back(command);
+    } else {
+        GR_LOG_WARN(d_logger, "Too many pending retunes, dropping command");
+    }
+}
+
+/*
+ * Newest input sample of the first output centered at or after the time of a
+ * command, from the current reference time; 0 if it is due now
+ */
+uint64_t timed_ddc_impl::command_offset(const ddc_command_t& command) const
+{
+    if (command.now) {
+        return 0;
+    }
+    double dt = double(int64_t(command.secs - d_ref_time.secs)) +
+                (command.frac - d_ref_time.frac);
+    double samples = std::ceil(dt * d_sample_rate - 1e-6);
+    if (samples <= -double(d_ref_time.offset)) {
+        return 0;
+    }
+    return uint64_t(int64_t(d_ref_time.offset) + int64_t(samples)) + d_delay;
+}
+
+void timed_ddc_impl::retune(double center_freq)
+{
+    d_center_freq = center_freq;
+
+    // band pass at the center frequency, then derotate the decimated output
+    // to baseband, as in timed_freq_xlating_fir
+    float fwT0 = 2 * M_PI * d_center_freq / d_sample_rate;
+    for (size_t i = 0; i < d_proto_taps.size(); i++) {
+        d_ctaps[i] = d_proto_taps[i] * exp(gr_complex(0, i * fwT0));
+    }
+    d_fir.set_taps(d_ctaps);
+    d_r.set_phase_incr(exp(gr_complex(0, -fwT0 * decimation())));
+}
+
+int timed_ddc_impl::work(int noutput_items,
+                         gr_vector_const_void_star& input_items,
+                         gr_vector_void_star& output_items)
+{
+    gr::thread::scoped_lock l(d_setlock);
+
+    const gr_complex* in = (const gr_complex*)input_items[0];
+    gr_complex* out = (gr_complex*)output_items[0];
+    const unsigned decim = decimation();
+    const uint64_t nread = nitems_read(0);
+    const uint64_t nwritten = nitems_written(0);
+
+    // tags are read back shifted by the declared delay, undo it
+    get_tags_in_range(d_tags,
+                      0,
+                      nread + d_delay,
+                      nread + uint64_t(noutput_items) * decim + d_delay,
+                      PMTCONSTSTR__rx_time());
+    for (tag_t& tag : d_tags) {
+        tag.offset -= d_delay;
+    }
+    if (d_tmp.size() < size_t(noutput_items)) {
+        d_tmp.resize(noutput_items);
+    }
+
+    size_t next_tag = 0;
+    int produced = 0;
+    while (produced < noutput_items) {
+        // newest input sample of the next output
+        const uint64_t sample = nread + uint64_t(produced) * decim;
+
+        // follow the time reference up to it
+        while ((next_tag < d_tags.size()) && (d_tags[next_tag].offset <= sample)) {
+            const tag_t& tag = d_tags[next_tag++];
+            if (pmt::is_tuple(tag.value) && (pmt::length(tag.value) >= 2) &&
+                pmt::is_uint64(pmt::tuple_ref(tag.value, 0)) &&
+                pmt::is_real(pmt::tuple_ref(tag.value, 1))) {
+                d_ref_time.set(pmt::to_uint64(pmt::tuple_ref(tag.value, 0)),
+                               pmt::to_double(pmt::tuple_ref(tag.value, 1)),
+                               tag.offset);
+            }
+        }
+
+        // apply the retunes that are due
+        while (!d_commands.empty() && (command_offset(d_commands.front()) <= sample)) {
+            retune(d_commands.front().freq);
+            d_commands.pop_front();
+            d_retunes++;
+            add_item_tag(0,
+                         nwritten + produced,
+                         PMTCONSTSTR__freq(),
+                         pmt::from_double(d_center_freq),
+                         alias_pmt());
+            event_log::log(EVENT_RETUNE, d_event_source, sample, d_center_freq);
+            GR_LOG_DEBUG(d_logger,
+                         boost::format("retuned to %f Hz at sample %d") % d_center_freq %
+                             sample);
+        }
+
+        // filter up to the next time tag or retune
+        int n = noutput_items - produced;
+        auto limit = [&](uint64_t offset) {
+            if (offset > sample) {
+                n = std::min(n, int((offset - sample + decim - 1) / decim));
+            }
+        };
+        if (next_tag < d_tags.size()) {
+            limit(d_tags[next_tag].offset);
+        }
+        if (!d_commands.empty()) {
+            limit(command_offset(d_commands.front()));
+        }
+        d_fir.filterNdec(&d_tmp[produced], &in[uint64_t(produced) * decim], n, decim);
+        d_r.rotateN(&out[produced], &d_tmp[produced], n);
+        produced += n;
+    }
+
+    // Tell runtime system how many output items we produced.
+    return noutput_items;
+}
+
+} /* namespace timing_utils */
+} /* namespace gr */
@@ -0,0 +1,89 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_TIMED_DDC_IMPL_H
+#define INCLUDED_TIMING_UTILS_TIMED_DDC_IMPL_H
+
+#include "timed_tag_retuner_impl.h"
+#include <gnuradio/blocks/rotator.h>
+#include <gnuradio/filter/fir_filter.h>
+#include <gnuradio/timing_utils/timed_ddc.h>
+#include <deque>
+
+namespace gr {
+namespace timing_utils {
+
+// timed retune, resolved to a sample in work
+struct ddc_command_t {
+    double freq;
+    uint64_t secs;
+    double frac;
+    bool now;
+};
+
+class timed_ddc_impl : public timed_ddc
+{
+private:
+    uint32_t d_event_source;
+    double d_sample_rate;
+    double d_center_freq;
+    std::vector<float> d_proto_taps;
+    uint64_t d_delay;
+    pmt::pmt_t d_dict_key;
+    uint64_t d_retunes;
+
+    // reference time, updated from rx_time tags
+    ref_time_t d_ref_time;
+
+    std::deque<ddc_command_t> d_commands;
+
+    std::vector<gr_complex> d_ctaps;
+    filter::kernel::fir_filter_ccc d_fir;
+    blocks::rotator d_r;
+    std::vector<gr_complex> d_tmp;
+    std::vector<tag_t> d_tags;
+
+    void command_handler(pmt::pmt_t msg);
+    void retune(double center_freq);
+    uint64_t command_offset(const ddc_command_t& command) const;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param decimation - decimation rate
+     * @param taps - low pass filter taps
+     * @param center_freq - center frequency to down convert from (Hz)
+     * @param sample_rate - input sample rate (Hz)
+     * @param dict_key - dictionary key of the LO offset in commands
+     * @param origin_t_secs - time of the first sample (integer seconds)
+     * @param origin_t_frac - time of the first sample (fractional seconds)
+     */
+    timed_ddc_impl(int decimation,
+                   const std::vector<float>& taps,
+                   double center_freq,
+                   double sample_rate,
+                   pmt::pmt_t dict_key,
+                   uint64_t origin_t_secs,
+                   double origin_t_frac);
+    ~timed_ddc_impl();
+
+    void set_center_freq(double center_freq);
+    double center_freq() const;
+    uint64_t retunes() const;
+
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items);
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_TIMED_DDC_IMPL_H */
@@ -13,9 +13,15 @@
 
 #include "timed_freq_xlating_fir_impl.h"
 #include <gnuradio/io_signature.h>
+#include <gnuradio/timing_utils/event_log.h>
 #include <volk/volk.h>
+#include <cmath>
+#include <cstring>
 #include <stdexcept>
 
+// order of the multistage mode's CIC filter
+#define CIC_ORDER 4
+
 namespace gr {
 namespace timing_utils {
 
@@ -25,10 +31,11 @@ timed_freq_xlating_fir<I, O, T>::make(int decimation,
                                       const std::vector<T>& taps,
                                       double center_freq,
                                       double sampling_freq,
-                                      std::string tag_key)
+                                      std::string tag_key,
+                                      int cic_decimation)
 {
     return gnuradio::make_block_sptr<timed_freq_xlating_fir_impl<I, O, T>>(
-        decimation, taps, center_freq, sampling_freq, tag_key);
+        decimation, taps, center_freq, sampling_freq, tag_key, cic_decimation);
 }
 
 template <class I, class O, class T>
@@ -37,7 +44,8 @@ timed_freq_xlating_fir_impl<I, O, T>::timed_freq_xlating_fir_impl(
     const std::vector<T>& taps,
     double center_freq,
     double sampling_freq,
-    std::string tag_key)
+    std::string tag_key,
+    int cic_decimation)
     : sync_decimator("timed_freq_xlating_fir",
                      io_signature::make(1, 1, sizeof(I)),
                      io_signature::make(1, 1, sizeof(O)),
@@ -50,8 +58,18 @@ timed_freq_xlating_fir_impl<I, O, T>::timed_freq_xlating_fir_impl(
       d_tag_key(tag_key),
       d_phase(0.0),
       d_tag_freq_applied(false),
-      d_phase_updated(false)
+      d_phase_updated(false),
+      d_cic_decim(cic_decimation),
+      d_cic_fir(nullptr),
+      d_final_fir(nullptr),
+      d_delay(0)
 {
+    d_event_source = event_log::source(this->symbol_name());
+    if ((cic_decimation < 1) || (decimation % cic_decimation != 0)) {
+        throw std::invalid_argument(
+            "timed_freq_xlating_fir: cic_decimation must divide the decimation");
+    }
+
     // fir filter - output is always complex so taps for the fir are always complex
     // even though specified taps can be of a different type
     std::vector<gr_complex> dummy_taps;
@@ -59,16 +77,23 @@ timed_freq_xlating_fir_impl<I, O, T>::timed_freq_xlating_fir_impl(
 
     // set taps
     set_taps(taps);
+    assert(d_proto_taps.size() != 0);
 
+    if (d_cic_decim > 1) {
+        d_cic_fir = new filter::kernel::fir_filter<gr_complex, gr_complex, float>(
+            std::vector<float>(1, 1.0));
+        d_final_fir = new filter::kernel::fir_filter<gr_complex, gr_complex, gr_complex>(
+            dummy_taps);
+        build_multistage();
+    } else {
+        // set history size to be the maximum number of supported taps
+        // as the buffer can not be resized during operation
+        this->set_history(d_proto_taps.size());
+        build_composite_fir();
 
-    // set history size to be the maximum number of supported taps
-    // as the buffer can not be resized during operation
-    this->set_history(d_proto_taps.size());
-    build_composite_fir();
-
-    // ensure tags are propagated properly
-    assert(d_proto_taps.size() != 0);
-    this->declare_sample_delay((d_proto_taps.size() - 1) / 2);
+        // ensure tags are propagated properly
+        this->declare_sample_delay((d_proto_taps.size() - 1) / 2);
+    }
 
     // set tag pmt
     d_tag_pmt = pmt::string_to_symbol(d_tag_key);
@@ -86,6 +111,8 @@ template <class I, class O, class T>
 timed_freq_xlating_fir_impl<I, O, T>::~timed_freq_xlating_fir_impl()
 {
     delete d_composite_fir;
+    delete d_cic_fir;
+    delete d_final_fir;
 }
 
 template <class I, class O, class T>
@@ -120,11 +147,119 @@ void timed_freq_xlating_fir_impl<I, O, T>::build_composite_fir()
     d_r.set_phase_incr(exp(gr_complex(0, -fwT0 * this->decimation())));
 }
 
+// keep the newest `n` items of a history buffer, zero filling if it grows
+static void keep_history(std::vector<gr_complex>& buffer, size_t n)
+{
+    if (buffer.size() < n) {
+        buffer.insert(buffer.begin(), n - buffer.size(), gr_complex(0, 0));
+    } else {
+        buffer.erase(buffer.begin(), buffer.begin() + (buffer.size() - n));
+    }
+}
+
+template <class I, class O, class T>
+void timed_freq_xlating_fir_impl<I, O, T>::build_multistage()
+{
+    this->set_decimation(d_decim);
+    const uint32_t R = d_cic_decim;
+
+    // The input is mixed down at the input rate, so a retune can apply at
+    // any input sample, then decimated in two stages:
+    //    x(t) -> (mult by -fwT0) -> CIC -> decim R -> FIR -> decim D/R -> y(t)
+    // The CIC is applied in its non-recursive form, CIC_ORDER cascaded
+    // boxcars of length R, which takes the same CIC_ORDER operations per
+    // input sample as the integrators without their unbounded growth in
+    // floating point. Its taps are built with running sums, normalized to
+    // unity gain at DC.
+    std::vector<double> cic(1, 1.0);
+    for (int stage = 0; stage < CIC_ORDER; stage++) {
+        std::vector<double> boxcar(cic.size() + R - 1);
+        double sum = 0.0;
+        for (size_t i = 0; i < boxcar.size(); i++) {
+            sum += (i < cic.size()) ? cic[i] : 0.0;
+            sum -= (i >= R) ? cic[i - R] : 0.0;
+            boxcar[i] = sum / R;
+        }
+        cic.swap(boxcar);
+    }
+    d_cic_taps.assign(cic.begin(), cic.end());
+    d_cic_fir->set_taps(d_cic_taps);
+
+    // The final FIR is the prototype with the CIC droop over its passband
+    // divided out, by frequency sampling; the CIC response has no zeros
+    // within the CIC output band, so the equalization is bounded, and being
+    // real and even it keeps the prototype's length and linear phase. Beyond
+    // the passband edge, bins within 3 dB of the peak, the equalization is
+    // held at its edge value so the prototype's stopband is not boosted.
+    const size_t ntaps = d_proto_taps.size();
+    const size_t nfft = std::max(size_t(64), 8 * ntaps);
+    std::vector<std::complex<double>> response(nfft);
+    double peak = 0.0;
+    for (size_t k = 0; k < nfft; k++) {
+        std::complex<double> h = 0;
+        for (size_t n = 0; n < ntaps; n++) {
+            h += std::complex<double>(d_proto_taps[n]) *
+                 std::polar(1.0, -2 * M_PI * double(k * n % nfft) / nfft);
+        }
+        response[k] = h;
+        peak = std::max(peak, std::abs(h));
+    }
+    // cycles per CIC output sample
+    auto bin_freq = [nfft](size_t k) {
+        return ((k < nfft / 2) ? double(k) : double(k) - double(nfft)) / nfft;
+    };
+    double edge = 0.0;
+    for (size_t k = 0; k < nfft; k++) {
+        if (std::abs(response[k]) >= peak * M_SQRT1_2) {
+            edge = std::max(edge, std::abs(bin_freq(k)));
+        }
+    }
+    for (size_t k = 0; k < nfft; k++) {
+        double nu = std::min(std::abs(bin_freq(k)), edge);
+        double droop = 1.0;
+        if (nu > 0.0) {
+            droop = std::pow(std::sin(M_PI * nu) / (R * std::sin(M_PI * nu / R)),
+                             CIC_ORDER);
+        }
+        response[k] /= droop;
+    }
+    d_final_taps.resize(ntaps);
+    for (size_t n = 0; n < ntaps; n++) {
+        std::complex<double> tap = 0;
+        for (size_t k = 0; k < nfft; k++) {
+            tap += response[k] * std::polar(1.0, 2 * M_PI * double(k * n % nfft) / nfft);
+        }
+        d_final_taps[n] = gr_complex(tap / double(nfft));
+    }
+    d_final_fir->set_taps(d_final_taps);
+
+    // mixed input and CIC output are carried between calls rather than in
+    // the block history
+    keep_history(d_mixed, d_cic_taps.size() - 1);
+    keep_history(d_cic, ntaps - 1);
+    this->set_history(1);
+
+    // both stages are linear phase, their delays add at the input rate
+    d_delay = (CIC_ORDER * (R - 1) + R * (ntaps - 1)) / 2;
+    this->declare_sample_delay(d_delay);
+
+    if (d_phase_updated) {
+        d_r.set_phase(exp(gr_complex(0, -1.0 * d_phase)));
+        d_phase_updated = false;
+    }
+    d_r.set_phase_incr(exp(gr_complex(0, -2 * M_PI * d_center_freq / d_sampling_freq)));
+}
+
 template <class I, class O, class T>
 void timed_freq_xlating_fir_impl<I, O, T>::set_decim(int decimation)
 {
     gr::thread::scoped_lock l(this->d_setlock);
-    if (decimation > 0) {
+    if ((decimation > 0) && (decimation % d_cic_decim != 0)) {
+        GR_LOG_ERROR(this->d_logger,
+                     boost::format("decimation %d is not a multiple of the CIC "
+                                   "decimation %d") %
+                         decimation % d_cic_decim);
+    } else if (decimation > 0) {
         d_decim = decimation;
         d_updated = true;
 
@@ -140,6 +275,12 @@ int timed_freq_xlating_fir_impl<I, O, T>::decim() const
     return d_decim;
 }
 
+template <class I, class O, class T>
+int timed_freq_xlating_fir_impl<I, O, T>::cic_decim() const
+{
+    return d_cic_decim;
+}
+
 template <class I, class O, class T>
 void timed_freq_xlating_fir_impl<I, O, T>::set_rate(double rate)
 {
@@ -249,6 +390,103 @@ void timed_freq_xlating_fir_impl<I, O, T>::scale(std::vector<gr_complex>& output
     }
 }
 
+template <class I, class O, class T>
+void timed_freq_xlating_fir_impl<I, O, T>::convert(gr_complex* output,
+                                                   const gr_complex* input,
+                                                   size_t n)
+{
+    memcpy(output, input, n * sizeof(gr_complex));
+}
+
+template <class I, class O, class T>
+void timed_freq_xlating_fir_impl<I, O, T>::convert(gr_complex* output,
+                                                   const float* input,
+                                                   size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        output[i] = gr_complex(input[i], 0);
+    }
+}
+
+template <class I, class O, class T>
+void timed_freq_xlating_fir_impl<I, O, T>::convert(gr_complex* output,
+                                                   const short* input,
+                                                   size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        output[i] = gr_complex(input[i], 0);
+    }
+}
+
+template <class I, class O, class T>
+int timed_freq_xlating_fir_impl<I, O, T>::work_multistage(
+    int noutput_items,
+    gr_vector_const_void_star& input_items,
+    gr_vector_void_star& output_items)
+{
+    const I* in = (const I*)input_items[0];
+    O* out = (O*)output_items[0];
+
+    // rebuild the stages if anything has changed
+    if (d_updated) {
+        build_multistage();
+        d_updated = false;
+        this->add_item_tag(0,
+                           this->nitems_written(0),
+                           PMTCONSTSTR__freq(),
+                           pmt::from_double(d_center_freq),
+                           this->alias_pmt());
+        return 0; // the decimation may have changed
+    }
+
+    const size_t nin = size_t(noutput_items) * d_decim;
+    const size_t mix_history = d_mixed.size();
+    const size_t cic_history = d_cic.size();
+    const size_t ncic = size_t(noutput_items) * (d_decim / d_cic_decim);
+
+    // mix down, retuning at each tagged sample; tags are read back shifted
+    // by the declared delay
+    const uint64_t nread = this->nitems_read(0);
+    this->get_tags_in_range(d_tags, 0, nread + d_delay, nread + nin + d_delay, d_tag_pmt);
+    d_mixed.resize(mix_history + nin);
+    gr_complex* mixed = &d_mixed[mix_history];
+    convert(mixed, in, nin);
+    size_t done = 0;
+    for (const tag_t& tag : d_tags) {
+        const size_t offset = tag.offset - d_delay - nread;
+        d_r.rotateN(mixed + done, mixed + done, offset - done);
+        done = offset;
+
+        if (pmt::is_pair(tag.value)) {
+            d_center_freq = pmt::to_double(pmt::car(tag.value));
+            d_r.set_phase(exp(gr_complex(0, -pmt::to_double(pmt::cdr(tag.value)))));
+        } else if (pmt::is_real(tag.value)) {
+            d_center_freq = pmt::to_double(tag.value);
+        } else {
+            GR_LOG_ERROR(this->d_logger, "Invalid frequency tag type");
+            continue;
+        }
+        d_r.set_phase_incr(
+            exp(gr_complex(0, -2 * M_PI * d_center_freq / d_sampling_freq)));
+        event_log::log(EVENT_RETUNE, d_event_source, nread + offset, d_center_freq);
+        GR_LOG_DEBUG(
+            this->d_logger,
+            boost::format("Synchronously setting freq xlator to %f at sample %d") %
+                d_center_freq % (nread + offset));
+    }
+    d_r.rotateN(mixed + done, mixed + done, nin - done);
+
+    // CIC output j and output k end at input samples j * R and k * decim
+    d_cic.resize(cic_history + ncic);
+    d_cic_fir->filterNdec(&d_cic[cic_history], &d_mixed[0], ncic, d_cic_decim);
+    d_final_fir->filterNdec(out, &d_cic[0], noutput_items, d_decim / d_cic_decim);
+
+    keep_history(d_mixed, mix_history);
+    keep_history(d_cic, cic_history);
+
+    return noutput_items;
+}
+
 template <class I, class O, class T>
 int timed_freq_xlating_fir_impl<I, O, T>::work(int noutput_items,
                                                gr_vector_const_void_star& input_items,
@@ -256,6 +494,10 @@ int timed_freq_xlating_fir_impl<I, O, T>::work(int noutput_items,
 {
     gr::thread::scoped_lock l(this->d_setlock);
 
+    if (d_cic_decim > 1) {
+        return work_multistage(noutput_items, input_items, output_items);
+    }
+
     I* in = (I*)input_items[0];
     O* out = (O*)output_items[0];
 
@@ -281,7 +523,9 @@ int timed_freq_xlating_fir_impl<I, O, T>::work(int noutput_items,
                     double new_phase = pmt::to_double(pmt::cdr(tags[0].value));
                     handle_set_center_freq(pmt::dict_add(
                         pmt::make_dict(), PMTCONSTSTR__freq(), tags[0].value));
-                    GR_LOG_INFO(
+                    event_log::log(
+                        EVENT_RETUNE, d_event_source, tags[0].offset, new_freq);
+                    GR_LOG_DEBUG(
                         this->d_logger,
                         boost::format("Synchronously setting freq xlator to %f Hz with a "
                                       "phase of %f radians at sample %d") %
@@ -293,7 +537,9 @@ int timed_freq_xlating_fir_impl<I, O, T>::work(int noutput_items,
                         // inform the block to retune the next time it is run
                         handle_set_center_freq(pmt::dict_add(
                             pmt::make_dict(), PMTCONSTSTR__freq(), tags[0].value));
-                        GR_LOG_INFO(
+                        event_log::log(
+                            EVENT_RETUNE, d_event_source, tags[0].offset, new_freq);
+                        GR_LOG_DEBUG(
                             this->d_logger,
                             boost::format(
                                 "Synchronously setting freq xlator to %f at sample %d") %
@@ -26,6 +26,7 @@ template <class I, class O, class T>
 class timed_freq_xlating_fir_impl : public timed_freq_xlating_fir<I, O, T>
 {
 protected:
+    uint32_t d_event_source;
     double d_center_freq;
     double d_sampling_freq;
     bool d_updated;
@@ -45,7 +46,23 @@ protected:
     uint64_t d_in_tag_offset;
     uint64_t d_out_tag_offset;
 
+    // multistage mode: mixed input and CIC output, each led by its filter's
+    // history, and the declared delay (input samples)
+    uint32_t d_cic_decim;
+    std::vector<float> d_cic_taps;
+    std::vector<gr_complex> d_final_taps;
+    filter::kernel::fir_filter<gr_complex, gr_complex, float>* d_cic_fir;
+    filter::kernel::fir_filter<gr_complex, gr_complex, gr_complex>* d_final_fir;
+    std::vector<gr_complex> d_mixed;
+    std::vector<gr_complex> d_cic;
+    uint64_t d_delay;
+    std::vector<tag_t> d_tags;
+
     virtual void build_composite_fir();
+    void build_multistage();
+    int work_multistage(int noutput_items,
+                        gr_vector_const_void_star& input_items,
+                        gr_vector_void_star& output_items);
     void handle_set_center_freq(pmt::pmt_t msg);
 
     void set_center_freq_(double center_freq, double phase = 0.0);
@@ -55,17 +72,24 @@ protected:
     void scale(std::vector<gr_complex>& output, float* input);
     void scale(std::vector<gr_complex>& output, short* input);
 
+    // overloaded conversion to complex for all input types
+    void convert(gr_complex* output, const gr_complex* input, size_t n);
+    void convert(gr_complex* output, const float* input, size_t n);
+    void convert(gr_complex* output, const short* input, size_t n);
+
 
 public:
     timed_freq_xlating_fir_impl(int decimation,
                                 const std::vector<T>& taps,
                                 double center_freq,
                                 double sampling_freq,
-                                std::string tag_key);
+                                std::string tag_key,
+                                int cic_decimation);
     ~timed_freq_xlating_fir_impl();
 
     void set_decim(int decimation);
     int decim() const;
+    int cic_decim() const;
 
     void set_rate(double rate);
     double rate() const;
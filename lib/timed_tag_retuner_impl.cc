@@ -13,6 +13,7 @@
 
 #include "timed_tag_retuner_impl.h"
 #include <gnuradio/io_signature.h>
+#include <gnuradio/timing_utils/event_log.h>
 
 #define MAX_NUM_COMMANDS 64
 
@@ -43,6 +44,7 @@ timed_tag_retuner_impl::timed_tag_retuner_impl(double sample_rate,
       d_dict_key(dict_key),
       d_ref_time(origin_t_secs, origin_t_frac, 0)
 {
+    d_event_source = event_log::source(symbol_name());
 
     // downstream timed frequency translating fir filter block
     // uses this tag to change frequencies
@@ -166,6 +168,12 @@ int timed_tag_retuner_impl::work(int noutput_items,
 
         if (tag) {
             this->add_item_tag(0, offset, d_tag_key, tune_command.tag);
+            if (event_log::enabled()) {
+                event_log::log(EVENT_RETUNE,
+                               d_event_source,
+                               offset,
+                               pmt::to_double(tune_command.tag));
+            }
             d_tune_commands.pop();
         } else {
             break;
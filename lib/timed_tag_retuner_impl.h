@@ -51,6 +51,7 @@ struct tune_command_t {
 class timed_tag_retuner_impl : public timed_tag_retuner
 {
 private:
+    uint32_t d_event_source;
     // sample rate
     double d_sample_rate;
 
@@ -0,0 +1,56 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_TRACE_RECORD_H
+#define INCLUDED_TIMING_UTILS_TRACE_RECORD_H
+
+#include <gnuradio/timing_utils/constants.h>
+
+namespace gr {
+namespace timing_utils {
+
+/*
+ * Latency trace records
+ *
+ * A trace record is a list of (block alias . system time) pairs, carried as
+ * the `trace` field of PDU metadata or as the value of a `trace` stream tag.
+ * Entries are prepended so adding a hop is O(1) and shares the rest of the
+ * record with upstream copies; the newest hop comes first.
+ */
+static inline pmt::pmt_t trace_add(const pmt::pmt_t& trace, const pmt::pmt_t& name, double t)
+{
+    return pmt::cons(pmt::cons(name, pmt::from_double(t)), trace);
+}
+
+// add a hop to the trace record in `meta`, if there is one
+static inline pmt::pmt_t
+trace_add_meta(const pmt::pmt_t& meta, const pmt::pmt_t& name, double t)
+{
+    pmt::pmt_t trace = pmt::dict_ref(meta, PMTCONSTSTR__trace(), pmt::PMT_F);
+    if (!pmt::is_pair(trace)) {
+        return meta;
+    }
+    return pmt::dict_add(meta, PMTCONSTSTR__trace(), trace_add(trace, name, t));
+}
+
+// start a trace record in `meta`, or add a hop to an existing one
+static inline pmt::pmt_t
+trace_start_meta(const pmt::pmt_t& meta, const pmt::pmt_t& name, double t)
+{
+    pmt::pmt_t trace = pmt::dict_ref(meta, PMTCONSTSTR__trace(), pmt::PMT_NIL);
+    if (!pmt::is_pair(trace)) {
+        trace = pmt::PMT_NIL;
+    }
+    return pmt::dict_add(meta, PMTCONSTSTR__trace(), trace_add(trace, name, t));
+}
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_TRACE_RECORD_H */
@@ -0,0 +1,189 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "trace_sink_impl.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/timing_utils/constants.h>
+#include <boost/format.hpp>
+#include <boost/thread/thread_time.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace gr {
+namespace timing_utils {
+
+trace_sink::sptr trace_sink::make(const std::string& filename, size_t itemsize)
+{
+    return gnuradio::make_block_sptr<trace_sink_impl>(filename, itemsize);
+}
+
+/*
+ * The private constructor
+ */
+trace_sink_impl::trace_sink_impl(const std::string& filename, size_t itemsize)
+    : gr::sync_block("trace_sink",
+                     gr::io_signature::make(0, 1, itemsize),
+                     gr::io_signature::make(0, 0, 0)),
+      d_trace_name(pmt::PMT_NIL),
+      d_records(0),
+      d_spans(0)
+{
+    boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+    d_epoch = epoch;
+
+    d_fp = fopen(filename.c_str(), "w");
+    if (!d_fp) {
+        throw std::runtime_error(
+            (boost::format("can't open trace file %s: %s") % filename % strerror(errno))
+                .str());
+    }
+    // the closing bracket is optional in the array format, so the file is
+    // readable even if the flowgraph does not shut down cleanly
+    fputs("[\n", d_fp);
+
+    message_port_register_in(PMTCONSTSTR__pdu_in());
+    set_msg_handler(PMTCONSTSTR__pdu_in(),
+                    [this](pmt::pmt_t msg) { this->handle_pdu(msg); });
+}
+
+/*
+ * Our virtual destructor.
+ */
+trace_sink_impl::~trace_sink_impl()
+{
+    fputs("\n]\n", d_fp);
+    fclose(d_fp);
+}
+
+uint64_t trace_sink_impl::records()
+{
+    gr::thread::scoped_lock l(d_setlock);
+    return d_records;
+}
+
+bool trace_sink_impl::start()
+{
+    // the alias is set after construction
+    d_trace_name = alias_pmt();
+    return sync_block::start();
+}
+
+bool trace_sink_impl::stop()
+{
+    gr::thread::scoped_lock l(d_setlock);
+    fflush(d_fp);
+    return sync_block::stop();
+}
+
+static std::string json_escape(const std::string& str)
+{
+    std::string out;
+    for (char c : str) {
+        if ((c == '"') || (c == '\\')) {
+            out += '\\';
+            out += c;
+        } else if ((unsigned char)c < 0x20) {
+            out += (boost::format("\\u%04x") % int(c)).str();
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+// must be called with d_setlock held
+void trace_sink_impl::write_event(const std::string& name, char phase, double t)
+{
+    // every event but the first begin event follows another
+    const char* sep = (d_spans || (phase == 'e')) ? ",\n" : "";
+    fprintf(d_fp,
+            "%s{\"name\":\"%s\",\"cat\":\"trace\",\"ph\":\"%c\",\"id\":%llu,"
+            "\"ts\":%.3f,\"pid\":0,\"tid\":0}",
+            sep,
+            name.c_str(),
+            phase,
+            (unsigned long long)d_spans,
+            t * 1e6);
+}
+
+// must be called with d_setlock held
+void trace_sink_impl::write_record(const pmt::pmt_t& trace, double t_now)
+{
+    d_hops.clear();
+    for (pmt::pmt_t entry = trace; pmt::is_pair(entry); entry = pmt::cdr(entry)) {
+        pmt::pmt_t hop = pmt::car(entry);
+        if (!pmt::is_pair(hop) || !pmt::is_symbol(pmt::car(hop)) ||
+            !pmt::is_real(pmt::cdr(hop))) {
+            GR_LOG_DEBUG(d_logger, "received malformed trace record");
+            return;
+        }
+        d_hops.emplace_back(json_escape(pmt::symbol_to_string(pmt::car(hop))),
+                            pmt::to_double(pmt::cdr(hop)));
+    }
+
+    // records are newest first
+    std::reverse(d_hops.begin(), d_hops.end());
+    d_hops.emplace_back(json_escape(pmt::symbol_to_string(d_trace_name)), t_now);
+
+    for (size_t ii = 1; ii < d_hops.size(); ii++) {
+        const std::string name = d_hops[ii - 1].first + " -> " + d_hops[ii].first;
+        write_event(name, 'b', d_hops[ii - 1].second);
+        write_event(name, 'e', d_hops[ii].second);
+        d_spans++;
+    }
+    d_records++;
+}
+
+void trace_sink_impl::handle_pdu(pmt::pmt_t pdu)
+{
+    double t_now((boost::get_system_time() - d_epoch).total_microseconds() / 1000000.0);
+
+    // make sure PDU data is formed properly
+    if (!pmt::is_pair(pdu) || !pmt::is_dict(pmt::car(pdu))) {
+        GR_LOG_DEBUG(d_logger, "received malformed PDU");
+        return;
+    }
+
+    pmt::pmt_t trace = pmt::dict_ref(pmt::car(pdu), PMTCONSTSTR__trace(), pmt::PMT_F);
+    if (pmt::is_pair(trace)) {
+        gr::thread::scoped_lock l(d_setlock);
+        write_record(trace, t_now);
+    }
+}
+
+int trace_sink_impl::work(int noutput_items,
+                          gr_vector_const_void_star& input_items,
+                          gr_vector_void_star& output_items)
+{
+    gr::thread::scoped_lock l(d_setlock);
+
+    const uint64_t nread = nitems_read(0);
+    get_tags_in_range(d_tags, 0, nread, nread + noutput_items, PMTCONSTSTR__trace());
+    if (!d_tags.empty()) {
+        double t_now((boost::get_system_time() - d_epoch).total_microseconds() /
+                     1000000.0);
+        for (const tag_t& tag : d_tags) {
+            if (pmt::is_pair(tag.value)) {
+                write_record(tag.value, t_now);
+            }
+        }
+    }
+
+    // Tell runtime system how many output items we produced.
+    return noutput_items;
+}
+
+} /* namespace timing_utils */
+} /* namespace gr */
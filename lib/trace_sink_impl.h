@@ -0,0 +1,61 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018-2021 National Technology & Engineering Solutions of
+ * Sandia, LLC (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+ * Government retains certain rights in this software.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_TIMING_UTILS_TRACE_SINK_IMPL_H
+#define INCLUDED_TIMING_UTILS_TRACE_SINK_IMPL_H
+
+#include <gnuradio/timing_utils/trace_sink.h>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <cstdio>
+
+namespace gr {
+namespace timing_utils {
+
+class trace_sink_impl : public trace_sink
+{
+private:
+    boost::posix_time::ptime d_epoch;
+    FILE* d_fp;
+    pmt::pmt_t d_trace_name;
+    uint64_t d_records;
+    uint64_t d_spans;
+
+    std::vector<tag_t> d_tags;
+    std::vector<std::pair<std::string, double>> d_hops;
+
+    void write_record(const pmt::pmt_t& trace, double t_now);
+    void write_event(const std::string& name, char phase, double t);
+
+public:
+    /**
+     * Constructor
+     *
+     * @param filename - output file
+     * @param itemsize - stream input item size
+     */
+    trace_sink_impl(const std::string& filename, size_t itemsize);
+    ~trace_sink_impl();
+
+    uint64_t records();
+
+    void handle_pdu(pmt::pmt_t pdu);
+
+    // overloaded functions
+    bool start();
+    bool stop();
+
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items);
+};
+
+} // namespace timing_utils
+} // namespace gr
+
+#endif /* INCLUDED_TIMING_UTILS_TRACE_SINK_IMPL_H */
@@ -14,6 +14,9 @@
 #include "uhd_timed_pdu_emitter_impl.h"
 #include <gnuradio/io_signature.h>
 #include <gnuradio/timing_utils/constants.h>
+#include <gnuradio/timing_utils/event_log.h>
+#include <algorithm>
+#include <cmath>
 
 namespace gr {
 namespace timing_utils {
@@ -32,13 +35,15 @@ uhd_timed_pdu_emitter_impl::uhd_timed_pdu_emitter_impl(float rate, bool drop_lat
                      gr::io_signature::make(0, 0, 0)),
       d_rate(rate),
       d_drop_late(drop_late),
-      d_armed(false)
+      d_armed(false),
+      d_trigger_delay(0.0)
 {
+    d_event_source = event_log::source(symbol_name());
 
     // start time is zero
     d_start_time = to_tpmt(0, 0.0);
 
-    message_port_register_out(PMTCONSTSTR__time());
+    message_port_register_out(PMTCONSTSTR__trig());
     message_port_register_in(PMTCONSTSTR__set());
     set_msg_handler(PMTCONSTSTR__set(),
                     [this](pmt::pmt_t msg) { this->handle_set_time(msg); });
@@ -98,6 +103,14 @@ pmt::pmt_t uhd_timed_pdu_emitter_impl::calc_start_time(uint64_t samps, pmt::pmt_
  */
 pmt::pmt_t uhd_timed_pdu_emitter_impl::samples_to_tpmt(uint64_t samps)
 {
+    if (d_timeline) {
+        uint64_t t_int;
+        double t_frac;
+        if (d_timeline->time_at(samps, t_int, t_frac)) {
+            return to_tpmt(t_int, t_frac);
+        }
+    }
+
     // global vars
     double rate = d_rate;
     pmt::pmt_t start = d_start_time;
@@ -121,6 +134,13 @@ pmt::pmt_t uhd_timed_pdu_emitter_impl::samples_to_tpmt(uint64_t samps)
  */
 uint64_t uhd_timed_pdu_emitter_impl::tpmt_to_samples(pmt::pmt_t tpmt)
 {
+    if (d_timeline) {
+        uint64_t samps;
+        if (d_timeline->offset_at(tpmt_to_s(tpmt), tpmt_to_f(tpmt), samps)) {
+            return samps;
+        }
+    }
+
     // global vars
     double rate = d_rate;
     pmt::pmt_t start = d_start_time;
@@ -141,15 +161,62 @@ uint64_t uhd_timed_pdu_emitter_impl::tpmt_to_samples(pmt::pmt_t tpmt)
 }
 
 
+/*
+ * attach to (or detach from) a shared sample timeline
+ */
+void uhd_timed_pdu_emitter_impl::set_timeline(const std::string& name)
+{
+    gr::thread::scoped_lock l(d_setlock);
+
+    if (name.empty()) {
+        d_timeline.reset();
+    } else {
+        d_timeline = sample_timeline::get(name);
+    }
+}
+
+
+void uhd_timed_pdu_emitter_impl::set_trigger_delay(double delay)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_trigger_delay = std::max(delay, 0.0);
+}
+
+
 /*
  * Arms the block. Input is a PMT with either a single uint64_t PMT containting
- * the trigger sample, or a uint64_t/double pair containing the trigger time
+ * the trigger sample, or a uint64_t/double pair containing the trigger time, or
+ * a trigger message from thresh_trigger_f
  *
  * THIS CODE USES TIME PAIRS, NOT TUPLES! The rx_time tag is a PMT tuple
  * however timed commands are issued as pairs.
  */
 void uhd_timed_pdu_emitter_impl::handle_set_time(pmt::pmt_t time_pmt)
 {
+    gr::thread::scoped_lock l(d_setlock);
+
+    // trigger messages (trigger_now . info) arm on the triggering sample, by time
+    // if it is known, delayed as that sample has normally been processed
+    if (pmt::is_pair(time_pmt) &&
+        pmt::eq(pmt::car(time_pmt), PMTCONSTSTR__trigger_now())) {
+        pmt::pmt_t info = pmt::cdr(time_pmt);
+        pmt::pmt_t time = pmt::dict_ref(info, PMTCONSTSTR__trigger_time(), pmt::PMT_NIL);
+        pmt::pmt_t sample =
+            pmt::dict_ref(info, PMTCONSTSTR__trigger_sample(), pmt::PMT_NIL);
+        if (pmt::is_pair(time) && pmt::is_uint64(pmt::car(time)) &&
+            pmt::is_real(pmt::cdr(time))) {
+            double t_frac = tpmt_to_f(time) + d_trigger_delay;
+            double whole_secs = std::floor(t_frac);
+            time_pmt =
+                to_tpmt(tpmt_to_s(time) + uint64_t(whole_secs), t_frac - whole_secs);
+        } else if (pmt::is_uint64(sample)) {
+            time_pmt = pmt::from_uint64(pmt::to_uint64(sample) +
+                                        uint64_t(std::llround(d_trigger_delay * d_rate)));
+        } else {
+            return;
+        }
+    }
+
     pmt::pmt_t trigger_time = pmt::PMT_NIL;
     if (pmt::is_uint64(time_pmt)) {
         // if the tuple is a single uint64_t it is the sample to trigger
@@ -173,7 +240,8 @@ void uhd_timed_pdu_emitter_impl::handle_set_time(pmt::pmt_t time_pmt)
     // build the output PMT dictionary
     d_pmt_out = pmt::make_dict();
     d_pmt_out = pmt::dict_add(d_pmt_out, PMTCONSTSTR__trigger_time(), trigger_time);
-    d_pmt_out = pmt::dict_add(d_pmt_out, PMTCONSTSTR__trigger_sample(), pmt::from_double(d_trigger_samp));
+    d_pmt_out = pmt::dict_add(
+        d_pmt_out, PMTCONSTSTR__trigger_sample(), pmt::from_double(d_trigger_samp));
     d_pmt_out = pmt::dict_add(d_pmt_out, PMTCONSTSTR__late_delta(), pmt::from_double(0));
     d_armed = true;
     // std::cout << "ARMED! FOR TIME " << d_pmt_out << std::endl;
@@ -195,9 +263,11 @@ int uhd_timed_pdu_emitter_impl::work(int noutput_items,
             if (d_trigger_samp < nitems_read(0)) {
                 if (!d_drop_late) {
                     message_port_pub(PMTCONSTSTR__trig(), d_pmt_out);
+                    event_log::log(EVENT_INTERRUPT, d_event_source, d_trigger_samp);
                 }
             } else {
                 message_port_pub(PMTCONSTSTR__trig(), d_pmt_out);
+                event_log::log(EVENT_INTERRUPT, d_event_source, d_trigger_samp);
             }
             d_armed = false;
         }
@@ -10,6 +10,7 @@
 #ifndef INCLUDED_TIMING_UTILS_UHD_TIMED_PDU_EMITTER_IMPL_H
 #define INCLUDED_TIMING_UTILS_UHD_TIMED_PDU_EMITTER_IMPL_H
 
+#include <gnuradio/timing_utils/sample_timeline.h>
 #include <gnuradio/timing_utils/uhd_timed_pdu_emitter.h>
 
 namespace gr {
@@ -18,12 +19,15 @@ namespace timing_utils {
 class uhd_timed_pdu_emitter_impl : public uhd_timed_pdu_emitter
 {
 private:
+    uint32_t d_event_source;
     float d_rate;
     bool d_drop_late;
     bool d_armed;
     uint64_t d_trigger_samp;
     pmt::pmt_t d_pmt_out;
     pmt::pmt_t d_start_time;
+    sample_timeline::sptr d_timeline;
+    double d_trigger_delay;
 
     pmt::pmt_t to_tpmt(uint64_t, double);
 
@@ -55,6 +59,9 @@ public:
      */
     void set_rate(float rate) { d_rate = rate; }
 
+    void set_timeline(const std::string& name);
+    void set_trigger_delay(double delay);
+
     // Where all the action really happens
     int work(int noutput_items,
              gr_vector_const_void_star& input_items,
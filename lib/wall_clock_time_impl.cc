@@ -12,24 +12,27 @@
 #endif
 
 #include "wall_clock_time_impl.h"
+#include "trace_record.h"
 #include <gnuradio/io_signature.h>
 
 namespace gr {
 namespace timing_utils {
 
-wall_clock_time::sptr wall_clock_time::make(const pmt::pmt_t key)
+wall_clock_time::sptr wall_clock_time::make(const pmt::pmt_t key, bool trace)
 {
-    return gnuradio::make_block_sptr<wall_clock_time_impl>(key);
+    return gnuradio::make_block_sptr<wall_clock_time_impl>(key, trace);
 }
 
 /*
  * The private constructor
  */
-wall_clock_time_impl::wall_clock_time_impl(const pmt::pmt_t key)
+wall_clock_time_impl::wall_clock_time_impl(const pmt::pmt_t key, bool trace)
     : gr::block("wall_clock_time",
                 gr::io_signature::make(0, 0, 0),
                 gr::io_signature::make(0, 0, 0)),
-      d_key(key)
+      d_key(key),
+      d_trace(trace),
+      d_trace_name(pmt::PMT_NIL)
 {
     boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
     d_epoch = epoch;
@@ -45,6 +48,19 @@ wall_clock_time_impl::wall_clock_time_impl(const pmt::pmt_t key)
  */
 wall_clock_time_impl::~wall_clock_time_impl() {}
 
+void wall_clock_time_impl::set_trace(bool trace)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_trace = trace;
+}
+
+bool wall_clock_time_impl::start()
+{
+    // the alias is set after construction
+    d_trace_name = alias_pmt();
+    return block::start();
+}
+
 void wall_clock_time_impl::handle_pdu(pmt::pmt_t pdu)
 {
     // make sure PDU data is formed properly
@@ -58,6 +74,11 @@ void wall_clock_time_impl::handle_pdu(pmt::pmt_t pdu)
     // append time and publish
     double t_now((boost::get_system_time() - d_epoch).total_microseconds() / 1000000.0);
     meta = pmt::dict_add(meta, d_key, pmt::from_double(t_now));
+    {
+        gr::thread::scoped_lock l(d_setlock);
+        meta = d_trace ? trace_start_meta(meta, d_trace_name, t_now)
+                       : trace_add_meta(meta, d_trace_name, t_now);
+    }
     message_port_pub(PMTCONSTSTR__pdu_out(), (pmt::cons(meta, pmt::cdr(pdu))));
 }
 
@@ -22,11 +22,18 @@ private:
     boost::posix_time::ptime d_epoch;
     std::string d_name;
     pmt::pmt_t d_key;
+    bool d_trace;
+    pmt::pmt_t d_trace_name;
 
 public:
-    wall_clock_time_impl(const pmt::pmt_t key);
+    wall_clock_time_impl(const pmt::pmt_t key, bool trace);
     ~wall_clock_time_impl();
 
+    void set_trace(bool trace);
+
+    // overloaded functions
+    bool start();
+
     void handle_pdu(pmt::pmt_t pdu);
 };
 
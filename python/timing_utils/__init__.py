@@ -21,8 +21,6 @@ except ModuleNotFoundError:
 
 # import any pure python here
 from .retune_uhd_to_timed_tag import retune_uhd_to_timed_tag
-from .edge_distance import edge_distance
-from .edge_detector_bb import *
 try:
     from .usrp_gps_time_sync import usrp_gps_time_sync
 except Exception as e:
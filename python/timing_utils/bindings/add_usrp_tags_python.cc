@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(add_usrp_tags.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(78a62c083b910f759652246f34cfb297)                     */
+/* BINDTOOL_HEADER_FILE_HASH(3ff8eca23a37ac1629e1341c8fcc6e87)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -45,7 +45,9 @@ void bind_add_usrp_tags_template(py::module& m, const char* classname)
              py::arg("epoch_frac"))
         .def("tag_now", &add_usrp_tags::tag_now, py::arg("dummy"))
         .def("update_tags", &add_usrp_tags::update_tags, py::arg("update"))
-        .def("last_tag", &add_usrp_tags::last_tag);
+        .def("last_tag", &add_usrp_tags::last_tag)
+        .def("set_timeline", &add_usrp_tags::set_timeline, py::arg("name"))
+        .def("set_sigmf", &add_usrp_tags::set_sigmf, py::arg("filename"));
 }
 
 
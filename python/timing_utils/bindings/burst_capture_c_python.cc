@@ -0,0 +1,76 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(burst_capture_c.h)                                         */
+/* BINDTOOL_HEADER_FILE_HASH(19e4550be819eb71246c32fdc1c0725e)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/timing_utils/burst_capture_c.h>
+// pydoc.h is automatically generated in the build directory
+#include <burst_capture_c_pydoc.h>
+
+void bind_burst_capture_c(py::module& m)
+{
+
+    using burst_capture_c = ::gr::timing_utils::burst_capture_c;
+
+
+    py::class_<burst_capture_c,
+               gr::sync_block,
+               gr::block,
+               gr::basic_block,
+               std::shared_ptr<burst_capture_c>>(
+        m, "burst_capture_c", D(burst_capture_c))
+
+        .def(py::init(&burst_capture_c::make),
+             py::arg("hi"),
+             py::arg("lo"),
+             py::arg("length"),
+             py::arg("pre"),
+             py::arg("post"),
+             D(burst_capture_c, make))
+
+
+        .def("set_hi",
+             &burst_capture_c::set_hi,
+             py::arg("t"),
+             D(burst_capture_c, set_hi))
+
+
+        .def("set_lo",
+             &burst_capture_c::set_lo,
+             py::arg("t"),
+             D(burst_capture_c, set_lo))
+
+
+        .def("set_len",
+             &burst_capture_c::set_len,
+             py::arg("len"),
+             D(burst_capture_c, set_len))
+
+
+        .def("set_rate",
+             &burst_capture_c::set_rate,
+             py::arg("rate"),
+             D(burst_capture_c, set_rate))
+
+        ;
+}
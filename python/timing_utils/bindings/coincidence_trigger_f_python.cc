@@ -0,0 +1,89 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(coincidence_trigger_f.h)                                   */
+/* BINDTOOL_HEADER_FILE_HASH(fa0f1638984937933f3179bf6adb9e8b)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/timing_utils/coincidence_trigger_f.h>
+// pydoc.h is automatically generated in the build directory
+#include <coincidence_trigger_f_pydoc.h>
+
+void bind_coincidence_trigger_f(py::module& m)
+{
+
+    using coincidence_trigger_f = ::gr::timing_utils::coincidence_trigger_f;
+
+
+    py::class_<coincidence_trigger_f,
+               gr::sync_block,
+               gr::block,
+               gr::basic_block,
+               std::shared_ptr<coincidence_trigger_f>>(
+        m, "coincidence_trigger_f", D(coincidence_trigger_f))
+
+        .def(py::init(&coincidence_trigger_f::make),
+             py::arg("nchan"),
+             py::arg("hi"),
+             py::arg("lo"),
+             py::arg("length"),
+             py::arg("k"),
+             py::arg("window"),
+             D(coincidence_trigger_f, make))
+
+
+        .def("set_hi",
+             &coincidence_trigger_f::set_hi,
+             py::arg("t"),
+             D(coincidence_trigger_f, set_hi))
+
+
+        .def("set_lo",
+             &coincidence_trigger_f::set_lo,
+             py::arg("t"),
+             D(coincidence_trigger_f, set_lo))
+
+
+        .def("set_len",
+             &coincidence_trigger_f::set_len,
+             py::arg("len"),
+             D(coincidence_trigger_f, set_len))
+
+
+        .def("set_k",
+             &coincidence_trigger_f::set_k,
+             py::arg("k"),
+             D(coincidence_trigger_f, set_k))
+
+
+        .def("set_window",
+             &coincidence_trigger_f::set_window,
+             py::arg("window"),
+             D(coincidence_trigger_f, set_window))
+
+
+        .def("set_rate",
+             &coincidence_trigger_f::set_rate,
+             py::arg("rate"),
+             D(coincidence_trigger_f, set_rate))
+
+        ;
+}
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(constants.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(bbe317fb26cd8db9457406f03217f64d)                     */
+/* BINDTOOL_HEADER_FILE_HASH(a07b06dfd208410a17f48aa50944a1a8)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -133,4 +133,109 @@ void bind_constants(py::module& m)
 
 
     m.def("PMTCONSTSTR__END", &::gr::timing_utils::PMTCONSTSTR__END, D(PMTCONSTSTR__END));
+
+
+    m.def("PMTCONSTSTR__gap",
+          &::gr::timing_utils::PMTCONSTSTR__gap,
+          D(PMTCONSTSTR__gap));
+
+
+    m.def("PMTCONSTSTR__dropped",
+          &::gr::timing_utils::PMTCONSTSTR__dropped,
+          D(PMTCONSTSTR__dropped));
+
+
+    m.def("PMTCONSTSTR__filled",
+          &::gr::timing_utils::PMTCONSTSTR__filled,
+          D(PMTCONSTSTR__filled));
+
+
+    m.def("PMTCONSTSTR__shed",
+          &::gr::timing_utils::PMTCONSTSTR__shed,
+          D(PMTCONSTSTR__shed));
+
+
+    m.def("PMTCONSTSTR__channels",
+          &::gr::timing_utils::PMTCONSTSTR__channels,
+          D(PMTCONSTSTR__channels));
+
+
+    m.def("PMTCONSTSTR__edge",
+          &::gr::timing_utils::PMTCONSTSTR__edge,
+          D(PMTCONSTSTR__edge));
+
+
+    m.def("PMTCONSTSTR__edges",
+          &::gr::timing_utils::PMTCONSTSTR__edges,
+          D(PMTCONSTSTR__edges));
+
+
+    m.def("PMTCONSTSTR__stats",
+          &::gr::timing_utils::PMTCONSTSTR__stats,
+          D(PMTCONSTSTR__stats));
+
+
+    m.def("PMTCONSTSTR__count",
+          &::gr::timing_utils::PMTCONSTSTR__count,
+          D(PMTCONSTSTR__count));
+
+
+    m.def("PMTCONSTSTR__min",
+          &::gr::timing_utils::PMTCONSTSTR__min,
+          D(PMTCONSTSTR__min));
+
+
+    m.def("PMTCONSTSTR__max",
+          &::gr::timing_utils::PMTCONSTSTR__max,
+          D(PMTCONSTSTR__max));
+
+
+    m.def("PMTCONSTSTR__mean",
+          &::gr::timing_utils::PMTCONSTSTR__mean,
+          D(PMTCONSTSTR__mean));
+
+
+    m.def("PMTCONSTSTR__p50",
+          &::gr::timing_utils::PMTCONSTSTR__p50,
+          D(PMTCONSTSTR__p50));
+
+
+    m.def("PMTCONSTSTR__p90",
+          &::gr::timing_utils::PMTCONSTSTR__p90,
+          D(PMTCONSTSTR__p90));
+
+
+    m.def("PMTCONSTSTR__p99",
+          &::gr::timing_utils::PMTCONSTSTR__p99,
+          D(PMTCONSTSTR__p99));
+
+
+    m.def("PMTCONSTSTR__p999",
+          &::gr::timing_utils::PMTCONSTSTR__p999,
+          D(PMTCONSTSTR__p999));
+
+
+    m.def("PMTCONSTSTR__last",
+          &::gr::timing_utils::PMTCONSTSTR__last,
+          D(PMTCONSTSTR__last));
+
+
+    m.def("PMTCONSTSTR__trace",
+          &::gr::timing_utils::PMTCONSTSTR__trace,
+          D(PMTCONSTSTR__trace));
+
+
+    m.def("PMTCONSTSTR__diff",
+          &::gr::timing_utils::PMTCONSTSTR__diff,
+          D(PMTCONSTSTR__diff));
+
+
+    m.def("PMTCONSTSTR__offsets",
+          &::gr::timing_utils::PMTCONSTSTR__offsets,
+          D(PMTCONSTSTR__offsets));
+
+
+    m.def("PMTCONSTSTR__annotation",
+          &::gr::timing_utils::PMTCONSTSTR__annotation,
+          D(PMTCONSTSTR__annotation));
 }
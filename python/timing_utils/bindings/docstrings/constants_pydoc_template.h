@@ -79,3 +79,66 @@ static const char* __doc_gr_timing_utils_PMTCONSTSTR__START = R"doc()doc";
 
 
 static const char* __doc_gr_timing_utils_PMTCONSTSTR__END = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__gap = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__dropped = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__filled = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__shed = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__channels = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__edge = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__edges = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__stats = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__count = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__min = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__max = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__mean = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__p50 = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__p90 = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__p99 = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__p999 = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__last = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__trace = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__diff = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__offsets = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_PMTCONSTSTR__annotation = R"doc()doc";
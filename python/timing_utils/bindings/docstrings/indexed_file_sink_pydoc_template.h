@@ -0,0 +1,30 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr, timing_utils, __VA_ARGS__)
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+static const char* __doc_gr_timing_utils_indexed_file_sink = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_indexed_file_sink_indexed_file_sink_0 = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_indexed_file_sink_indexed_file_sink_1 = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_indexed_file_sink_make = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_indexed_file_sink_index_entries = R"doc()doc";
@@ -0,0 +1,33 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr, timing_utils, __VA_ARGS__)
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+static const char* __doc_gr_timing_utils_indexed_file_source = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_indexed_file_source_indexed_file_source_0 = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_indexed_file_source_indexed_file_source_1 = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_indexed_file_source_make = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_indexed_file_source_start_sample = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_indexed_file_source_end_sample = R"doc()doc";
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr, timing_utils, __VA_ARGS__)
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+static const char* __doc_gr_timing_utils_timeline_anchor_t = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_sample_timeline = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_sample_timeline_sample_timeline = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_sample_timeline_get = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_sample_timeline_publish = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_sample_timeline_reset = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_sample_timeline_version = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_sample_timeline_anchor_at = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_sample_timeline_latest = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_sample_timeline_time_at = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_sample_timeline_offset_at = R"doc()doc";
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr, timing_utils, __VA_ARGS__)
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+static const char* __doc_gr_timing_utils_simulated_radio_source = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_simulated_radio_source_simulated_radio_source_0 = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_simulated_radio_source_simulated_radio_source_1 = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_simulated_radio_source_make = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_simulated_radio_source_set_ppm = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_simulated_radio_source_set_drift = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_simulated_radio_source_set_jitter = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_simulated_radio_source_set_overflow_period = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_simulated_radio_source_overflows = R"doc()doc";
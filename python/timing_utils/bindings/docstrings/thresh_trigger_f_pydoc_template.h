@@ -36,3 +36,9 @@ static const char* __doc_gr_timing_utils_thresh_trigger_f_set_lo = R"doc()doc";
 
 
 static const char* __doc_gr_timing_utils_thresh_trigger_f_set_len = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_thresh_trigger_f_set_rate = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_thresh_trigger_f_set_cfar = R"doc()doc";
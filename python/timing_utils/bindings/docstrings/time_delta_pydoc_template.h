@@ -22,3 +22,15 @@ static const char* __doc_gr_timing_utils_time_delta_time_delta = R"doc()doc";
 
 
 static const char* __doc_gr_timing_utils_time_delta_make = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_time_delta_set_period = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_time_delta_set_reset_on_read = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_time_delta_reset_stats = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_time_delta_stats = R"doc()doc";
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr, timing_utils, __VA_ARGS__)
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+static const char* __doc_gr_timing_utils_timed_ddc = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_timed_ddc_timed_ddc_0 = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_timed_ddc_timed_ddc_1 = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_timed_ddc_make = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_timed_ddc_set_center_freq = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_timed_ddc_center_freq = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_timed_ddc_retunes = R"doc()doc";
@@ -30,3 +30,10 @@ static const char* __doc_gr_timing_utils_uhd_timed_pdu_emitter_make = R"doc()doc
 
 
 static const char* __doc_gr_timing_utils_uhd_timed_pdu_emitter_set_rate = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_uhd_timed_pdu_emitter_set_timeline = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_uhd_timed_pdu_emitter_set_trigger_delay =
+    R"doc()doc";
@@ -22,3 +22,6 @@ static const char* __doc_gr_timing_utils_wall_clock_time_wall_clock_time = R"doc
 
 
 static const char* __doc_gr_timing_utils_wall_clock_time_make = R"doc()doc";
+
+
+static const char* __doc_gr_timing_utils_wall_clock_time_set_trace = R"doc()doc";
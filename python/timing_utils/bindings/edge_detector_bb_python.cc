@@ -0,0 +1,73 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(edge_detector_bb.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(073dc42e444e4e13175455cc122976a7)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/timing_utils/edge_detector_bb.h>
+// pydoc.h is automatically generated in the build directory
+#include <edge_detector_bb_pydoc.h>
+
+void bind_edge_detector_bb(py::module& m)
+{
+
+    using edge_detector_bb = ::gr::timing_utils::edge_detector_bb;
+
+
+    py::enum_<::gr::timing_utils::edge_mode_t>(m, "edge_mode_t")
+        .value("RISING_EDGE", ::gr::timing_utils::RISING_EDGE)   // 0
+        .value("FALLING_EDGE", ::gr::timing_utils::FALLING_EDGE) // 1
+        .value("ANY_EDGE", ::gr::timing_utils::ANY_EDGE)         // 2
+        .export_values();
+
+    py::implicitly_convertible<int, ::gr::timing_utils::edge_mode_t>();
+
+
+    py::enum_<::gr::timing_utils::edge_output_t>(m, "edge_output_t")
+        .value("EDGE_STREAM", ::gr::timing_utils::EDGE_STREAM)   // 0
+        .value("EDGE_TAGS", ::gr::timing_utils::EDGE_TAGS)       // 1
+        .value("EDGE_OFFSETS", ::gr::timing_utils::EDGE_OFFSETS) // 2
+        .export_values();
+
+    py::implicitly_convertible<int, ::gr::timing_utils::edge_output_t>();
+
+
+    py::class_<edge_detector_bb,
+               gr::sync_block,
+               gr::block,
+               gr::basic_block,
+               std::shared_ptr<edge_detector_bb>>(
+        m, "edge_detector_bb", D(edge_detector_bb))
+
+        .def(py::init(&edge_detector_bb::make),
+             py::arg("mode"),
+             py::arg("output") = ::gr::timing_utils::EDGE_STREAM,
+             D(edge_detector_bb, make))
+
+
+        .def("set_mode",
+             &edge_detector_bb::set_mode,
+             py::arg("mode"),
+             D(edge_detector_bb, set_mode))
+
+        ;
+}
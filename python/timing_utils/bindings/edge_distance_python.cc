@@ -0,0 +1,59 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(edge_distance.h)                                           */
+/* BINDTOOL_HEADER_FILE_HASH(6860e64dc85d8354c9adf84ef134c3ab)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/timing_utils/edge_distance.h>
+// pydoc.h is automatically generated in the build directory
+#include <edge_distance_pydoc.h>
+
+void bind_edge_distance(py::module& m)
+{
+
+    using edge_distance = ::gr::timing_utils::edge_distance;
+
+
+    py::class_<edge_distance,
+               gr::sync_block,
+               gr::block,
+               gr::basic_block,
+               std::shared_ptr<edge_distance>>(m, "edge_distance", D(edge_distance))
+
+        .def(py::init(&edge_distance::make),
+             py::arg("samp_rate"),
+             D(edge_distance, make))
+
+
+        .def("set_rate",
+             &edge_distance::set_rate,
+             py::arg("samp_rate"),
+             D(edge_distance, set_rate))
+
+
+        .def("reset_stats", &edge_distance::reset_stats, D(edge_distance, reset_stats))
+
+
+        .def("stats", &edge_distance::stats, D(edge_distance, stats))
+
+        ;
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(event_log.h)                                               */
+/* BINDTOOL_HEADER_FILE_HASH(7bf099084b5cdb61a8a7333d6bb9c1f8)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/timing_utils/event_log.h>
+// pydoc.h is automatically generated in the build directory
+#include <event_log_pydoc.h>
+
+void bind_event_log(py::module& m)
+{
+
+    using event_log = ::gr::timing_utils::event_log;
+    using event_type_t = ::gr::timing_utils::event_type_t;
+
+
+    py::enum_<event_type_t>(m, "event_type_t")
+        .value("EVENT_TAG", ::gr::timing_utils::EVENT_TAG)
+        .value("EVENT_TRIGGER", ::gr::timing_utils::EVENT_TRIGGER)
+        .value("EVENT_INTERRUPT", ::gr::timing_utils::EVENT_INTERRUPT)
+        .value("EVENT_RETUNE", ::gr::timing_utils::EVENT_RETUNE)
+        .value("EVENT_CLOCK", ::gr::timing_utils::EVENT_CLOCK)
+        .value("EVENT_LATENCY", ::gr::timing_utils::EVENT_LATENCY)
+        .export_values();
+
+    py::implicitly_convertible<int, event_type_t>();
+
+
+    py::class_<event_log>(m, "event_log", D(event_log))
+
+        .def_static("open",
+                    &event_log::open,
+                    py::arg("directory"),
+                    py::arg("capacity") = 65536,
+                    D(event_log, open))
+
+
+        .def_static("close", &event_log::close, D(event_log, close))
+
+
+        .def_static("enabled", &event_log::enabled, D(event_log, enabled))
+
+
+        .def_static("source", &event_log::source, py::arg("name"), D(event_log, source))
+
+
+        .def_static("log",
+                    &event_log::log,
+                    py::arg("type"),
+                    py::arg("source"),
+                    py::arg("offset") = 0,
+                    py::arg("value") = 0.0,
+                    D(event_log, log))
+
+        ;
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(gap_filler.h)                                           */
+/* BINDTOOL_HEADER_FILE_HASH(cb6df3d362be39a43375dda1d3f1990d)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/timing_utils/gap_filler.h>
+// pydoc.h is automatically generated in the build directory
+#include <gap_filler_pydoc.h>
+
+template <typename T>
+void bind_gap_filler_template(py::module& m, const char* classname)
+{
+
+    using gap_filler = ::gr::timing_utils::gap_filler<T>;
+
+    py::class_<gap_filler, gr::block, gr::basic_block, std::shared_ptr<gap_filler>>(
+        m, classname)
+        .def(py::init(&gr::timing_utils::gap_filler<T>::make),
+             py::arg("rate"),
+             py::arg("fill"),
+             py::arg("max_fill"))
+        .def("set_fill", &gap_filler::set_fill, py::arg("fill"))
+        .def("set_max_fill", &gap_filler::set_max_fill, py::arg("max_fill"))
+        .def("set_rate", &gap_filler::set_rate, py::arg("rate"))
+        .def("gaps", &gap_filler::gaps)
+        .def("dropped", &gap_filler::dropped)
+        .def("filled", &gap_filler::filled);
+}
+
+
+void bind_gap_filler(py::module& m)
+{
+    bind_gap_filler_template<unsigned char>(m, "gap_filler_b");
+    bind_gap_filler_template<short>(m, "gap_filler_s");
+    bind_gap_filler_template<int32_t>(m, "gap_filler_i");
+    bind_gap_filler_template<float>(m, "gap_filler_f");
+    bind_gap_filler_template<gr_complex>(m, "gap_filler_c");
+}
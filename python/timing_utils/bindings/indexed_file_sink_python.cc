@@ -0,0 +1,58 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(indexed_file_sink.h)                                       */
+/* BINDTOOL_HEADER_FILE_HASH(5c8b25b9c242d571df1441037f1329bf)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/timing_utils/indexed_file_sink.h>
+// pydoc.h is automatically generated in the build directory
+#include <indexed_file_sink_pydoc.h>
+
+void bind_indexed_file_sink(py::module& m)
+{
+
+    using indexed_file_sink = ::gr::timing_utils::indexed_file_sink;
+
+
+    py::class_<indexed_file_sink,
+               gr::sync_block,
+               gr::block,
+               gr::basic_block,
+               std::shared_ptr<indexed_file_sink>>(
+        m, "indexed_file_sink", D(indexed_file_sink))
+
+        .def(py::init(&indexed_file_sink::make),
+             py::arg("filename"),
+             py::arg("itemsize"),
+             py::arg("samp_rate"),
+             py::arg("direct") = false,
+             py::arg("buffer_size") = 4194304,
+             py::arg("use_rx_rate") = true,
+             D(indexed_file_sink, make))
+
+
+        .def("index_entries",
+             &indexed_file_sink::index_entries,
+             D(indexed_file_sink, index_entries))
+
+        ;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(indexed_file_source.h)                                     */
+/* BINDTOOL_HEADER_FILE_HASH(2f08d23f323ceeff31fb4f3bcc2a8413)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/timing_utils/indexed_file_source.h>
+// pydoc.h is automatically generated in the build directory
+#include <indexed_file_source_pydoc.h>
+
+void bind_indexed_file_source(py::module& m)
+{
+
+    using indexed_file_source = ::gr::timing_utils::indexed_file_source;
+
+
+    py::class_<indexed_file_source,
+               gr::sync_block,
+               gr::block,
+               gr::basic_block,
+               std::shared_ptr<indexed_file_source>>(
+        m, "indexed_file_source", D(indexed_file_source))
+
+        .def(py::init(&indexed_file_source::make),
+             py::arg("filename"),
+             py::arg("itemsize"),
+             py::arg("samp_rate") = 0.0,
+             py::arg("file_time") = 0.0,
+             py::arg("seek_time") = 0.0,
+             py::arg("end_time") = 0.0,
+             py::arg("repeat") = false,
+             D(indexed_file_source, make))
+
+
+        .def("start_sample",
+             &indexed_file_source::start_sample,
+             D(indexed_file_source, start_sample))
+
+
+        .def("end_sample",
+             &indexed_file_source::end_sample,
+             D(indexed_file_source, end_sample))
+
+        ;
+}
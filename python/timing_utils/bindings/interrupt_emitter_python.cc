@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(interrupt_emitter.h)                                       */
-/* BINDTOOL_HEADER_FILE_HASH(395d15ed3e679d708aff20dc67dd2253)                     */
+/* BINDTOOL_HEADER_FILE_HASH(6bf5851b2e776e2e0fd442b523b0cd84)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -41,7 +41,9 @@ void bind_interrupt_emitter_template(py::module& m, const char* classname)
              py::arg("drop_late"),
              py::arg("loop_gain") = .0001)
         .def("set_rate", &interrupt_emitter::set_rate, py::arg("rate"))
-        .def("set_debug", &interrupt_emitter::set_debug, py::arg("value"));
+        .def("set_debug", &interrupt_emitter::set_debug, py::arg("value"))
+        .def("set_timeline", &interrupt_emitter::set_timeline, py::arg("name"))
+        .def("set_trigger_delay", &interrupt_emitter::set_trigger_delay, py::arg("delay"));
 }
 void bind_interrupt_emitter(py::module& m)
 {
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(latency_governor.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(55bec9df6fd6fca11ce44b44b730020a)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/timing_utils/latency_governor.h>
+// pydoc.h is automatically generated in the build directory
+#include <latency_governor_pydoc.h>
+
+template <typename T>
+void bind_latency_governor_template(py::module& m, const char* classname)
+{
+
+    using latency_governor = ::gr::timing_utils::latency_governor<T>;
+
+    py::class_<latency_governor,
+               gr::block,
+               gr::basic_block,
+               std::shared_ptr<latency_governor>>(m, classname)
+        .def(py::init(&gr::timing_utils::latency_governor<T>::make),
+             py::arg("rate"),
+             py::arg("max_lag"),
+             py::arg("keep_one_in"))
+        .def("set_max_lag", &latency_governor::set_max_lag, py::arg("max_lag"))
+        .def("set_keep_one_in", &latency_governor::set_keep_one_in, py::arg("keep_one_in"))
+        .def("set_rate", &latency_governor::set_rate, py::arg("rate"))
+        .def("lag", &latency_governor::lag)
+        .def("dropped", &latency_governor::dropped);
+}
+
+
+void bind_latency_governor(py::module& m)
+{
+    bind_latency_governor_template<unsigned char>(m, "latency_governor_b");
+    bind_latency_governor_template<short>(m, "latency_governor_s");
+    bind_latency_governor_template<int32_t>(m, "latency_governor_i");
+    bind_latency_governor_template<float>(m, "latency_governor_f");
+    bind_latency_governor_template<gr_complex>(m, "latency_governor_c");
+}
@@ -22,15 +22,29 @@ namespace py = pybind11;
 /**************************************/
 // BINDING_FUNCTION_PROTOTYPES(
 void bind_add_usrp_tags(py::module& m);
+void bind_burst_capture_c(py::module& m);
+void bind_coincidence_trigger_f(py::module& m);
 void bind_constants(py::module& m);
+void bind_edge_detector_bb(py::module& m);
+void bind_edge_distance(py::module& m);
+void bind_event_log(py::module& m);
+void bind_gap_filler(py::module& m);
+void bind_indexed_file_sink(py::module& m);
+void bind_indexed_file_source(py::module& m);
 void bind_interrupt_emitter(py::module& m);
+void bind_latency_governor(py::module& m);
+void bind_sample_timeline(py::module& m);
+void bind_simulated_radio_source(py::module& m);
 void bind_system_time_diff(py::module& m);
 void bind_system_time_tagger(py::module& m);
 void bind_tag_uhd_offset(py::module& m);
+void bind_thresh_trigger_c(py::module& m);
 void bind_thresh_trigger_f(py::module& m);
 void bind_time_delta(py::module& m);
+void bind_timed_ddc(py::module& m);
 void bind_timed_freq_xlating_fir(py::module& m);
 void bind_timed_tag_retuner(py::module& m);
+void bind_trace_sink(py::module& m);
 void bind_uhd_timed_pdu_emitter(py::module& m);
 void bind_wall_clock_time(py::module& m);
 // ) END BINDING_FUNCTION_PROTOTYPES
@@ -62,15 +76,29 @@ PYBIND11_MODULE(timing_utils_python, m)
     /**************************************/
     // BINDING_FUNCTION_CALLS(
     bind_add_usrp_tags(m);
+    bind_burst_capture_c(m);
+    bind_coincidence_trigger_f(m);
     bind_constants(m);
+    bind_edge_detector_bb(m);
+    bind_edge_distance(m);
+    bind_event_log(m);
+    bind_gap_filler(m);
+    bind_indexed_file_sink(m);
+    bind_indexed_file_source(m);
     bind_interrupt_emitter(m);
+    bind_latency_governor(m);
+    bind_sample_timeline(m);
+    bind_simulated_radio_source(m);
     bind_system_time_diff(m);
     bind_system_time_tagger(m);
     bind_tag_uhd_offset(m);
+    bind_thresh_trigger_c(m);
     bind_thresh_trigger_f(m);
     bind_time_delta(m);
+    bind_timed_ddc(m);
     bind_timed_freq_xlating_fir(m);
     bind_timed_tag_retuner(m);
+    bind_trace_sink(m);
     bind_uhd_timed_pdu_emitter(m);
     bind_wall_clock_time(m);
 
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(sample_timeline.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(d3ba7da16fdc4271cf7b124e9c01f246)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/timing_utils/sample_timeline.h>
+// pydoc.h is automatically generated in the build directory
+#include <sample_timeline_pydoc.h>
+
+void bind_sample_timeline(py::module& m)
+{
+
+    using sample_timeline = ::gr::timing_utils::sample_timeline;
+    using timeline_anchor_t = ::gr::timing_utils::timeline_anchor_t;
+
+
+    py::class_<timeline_anchor_t>(m, "timeline_anchor_t", D(timeline_anchor_t))
+        .def(py::init<>())
+        .def_readwrite("offset", &timeline_anchor_t::offset)
+        .def_readwrite("secs", &timeline_anchor_t::secs)
+        .def_readwrite("frac", &timeline_anchor_t::frac)
+        .def_readwrite("rate", &timeline_anchor_t::rate);
+
+
+    py::class_<sample_timeline, std::shared_ptr<sample_timeline>>(
+        m, "sample_timeline", D(sample_timeline))
+
+        .def_readonly_static("NUM_ANCHORS", &sample_timeline::NUM_ANCHORS)
+
+        .def_static("get", &sample_timeline::get, py::arg("name"), D(sample_timeline, get))
+
+
+        .def("publish",
+             &sample_timeline::publish,
+             py::arg("offset"),
+             py::arg("secs"),
+             py::arg("frac"),
+             py::arg("rate"),
+             D(sample_timeline, publish))
+
+
+        .def("reset", &sample_timeline::reset, D(sample_timeline, reset))
+
+
+        .def("version", &sample_timeline::version, D(sample_timeline, version))
+
+
+        // the query methods return None rather than a status flag in python
+        .def(
+            "anchor_at",
+            [](const sample_timeline& self, uint64_t offset) -> py::object {
+                timeline_anchor_t anchor;
+                if (!self.anchor_at(offset, anchor)) {
+                    return py::none();
+                }
+                return py::cast(anchor);
+            },
+            py::arg("offset"),
+            D(sample_timeline, anchor_at))
+
+
+        .def(
+            "latest",
+            [](const sample_timeline& self) -> py::object {
+                timeline_anchor_t anchor;
+                if (!self.latest(anchor)) {
+                    return py::none();
+                }
+                return py::cast(anchor);
+            },
+            D(sample_timeline, latest))
+
+
+        .def(
+            "time_at",
+            [](const sample_timeline& self, uint64_t offset) -> py::object {
+                uint64_t secs;
+                double frac;
+                if (!self.time_at(offset, secs, frac)) {
+                    return py::none();
+                }
+                return py::make_tuple(secs, frac);
+            },
+            py::arg("offset"),
+            D(sample_timeline, time_at))
+
+
+        .def(
+            "offset_at",
+            [](const sample_timeline& self, uint64_t secs, double frac) -> py::object {
+                uint64_t offset;
+                if (!self.offset_at(secs, frac, offset)) {
+                    return py::none();
+                }
+                return py::cast(offset);
+            },
+            py::arg("secs"),
+            py::arg("frac"),
+            D(sample_timeline, offset_at))
+
+        ;
+}
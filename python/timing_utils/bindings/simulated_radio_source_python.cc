@@ -0,0 +1,86 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(simulated_radio_source.h)                                  */
+/* BINDTOOL_HEADER_FILE_HASH(7a80030c60f18fc595016e890ad8cffc)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/timing_utils/simulated_radio_source.h>
+// pydoc.h is automatically generated in the build directory
+#include <simulated_radio_source_pydoc.h>
+
+void bind_simulated_radio_source(py::module& m)
+{
+
+    using simulated_radio_source = ::gr::timing_utils::simulated_radio_source;
+
+
+    py::class_<simulated_radio_source,
+               gr::sync_block,
+               gr::block,
+               gr::basic_block,
+               std::shared_ptr<simulated_radio_source>>(
+        m, "simulated_radio_source", D(simulated_radio_source))
+
+        .def(py::init(&simulated_radio_source::make),
+             py::arg("samp_rate"),
+             py::arg("freq") = 0.0,
+             py::arg("tone_freq") = 0.0,
+             py::arg("ppm") = 0.0,
+             py::arg("drift") = 0.0,
+             py::arg("jitter") = 0.0,
+             py::arg("overflow_period") = 0.0,
+             py::arg("overflow_samples") = 0,
+             py::arg("burst_size") = 0,
+             py::arg("realtime") = true,
+             D(simulated_radio_source, make))
+
+
+        .def("set_ppm",
+             &simulated_radio_source::set_ppm,
+             py::arg("ppm"),
+             D(simulated_radio_source, set_ppm))
+
+
+        .def("set_drift",
+             &simulated_radio_source::set_drift,
+             py::arg("drift"),
+             D(simulated_radio_source, set_drift))
+
+
+        .def("set_jitter",
+             &simulated_radio_source::set_jitter,
+             py::arg("jitter"),
+             D(simulated_radio_source, set_jitter))
+
+
+        .def("set_overflow_period",
+             &simulated_radio_source::set_overflow_period,
+             py::arg("overflow_period"),
+             D(simulated_radio_source, set_overflow_period))
+
+
+        .def("overflows",
+             &simulated_radio_source::overflows,
+             D(simulated_radio_source, overflows))
+
+        ;
+}
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(system_time_diff.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(72ca0abf1acbbd1ed465f234d73213e5)                     */
+/* BINDTOOL_HEADER_FILE_HASH(49abf5af3a11d6db755579d5a7af63da)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
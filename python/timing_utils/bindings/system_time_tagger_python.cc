@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(system_time_tagger.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(6b08a248bf5f26596791f6be2f197a89)                     */
+/* BINDTOOL_HEADER_FILE_HASH(b3321570464fdab129647e3ce2b66450)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -40,8 +40,10 @@ void bind_system_time_tagger_template(py::module& m, const char* classname)
                gr::basic_block,
                std::shared_ptr<system_time_tagger>>(m, classname)
         .def(py::init(&gr::timing_utils::system_time_tagger<T>::make),
-             py::arg("tag_interval"))
-        .def("set_interval", &system_time_tagger::set_interval, py::arg("tag_interval"));
+             py::arg("tag_interval"),
+             py::arg("trace") = false)
+        .def("set_interval", &system_time_tagger::set_interval, py::arg("tag_interval"))
+        .def("set_trace", &system_time_tagger::set_trace, py::arg("trace"));
 }
 
 void bind_system_time_tagger(py::module& m)
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(tag_uhd_offset.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(cd416e758f5b52b49b616608798a1423)                     */
+/* BINDTOOL_HEADER_FILE_HASH(bf91fe2d470d79490bcf760cae5eaed2)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -44,7 +44,8 @@ void bind_tag_uhd_offset_template(py::module& m, const char* classname)
              py::arg("tag_interval"))
         .def("set_rate", &tag_uhd_offset::set_rate, py::arg("rate"))
         .def("set_interval", &tag_uhd_offset::set_interval, py::arg("tag_interval"))
-        .def("set_key", &tag_uhd_offset::set_key, py::arg("tag_key"));
+        .def("set_key", &tag_uhd_offset::set_key, py::arg("tag_key"))
+        .def("set_timeline", &tag_uhd_offset::set_timeline, py::arg("name"));
 }
 
 void bind_tag_uhd_offset(py::module& m)
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(thresh_trigger_c.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(339ef189569aa63fca4a9b851ba31516)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/timing_utils/thresh_trigger_c.h>
+// pydoc.h is automatically generated in the build directory
+#include <thresh_trigger_c_pydoc.h>
+
+void bind_thresh_trigger_c(py::module& m)
+{
+
+    using thresh_trigger_c = ::gr::timing_utils::thresh_trigger_c;
+
+
+    py::class_<thresh_trigger_c,
+               gr::sync_block,
+               gr::block,
+               gr::basic_block,
+               std::shared_ptr<thresh_trigger_c>>(
+        m, "thresh_trigger_c", D(thresh_trigger_c))
+
+        .def(py::init(&thresh_trigger_c::make),
+             py::arg("hi"),
+             py::arg("lo"),
+             py::arg("length"),
+             D(thresh_trigger_c, make))
+
+
+        .def("set_hi",
+             &thresh_trigger_c::set_hi,
+             py::arg("t"),
+             D(thresh_trigger_c, set_hi))
+
+
+        .def("set_lo",
+             &thresh_trigger_c::set_lo,
+             py::arg("t"),
+             D(thresh_trigger_c, set_lo))
+
+
+        .def("set_len",
+             &thresh_trigger_c::set_len,
+             py::arg("len"),
+             D(thresh_trigger_c, set_len))
+
+
+        .def("set_rate",
+             &thresh_trigger_c::set_rate,
+             py::arg("rate"),
+             D(thresh_trigger_c, set_rate))
+
+
+        .def("set_cfar",
+             &thresh_trigger_c::set_cfar,
+             py::arg("window"),
+             D(thresh_trigger_c, set_cfar))
+
+        ;
+}
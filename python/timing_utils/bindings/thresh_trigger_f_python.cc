@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(thresh_trigger_f.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(678104fabe3cd5f372a7b80ffd58e443)                     */
+/* BINDTOOL_HEADER_FILE_HASH(781ea61051e5dd82a2335b98c4e7ff98)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -64,5 +64,17 @@ void bind_thresh_trigger_f(py::module& m)
              py::arg("len"),
              D(thresh_trigger_f, set_len))
 
+
+        .def("set_rate",
+             &thresh_trigger_f::set_rate,
+             py::arg("rate"),
+             D(thresh_trigger_f, set_rate))
+
+
+        .def("set_cfar",
+             &thresh_trigger_f::set_cfar,
+             py::arg("window"),
+             D(thresh_trigger_f, set_cfar))
+
         ;
 }
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(time_delta.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(62882902b4a390c99890d3643473e19d)                     */
+/* BINDTOOL_HEADER_FILE_HASH(b0223065ced87492e3c15bc9a7a67ccf)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -39,8 +39,27 @@ void bind_time_delta(py::module& m)
         .def(py::init(&time_delta::make),
              py::arg("delta_key"),
              py::arg("time_key"),
+             py::arg("period") = 0.0,
+             py::arg("reset_on_read") = false,
              D(time_delta, make))
 
 
+        .def("set_period",
+             &time_delta::set_period,
+             py::arg("period"),
+             D(time_delta, set_period))
+
+
+        .def("set_reset_on_read",
+             &time_delta::set_reset_on_read,
+             py::arg("reset_on_read"),
+             D(time_delta, set_reset_on_read))
+
+
+        .def("reset_stats", &time_delta::reset_stats, D(time_delta, reset_stats))
+
+
+        .def("stats", &time_delta::stats, D(time_delta, stats))
+
         ;
 }
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(timed_ddc.h)                                               */
+/* BINDTOOL_HEADER_FILE_HASH(a10c523e3f8c12fbdac5c1901eff6efb)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/timing_utils/timed_ddc.h>
+// pydoc.h is automatically generated in the build directory
+#include <timed_ddc_pydoc.h>
+
+void bind_timed_ddc(py::module& m)
+{
+
+    using timed_ddc = ::gr::timing_utils::timed_ddc;
+
+
+    py::class_<timed_ddc,
+               gr::sync_decimator,
+               gr::sync_block,
+               gr::block,
+               gr::basic_block,
+               std::shared_ptr<timed_ddc>>(m, "timed_ddc", D(timed_ddc))
+
+        .def(py::init(&timed_ddc::make),
+             py::arg("decimation"),
+             py::arg("taps"),
+             py::arg("center_freq"),
+             py::arg("sample_rate"),
+             py::arg("dict_key"),
+             py::arg("origin_t_secs") = 0,
+             py::arg("origin_t_frac") = 0.0,
+             D(timed_ddc, make))
+
+
+        .def("set_center_freq",
+             &timed_ddc::set_center_freq,
+             py::arg("center_freq"),
+             D(timed_ddc, set_center_freq))
+
+
+        .def("center_freq", &timed_ddc::center_freq, D(timed_ddc, center_freq))
+
+
+        .def("retunes", &timed_ddc::retunes, D(timed_ddc, retunes))
+
+        ;
+}
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(timed_freq_xlating_fir.h)                                  */
-/* BINDTOOL_HEADER_FILE_HASH(e141d6642659c492bf7e25d95db0b67b)                     */
+/* BINDTOOL_HEADER_FILE_HASH(7981a6b530f73be16adeef079238e425)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -41,9 +41,11 @@ void bind_timed_freq_xlating_fir_template(py::module& m, const char* classname)
              py::arg("taps"),
              py::arg("center_freq"),
              py::arg("sampling_freq"),
-             py::arg("tag_key") = "set_freq")
+             py::arg("tag_key") = "set_freq",
+             py::arg("cic_decimation") = 1)
         .def("set_decim", &timed_freq_xlating_fir::set_decim, py::arg("decimation"))
         .def("decim", &timed_freq_xlating_fir::decim)
+        .def("cic_decim", &timed_freq_xlating_fir::cic_decim)
         .def("set_rate", &timed_freq_xlating_fir::set_rate, py::arg("rate"))
         .def("rate", &timed_freq_xlating_fir::rate)
         .def("set_center_freq",
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(trace_sink.h)                                              */
+/* BINDTOOL_HEADER_FILE_HASH(f046c81ca3f02ceec948ad2fc53ca8a4)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/timing_utils/trace_sink.h>
+// pydoc.h is automatically generated in the build directory
+#include <trace_sink_pydoc.h>
+
+void bind_trace_sink(py::module& m)
+{
+
+    using trace_sink = ::gr::timing_utils::trace_sink;
+
+
+    py::class_<trace_sink,
+               gr::sync_block,
+               gr::block,
+               gr::basic_block,
+               std::shared_ptr<trace_sink>>(m, "trace_sink", D(trace_sink))
+
+        .def(py::init(&trace_sink::make),
+             py::arg("filename"),
+             py::arg("itemsize"),
+             D(trace_sink, make))
+
+
+        .def("records", &trace_sink::records, D(trace_sink, records))
+
+        ;
+}
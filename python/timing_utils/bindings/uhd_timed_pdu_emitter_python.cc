@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(uhd_timed_pdu_emitter.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(6832c33ed8fd897ba75bbd641ca6e7af)                     */
+/* BINDTOOL_HEADER_FILE_HASH(01009b2940a98d7a7929aee8768f5b60)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -51,5 +51,17 @@ void bind_uhd_timed_pdu_emitter(py::module& m)
              py::arg("rate"),
              D(uhd_timed_pdu_emitter, set_rate))
 
+
+        .def("set_timeline",
+             &uhd_timed_pdu_emitter::set_timeline,
+             py::arg("name"),
+             D(uhd_timed_pdu_emitter, set_timeline))
+
+
+        .def("set_trigger_delay",
+             &uhd_timed_pdu_emitter::set_trigger_delay,
+             py::arg("delay"),
+             D(uhd_timed_pdu_emitter, set_trigger_delay))
+
         ;
 }
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(wall_clock_time.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(79757c0b3f86d1dc672201cf09d85d74)                     */
+/* BINDTOOL_HEADER_FILE_HASH(2cbd495881985bffae08baca15f254e9)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -38,8 +38,16 @@ void bind_wall_clock_time(py::module& m)
                gr::basic_block,
                std::shared_ptr<wall_clock_time>>(m, "wall_clock_time", D(wall_clock_time))
 
-        .def(py::init(&wall_clock_time::make), py::arg("key"), D(wall_clock_time, make))
+        .def(py::init(&wall_clock_time::make),
+             py::arg("key"),
+             py::arg("trace") = false,
+             D(wall_clock_time, make))
 
 
+        .def("set_trace",
+             &wall_clock_time::set_trace,
+             py::arg("trace"),
+             D(wall_clock_time, set_trace))
+
         ;
 }
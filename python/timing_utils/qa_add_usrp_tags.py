@@ -11,7 +11,10 @@
 from builtins import range
 from gnuradio import gr, gr_unittest
 from gnuradio import blocks
+import json
+import os
 import pmt
+import tempfile
 import time
 try:
     from gnuradio import timing_utils
@@ -77,6 +80,66 @@ class qa_add_usrp_tags (gr_unittest.TestCase):
         time.sleep(.1)
         self.tb.stop()
 
+    def test_003_sigmf(self):
+        meta = {"global": {"core:datatype": "cf32_le", "core:sample_rate": 1e6, "core:version": "1.0.0"},
+                "captures": [{"core:sample_start": 0, "core:frequency": 2.4e9,
+                              "core:datetime": "2021-06-01T12:00:00.25Z"},
+                             {"core:sample_start": 1500, "core:frequency": 2.5e9}],
+                "annotations": [{"core:sample_start": 10, "core:sample_count": 100, "core:label": "burst"}]}
+        (fd, filename) = tempfile.mkstemp(suffix=".sigmf-meta")
+        with os.fdopen(fd, "w") as f:
+            json.dump(meta, f)
+
+        self.src = blocks.vector_source_c(list(range(3000)), False, 1, [])
+        self.utag = timing_utils.add_usrp_tags_c(1090e6, 250000, 0, 0)
+        self.utag.set_sigmf(filename)
+        self.snk = blocks.vector_sink_c()
+        self.tb.connect(self.src, self.utag, self.snk)
+        self.tb.run()
+        os.remove(filename)
+
+        tags = {}
+        for t in self.snk.tags():
+            tags[(t.offset, pmt.symbol_to_string(t.key))] = t.value
+        self.assertEqual(sorted(tags.keys()), [(0, 'rx_freq'), (0, 'rx_rate'), (0, 'rx_time'), (10, 'annotation'),
+                                               (1500, 'rx_freq'), (1500, 'rx_rate'), (1500, 'rx_time')])
+        self.assertAlmostEqual(pmt.to_double(tags[(0, 'rx_freq')]), 2.4e9)
+        self.assertAlmostEqual(pmt.to_double(tags[(1500, 'rx_freq')]), 2.5e9)
+        self.assertAlmostEqual(pmt.to_double(tags[(0, 'rx_rate')]), 1e6)
+        self.assertEqual(pmt.to_uint64(pmt.tuple_ref(tags[(0, 'rx_time')], 0)), 1622548800)
+        self.assertAlmostEqual(pmt.to_double(pmt.tuple_ref(tags[(0, 'rx_time')], 1)), 0.25)
+
+        # the second capture has no datetime, so its time follows from the first
+        self.assertAlmostEqual(pmt.to_double(pmt.tuple_ref(tags[(1500, 'rx_time')], 1)), 0.2515)
+        annotation = tags[(10, 'annotation')]
+        self.assertEqual(pmt.to_long(pmt.dict_ref(annotation, pmt.intern("core:sample_count"), pmt.PMT_NIL)), 100)
+        self.assertEqual(pmt.symbol_to_string(pmt.dict_ref(annotation, pmt.intern("core:label"), pmt.PMT_NIL)), "burst")
+
+    def test_004_sigmf_bad_datetime(self):
+        # a malformed datetime is extrapolated from the previous capture, as
+        # are the captures after it
+        meta = {"global": {"core:datatype": "cf32_le", "core:sample_rate": 1e6, "core:version": "1.0.0"},
+                "captures": [{"core:sample_start": 0, "core:datetime": "2021-06-01T12:00:00.25Z"},
+                             {"core:sample_start": 1500, "core:datetime": "2021-13-45T99:00:00.75Z"},
+                             {"core:sample_start": 2500}]}
+        (fd, filename) = tempfile.mkstemp(suffix=".sigmf-meta")
+        with os.fdopen(fd, "w") as f:
+            json.dump(meta, f)
+
+        self.src = blocks.vector_source_c(list(range(3000)), False, 1, [])
+        self.utag = timing_utils.add_usrp_tags_c(1090e6, 250000, 0, 0)
+        self.utag.set_sigmf(filename)
+        self.snk = blocks.vector_sink_c()
+        self.tb.connect(self.src, self.utag, self.snk)
+        self.tb.run()
+        os.remove(filename)
+
+        times = [(t.offset, pmt.to_uint64(pmt.tuple_ref(t.value, 0)), pmt.to_double(pmt.tuple_ref(t.value, 1)))
+                 for t in self.snk.tags() if pmt.eq(t.key, pmt.intern("rx_time"))]
+        self.assertEqual([(offset, secs) for (offset, secs, frac) in times],
+                         [(0, 1622548800), (1500, 1622548800), (2500, 1622548800)])
+        self.assertFloatTuplesAlmostEqual([frac for (offset, secs, frac) in times], [0.25, 0.2515, 0.2525])
+
 
 if __name__ == '__main__':
     gr_unittest.run(qa_add_usrp_tags)
@@ -0,0 +1,82 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018-2021 National Technology & Engineering Solutions of Sandia, LLC
+# (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government
+# retains certain rights in this software.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+try:
+    from gnuradio import timing_utils
+except ImportError:
+    import os
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio import timing_utils
+
+
+class qa_burst_capture_c (gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def run_capture(self, data, pre, post, tags=[]):
+        src = blocks.vector_source_c(data, False, 1, tags)
+        cap = timing_utils.burst_capture_c(0.5, 0.2, 10, pre, post)
+        dbg = blocks.message_debug()
+        self.tb.connect(src, cap)
+        self.tb.msg_connect((cap, 'pdu_out'), (dbg, 'store'))
+        self.tb.run()
+        return dbg
+
+    def test_001_capture(self):
+        # a ramp makes every sample identifiable, bursts are marked by magnitude
+        data = [complex(0, 0.001 * (ii % 100)) for ii in range(100000)]
+        for start in [20000, 60000]:
+            data[start:start + 50] = [complex(1.0, 0.0)] * 50
+        time_tag = gr.tag_t()
+        time_tag.offset = 0
+        time_tag.key = pmt.intern("rx_time")
+        time_tag.value = pmt.make_tuple(pmt.from_uint64(100), pmt.from_double(0.0))
+        rate_tag = gr.tag_t()
+        rate_tag.offset = 0
+        rate_tag.key = pmt.intern("rx_rate")
+        rate_tag.value = pmt.from_double(10000.0)
+        dbg = self.run_capture(data, 1000, 2000, [time_tag, rate_tag])
+
+        self.assertEqual(dbg.num_messages(), 2)
+        for ii, start in enumerate([20000, 60000]):
+            pdu = dbg.get_message(ii)
+            meta = pmt.car(pdu)
+            trigger_sample = start + 9
+            self.assertEqual(pmt.to_uint64(pmt.dict_ref(meta, pmt.intern("trigger_sample"), pmt.PMT_NIL)), trigger_sample)
+            self.assertEqual(pmt.to_uint64(pmt.dict_ref(meta, pmt.intern("rx_sample"), pmt.PMT_NIL)), trigger_sample - 1000)
+            rx_time = pmt.dict_ref(meta, pmt.intern("rx_time"), pmt.PMT_NIL)
+            self.assertAlmostEqual(pmt.to_uint64(pmt.tuple_ref(rx_time, 0)) + pmt.to_double(pmt.tuple_ref(rx_time, 1)),
+                                   100 + (trigger_sample - 1000) / 10000.0)
+            self.assertComplexTuplesAlmostEqual(pmt.c32vector_elements(pmt.cdr(pdu)),
+                                                data[trigger_sample - 1000:trigger_sample + 2000])
+
+    def test_002_stream_start(self):
+        # a capture near the start of the stream is shortened, one that does
+        # not complete before the end of the stream is not published
+        data = [complex(1.0, 0.0)] * 20 + [0j] * 1000 + [complex(1.0, 0.0)] * 20 + [0j] * 10
+        dbg = self.run_capture(data, 100, 50)
+        self.assertEqual(dbg.num_messages(), 1)
+        pdu = dbg.get_message(0)
+        self.assertEqual(pmt.to_uint64(pmt.dict_ref(pmt.car(pdu), pmt.intern("rx_sample"), pmt.PMT_NIL)), 0)
+        self.assertFalse(pmt.dict_has_key(pmt.car(pdu), pmt.intern("rx_time")))
+        self.assertEqual(pmt.length(pmt.cdr(pdu)), 59)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_burst_capture_c)
@@ -0,0 +1,71 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018-2021 National Technology & Engineering Solutions of Sandia, LLC
+# (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government
+# retains certain rights in this software.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+try:
+    from gnuradio import timing_utils
+except ImportError:
+    import os
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio import timing_utils
+
+
+class qa_coincidence_trigger_f (gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def test_001_k_of_n(self):
+        # pulses start on each channel at these samples
+        pulses = [[1000, 20000, 40000],
+                  [1005, 30000, 40100],
+                  [1003, 20050],
+                  [50000]]
+        n = 60000
+        time_tag = gr.tag_t()
+        time_tag.offset = 0
+        time_tag.key = pmt.intern("rx_time")
+        time_tag.value = pmt.make_tuple(pmt.from_uint64(10), pmt.from_double(0.0))
+        rate_tag = gr.tag_t()
+        rate_tag.offset = 0
+        rate_tag.key = pmt.intern("rx_rate")
+        rate_tag.value = pmt.from_double(1000.0)
+
+        trig = timing_utils.coincidence_trigger_f(4, 0.5, 0.2, 1, 2, 10)
+        dbg = blocks.message_debug()
+        for chan, starts in enumerate(pulses):
+            data = [0.0] * n
+            for start in starts:
+                data[start:start + 20] = [1.0] * 20
+            tags = [time_tag, rate_tag] if chan == 0 else []
+            self.tb.connect(blocks.vector_source_f(data, False, 1, tags), (trig, chan))
+        self.tb.msg_connect((trig, 'trig'), (dbg, 'store'))
+        self.tb.run()
+
+        # channels 0 and 2 coincide at 1003, channel 1 then needs a new
+        # partner, 20000/20050 and 40000/40100 are too far apart
+        self.assertEqual(dbg.num_messages(), 1)
+        info = pmt.cdr(dbg.get_message(0))
+        self.assertEqual(pmt.to_uint64(pmt.dict_ref(info, pmt.intern("trigger_sample"), pmt.PMT_NIL)), 1003)
+        self.assertEqual(pmt.to_uint64(pmt.dict_ref(info, pmt.intern("channels"), pmt.PMT_NIL)), 0b0101)
+        trigger_time = pmt.dict_ref(info, pmt.intern("trigger_time"), pmt.PMT_NIL)
+        self.assertEqual(pmt.to_uint64(pmt.car(trigger_time)), 11)
+        self.assertAlmostEqual(pmt.to_double(pmt.cdr(trigger_time)), 0.003)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_coincidence_trigger_f)
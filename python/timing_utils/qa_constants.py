@@ -55,6 +55,27 @@ class qa_constants (gr_unittest.TestCase):
         assert(pmt.eq(timing_utils.PMTCONSTSTR__dsp_freq(), pmt.intern('dsp_freq')))
         assert(pmt.eq(timing_utils.PMTCONSTSTR__START(), pmt.intern('START')))
         assert(pmt.eq(timing_utils.PMTCONSTSTR__END(), pmt.intern('END')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__gap(), pmt.intern('gap')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__dropped(), pmt.intern('dropped')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__filled(), pmt.intern('filled')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__shed(), pmt.intern('shed')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__channels(), pmt.intern('channels')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__edge(), pmt.intern('edge')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__edges(), pmt.intern('edges')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__stats(), pmt.intern('stats')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__count(), pmt.intern('count')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__min(), pmt.intern('min')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__max(), pmt.intern('max')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__mean(), pmt.intern('mean')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__p50(), pmt.intern('p50')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__p90(), pmt.intern('p90')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__p99(), pmt.intern('p99')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__p999(), pmt.intern('p999')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__last(), pmt.intern('last')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__trace(), pmt.intern('trace')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__diff(), pmt.intern('diff')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__offsets(), pmt.intern('offsets')))
+        assert(pmt.eq(timing_utils.PMTCONSTSTR__annotation(), pmt.intern('annotation')))
 
 
 if __name__ == '__main__':
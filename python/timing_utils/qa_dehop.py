@@ -0,0 +1,116 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018-2021 National Technology & Engineering Solutions of Sandia, LLC
+# (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government
+# retains certain rights in this software.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+from gnuradio import filter
+import cmath
+import math
+import os
+import pmt
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+try:
+    from gnuradio import timing_utils
+except ImportError:
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio import timing_utils
+
+# the tool from the build tree if given, otherwise the installed one
+DEHOP = "timing_utils_dehop"
+
+
+class qa_dehop (gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+        self.dir = tempfile.mkdtemp()
+
+    def tearDown(self):
+        self.tb = None
+        shutil.rmtree(self.dir)
+
+    def test_001_hop(self):
+        ''' Dehop a recording with one hop and compare with timed_freq_xlating_fir '''
+        rate = 100000.0
+        decimation = 10
+        nsamps = 50000
+        hop = 20000
+        freqs = [10000.0, -20000.0]
+        offset = 500.0
+
+        # a tone offset from each center frequency in turn
+        data = []
+        phase = 0.0
+        for ind in range(nsamps):
+            data.append(cmath.exp(1j * phase))
+            phase += 2 * math.pi * (freqs[ind >= hop] + offset) / rate
+
+        recording = os.path.join(self.dir, "rec.bin")
+        with open(recording, "wb") as f:
+            f.write(struct.pack("<%df" % (2 * nsamps),
+                                *[v for x in data for v in (x.real, x.imag)]))
+        schedule = os.path.join(self.dir, "hops.csv")
+        with open(schedule, "w") as f:
+            f.write("# time,freq\n1000.2,%f\n" % freqs[1])
+        output = os.path.join(self.dir, "out.bin")
+
+        # small chunks on several threads, starting at 1000 s so the hop is
+        # at sample 20000
+        subprocess.check_call([DEHOP, "-d", str(decimation), "-r", str(rate),
+                               "-t", "1000", "-f", str(freqs[0]), "-j", "3",
+                               "-c", "4096", recording, schedule, output])
+        with open(output, "rb") as f:
+            raw = f.read()
+        values = struct.unpack("<%df" % (len(raw) // 4), raw)
+        dehopped = [complex(values[ii], values[ii + 1]) for ii in range(0, len(values), 2)]
+
+        # the same with the block, retuned by a tag on the hop sample
+        bandwidth = 0.4 * rate / decimation
+        taps = filter.firdes.low_pass_2(1, rate, bandwidth, bandwidth, 60)
+        tag = gr.tag_t()
+        tag.offset = hop
+        tag.key = pmt.intern("freq")
+        tag.value = pmt.from_double(freqs[1])
+        src = blocks.vector_source_c(data, False, 1, [tag])
+        xlat = timing_utils.timed_freq_xlating_fir_ccf(
+            decimation, taps, freqs[0], rate, "freq")
+        snk = blocks.vector_sink_c()
+        self.tb.connect(src, xlat, snk)
+        self.tb.run()
+        expected = snk.data()
+
+        self.assertEqual(len(dehopped), nsamps // decimation)
+        self.assertEqual(len(expected), nsamps // decimation)
+
+        # identical before the hop
+        start = (hop + decimation - 1) // decimation
+        self.assertComplexTuplesAlmostEqual(dehopped[:start], expected[:start], 2)
+
+        # the block retunes a filter delay later, so once both have settled
+        # the outputs only differ by the phase each retuned at
+        after = list(range(start + 2 * len(taps) // decimation + 2, nsamps // decimation))
+        rotation = dehopped[after[0]] / expected[after[0]]
+        self.assertAlmostEqual(abs(rotation), 1.0, 2)
+        self.assertComplexTuplesAlmostEqual([dehopped[k] for k in after],
+                                            [expected[k] * rotation for k in after], 2)
+
+        # and the tone lands where it should
+        self.assertAlmostEqual(abs(dehopped[-1]), 1.0, 2)
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1:
+        DEHOP = sys.argv.pop(1)
+    gr_unittest.run(qa_dehop)
@@ -0,0 +1,78 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018-2021 National Technology & Engineering Solutions of Sandia, LLC
+# (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government
+# retains certain rights in this software.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+try:
+    from gnuradio import timing_utils
+except ImportError:
+    import os
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio import timing_utils
+
+
+class qa_edge_detector_bb (gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+        # rising edges at 3 and 9, falling edges at 6 and 10
+        self.data = [0, 0, 0, 1, 1, 1, 0, 0, 0, 1, 0, 0]
+
+    def tearDown(self):
+        self.tb = None
+
+    def run_stream(self, mode):
+        src = blocks.vector_source_b(self.data, False)
+        edge = timing_utils.edge_detector_bb(mode)
+        snk = blocks.vector_sink_b()
+        self.tb.connect(src, edge, snk)
+        self.tb.run()
+        return [ii for ii, v in enumerate(snk.data()) if v]
+
+    def test_001_stream(self):
+        self.assertEqual(self.run_stream(timing_utils.RISING_EDGE), [3, 9])
+        self.tb = gr.top_block()
+        self.assertEqual(self.run_stream(timing_utils.FALLING_EDGE), [6, 10])
+        self.tb = gr.top_block()
+        self.assertEqual(self.run_stream(timing_utils.ANY_EDGE), [3, 6, 9, 10])
+
+    def test_002_tags(self):
+        src = blocks.vector_source_b(self.data, False)
+        edge = timing_utils.edge_detector_bb(timing_utils.ANY_EDGE, timing_utils.EDGE_TAGS)
+        snk = blocks.vector_sink_b()
+        self.tb.connect(src, edge, snk)
+        self.tb.run()
+
+        self.assertEqual(list(snk.data()), self.data)
+        tags = [t for t in snk.tags() if pmt.eq(t.key, pmt.intern("edge"))]
+        self.assertEqual([t.offset for t in tags], [3, 6, 9, 10])
+        self.assertEqual([pmt.to_bool(t.value) for t in tags], [True, False, True, False])
+
+    def test_003_offsets(self):
+        # a long stream, the offsets are absolute across buffers
+        data = ([0] * 999 + [1]) * 100
+        src = blocks.vector_source_b(data, False)
+        edge = timing_utils.edge_detector_bb(timing_utils.RISING_EDGE, timing_utils.EDGE_OFFSETS)
+        dbg = blocks.message_debug()
+        self.tb.connect(src, edge)
+        self.tb.msg_connect((edge, 'edges'), (dbg, 'store'))
+        self.tb.run()
+
+        offsets = []
+        for ii in range(dbg.num_messages()):
+            offsets += list(pmt.u64vector_elements(dbg.get_message(ii)))
+        self.assertEqual(offsets, [1000 * ii + 999 for ii in range(100)])
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_edge_detector_bb)
@@ -0,0 +1,68 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018-2021 National Technology & Engineering Solutions of Sandia, LLC
+# (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government
+# retains certain rights in this software.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+try:
+    from gnuradio import timing_utils
+except ImportError:
+    import os
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio import timing_utils
+
+
+class qa_edge_distance (gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def make_tag(self, offset, key):
+        tag = gr.tag_t()
+        tag.offset = offset
+        tag.key = pmt.intern(key)
+        tag.value = pmt.PMT_T
+        return tag
+
+    def test_001_stats(self):
+        # 1 kHz, START/END pairs 10, 20, 30, ... 100 ms apart; unpaired END
+        # tags and other keys are ignored
+        tags = [self.make_tag(5, "END"), self.make_tag(7, "rx_time")]
+        for ii in range(10):
+            start = 1000 * (ii + 1)
+            tags += [self.make_tag(start, "START"), self.make_tag(start + 10 * (ii + 1), "END")]
+        src = blocks.vector_source_f([0.0] * 20000, False, 1, tags)
+        dist = timing_utils.edge_distance(1000.0)
+        dbg = blocks.message_debug()
+        self.tb.connect(src, dist)
+        self.tb.msg_connect((dist, 'stats'), (dbg, 'store'))
+        self.tb.run()
+
+        self.assertGreater(dbg.num_messages(), 0)
+        stats = dbg.get_message(dbg.num_messages() - 1)
+        self.assertTrue(pmt.equal(stats, dist.stats()))
+        self.assertEqual(pmt.to_uint64(pmt.dict_ref(stats, pmt.intern("count"), pmt.PMT_NIL)), 10)
+        self.assertAlmostEqual(pmt.to_double(pmt.dict_ref(stats, pmt.intern("min"), pmt.PMT_NIL)), 10.0)
+        self.assertAlmostEqual(pmt.to_double(pmt.dict_ref(stats, pmt.intern("max"), pmt.PMT_NIL)), 100.0)
+        self.assertAlmostEqual(pmt.to_double(pmt.dict_ref(stats, pmt.intern("mean"), pmt.PMT_NIL)), 55.0)
+        self.assertAlmostEqual(pmt.to_double(pmt.dict_ref(stats, pmt.intern("p50"), pmt.PMT_NIL)), 50.0, delta=1.0)
+        self.assertAlmostEqual(pmt.to_double(pmt.dict_ref(stats, pmt.intern("p90"), pmt.PMT_NIL)), 90.0, delta=1.0)
+
+        dist.reset_stats()
+        self.assertEqual(pmt.to_uint64(pmt.dict_ref(dist.stats(), pmt.intern("count"), pmt.PMT_NIL)), 0)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_edge_distance)
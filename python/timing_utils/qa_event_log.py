@@ -0,0 +1,92 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018-2021 National Technology & Engineering Solutions of Sandia, LLC
+# (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government
+# retains certain rights in this software.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import glob
+import os
+import shutil
+import struct
+import tempfile
+try:
+    from gnuradio import timing_utils
+except ImportError:
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio import timing_utils
+
+HEADER = struct.Struct('<8sIIQQQQ16x')
+RECORD = struct.Struct('<QIHHQd')
+
+
+class qa_event_log (gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+        self.directory = tempfile.mkdtemp()
+
+    def tearDown(self):
+        self.tb = None
+        timing_utils.event_log.close()
+        shutil.rmtree(self.directory)
+
+    def read_events(self):
+        events = []
+        for path in glob.glob(os.path.join(self.directory, 'events-*.bin')):
+            with open(path, 'rb') as f:
+                data = f.read()
+            magic, version, size, capacity, written, thread, start = HEADER.unpack_from(data)
+            self.assertEqual(b'TUEVLOG\0', magic)
+            self.assertEqual(RECORD.size, size)
+            records = data[HEADER.size:HEADER.size + min(written, capacity) * RECORD.size]
+            events += list(RECORD.iter_unpack(records))
+        return events
+
+    def test_001_log(self):
+        source = timing_utils.event_log.source("qa_source")
+        timing_utils.event_log.log(timing_utils.EVENT_TAG, source, 1, 1.0)
+        self.assertFalse(timing_utils.event_log.enabled())
+
+        self.assertTrue(timing_utils.event_log.open(self.directory, 4))
+        self.assertFalse(timing_utils.event_log.open(self.directory, 4))
+        for ii in range(10):
+            timing_utils.event_log.log(timing_utils.EVENT_RETUNE, source, ii, 1e6)
+        timing_utils.event_log.close()
+
+        # only the newest events fit in the ring
+        events = sorted(self.read_events())
+        self.assertEqual([6, 7, 8, 9], [e[4] for e in events])
+        for e in events:
+            self.assertEqual(source, e[1])
+            self.assertEqual(int(timing_utils.EVENT_RETUNE), e[2])
+            self.assertEqual(1e6, e[5])
+
+        with open(os.path.join(self.directory, 'sources.csv')) as f:
+            self.assertIn('%d,qa_source' % source, f.read().splitlines())
+
+    def test_002_trigger(self):
+        data = [0.0] * 10000
+        data[5000:5100] = [1.0] * 100
+        src = blocks.vector_source_f(data, False)
+        trig = timing_utils.thresh_trigger_f(0.5, 0.2, 10)
+        self.tb.connect(src, trig)
+
+        timing_utils.event_log.open(self.directory)
+        self.tb.run()
+        timing_utils.event_log.close()
+
+        events = [e for e in self.read_events() if e[2] == int(timing_utils.EVENT_TRIGGER)]
+        self.assertEqual(1, len(events))
+        self.assertEqual(5009, events[0][4])
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_event_log)
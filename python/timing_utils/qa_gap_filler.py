@@ -0,0 +1,119 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018-2021 National Technology & Engineering Solutions of Sandia, LLC
+# (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government
+# retains certain rights in this software.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+try:
+    from gnuradio import timing_utils
+except ImportError:
+    import os
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio import timing_utils
+
+
+class qa_gap_filler (gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def make_tag(self, offset, key, value):
+        tag = gr.tag_t()
+        tag.offset = offset
+        tag.key = pmt.intern(key)
+        tag.value = value
+        return tag
+
+    def time_tag(self, offset, secs, frac):
+        return self.make_tag(offset, "rx_time",
+                             pmt.make_tuple(pmt.from_uint64(secs), pmt.from_double(frac)))
+
+    def run_filler(self, filler, n, tags):
+        data = [float(x + 1) for x in range(n)]
+        src = blocks.vector_source_f(data, False, 1, tags)
+        snk = blocks.vector_sink_f()
+        dbg = blocks.message_debug()
+        self.tb.connect(src, filler, snk)
+        self.tb.msg_connect((filler, 'gap'), (dbg, 'store'))
+        self.tb.run()
+        return snk, dbg
+
+    def test_001_fill(self):
+        # 20 samples are missing before sample 500
+        tags = [self.time_tag(0, 10, 0.0), self.time_tag(500, 15, 0.2)]
+        filler = timing_utils.gap_filler_f(100.0, True, 1000)
+        snk, dbg = self.run_filler(filler, 1000, tags)
+
+        data = snk.data()
+        self.assertEqual(len(data), 1020)
+        self.assertEqual(data[499], 500.0)
+        self.assertEqual(list(data[500:520]), [0.0] * 20)
+        self.assertEqual(data[520], 501.0)
+
+        self.assertEqual(filler.gaps(), 1)
+        self.assertEqual(filler.dropped(), 20)
+        self.assertEqual(filler.filled(), 20)
+
+        # the rx_time tag moves with its sample
+        out_tags = {pmt.symbol_to_string(t.key) + str(t.offset): t for t in snk.tags()}
+        self.assertIn("rx_time520", out_tags)
+        self.assertEqual(pmt.to_uint64(out_tags["gap500"].value), 20)
+
+        self.assertEqual(dbg.num_messages(), 1)
+        msg = dbg.get_message(0)
+        # rx_sample and rx_time refer to the same, first real, sample
+        self.assertEqual(pmt.to_uint64(pmt.dict_ref(msg, pmt.intern("rx_sample"), pmt.PMT_NIL)), 520)
+        self.assertTrue(pmt.equal(pmt.dict_ref(msg, pmt.intern("rx_time"), pmt.PMT_NIL),
+                                  out_tags["rx_time520"].value))
+        self.assertEqual(pmt.to_uint64(pmt.dict_ref(msg, pmt.intern("dropped"), pmt.PMT_NIL)), 20)
+        self.assertEqual(pmt.to_uint64(pmt.dict_ref(msg, pmt.intern("filled"), pmt.PMT_NIL)), 20)
+
+    def test_002_report_only(self):
+        tags = [self.time_tag(0, 10, 0.0), self.time_tag(500, 15, 0.2)]
+        filler = timing_utils.gap_filler_f(100.0, False, 1000)
+        snk, dbg = self.run_filler(filler, 1000, tags)
+
+        self.assertEqual(len(snk.data()), 1000)
+        self.assertEqual(filler.dropped(), 20)
+        self.assertEqual(filler.filled(), 0)
+        self.assertEqual(dbg.num_messages(), 1)
+        msg = dbg.get_message(0)
+        self.assertEqual(pmt.to_uint64(pmt.dict_ref(msg, pmt.intern("rx_sample"), pmt.PMT_NIL)), 500)
+
+    def test_003_max_fill(self):
+        # gaps larger than max_fill are only reported
+        tags = [self.time_tag(0, 10, 0.0), self.time_tag(500, 20, 0.0)]
+        filler = timing_utils.gap_filler_f(100.0, True, 100)
+        snk, dbg = self.run_filler(filler, 1000, tags)
+
+        self.assertEqual(len(snk.data()), 1000)
+        self.assertEqual(filler.dropped(), 500)
+        self.assertEqual(filler.filled(), 0)
+
+    def test_004_rate_change(self):
+        # the rate change at sample 200 is accounted for, so no gap is reported
+        tags = [self.time_tag(0, 10, 0.0),
+                self.make_tag(200, "rx_rate", pmt.from_double(200.0)),
+                self.time_tag(600, 14, 0.0)]
+        filler = timing_utils.gap_filler_f(100.0, True, 1000)
+        snk, dbg = self.run_filler(filler, 1000, tags)
+
+        self.assertEqual(len(snk.data()), 1000)
+        self.assertEqual(filler.gaps(), 0)
+        self.assertEqual(dbg.num_messages(), 0)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_gap_filler)
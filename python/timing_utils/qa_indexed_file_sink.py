@@ -0,0 +1,97 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018-2021 National Technology & Engineering Solutions of Sandia, LLC
+# (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government
+# retains certain rights in this software.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import os
+import pmt
+import shutil
+import struct
+import tempfile
+try:
+    from gnuradio import timing_utils
+except ImportError:
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio import timing_utils
+
+
+class qa_indexed_file_sink (gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+        self.dir = tempfile.mkdtemp()
+
+    def tearDown(self):
+        self.tb = None
+        shutil.rmtree(self.dir)
+
+    def read_index(self, filename):
+        with open(filename, "rb") as f:
+            data = f.read()
+        (magic, version, entry_size, itemsize, rate) = struct.unpack("<8sIIQd", data[:32])
+        self.assertEqual(magic, b"TUINDEX\0")
+        entries = [struct.unpack("<QIIQd", data[ii:ii + 32]) for ii in range(32, len(data), 32)]
+        return ((version, entry_size, itemsize, rate), entries)
+
+    def record(self, direct):
+        filename = os.path.join(self.dir, "rec.bin")
+        tags = [gr.tag_utils.python_to_tag([0, pmt.intern("rx_time"), pmt.make_tuple(pmt.from_uint64(100), pmt.from_double(0.25)), pmt.intern("src")]),
+                gr.tag_utils.python_to_tag([0, pmt.intern("rx_rate"), pmt.from_double(1e6), pmt.intern("src")]),
+                gr.tag_utils.python_to_tag([3000, pmt.intern("rx_freq"), pmt.from_double(915e6), pmt.intern("src")]),
+                gr.tag_utils.python_to_tag([5000, pmt.intern("freq"), pmt.from_double(2e6), pmt.intern("src")]),
+                gr.tag_utils.python_to_tag([6000, pmt.intern("other"), pmt.PMT_T, pmt.intern("src")])]
+        data = [complex(x, -x) for x in range(10000)]
+        src = blocks.vector_source_c(data, False, 1, tags)
+        snk = timing_utils.indexed_file_sink(filename, gr.sizeof_gr_complex, 1e6, direct, 16384)
+        self.tb.connect(src, snk)
+        self.tb.run()
+        self.tb = None
+        snk = None
+
+        # the recording holds the samples as they are
+        with open(filename, "rb") as f:
+            recorded = f.read()
+        self.assertEqual(len(recorded), len(data) * gr.sizeof_gr_complex)
+        (re, im) = struct.unpack("<ff", recorded[8 * 1234:8 * 1235])
+        self.assertEqual(complex(re, im), data[1234])
+
+        (header, entries) = self.read_index(filename + ".idx")
+        self.assertEqual(header, (1, 32, gr.sizeof_gr_complex, 1e6))
+        # the RF center and a retune within the band are told apart
+        self.assertEqual(entries, [(0, 1, 0, 100, 0.25), (0, 2, 0, 0, 1e6),
+                                   (3000, 3, 0, 0, 915e6), (5000, 4, 0, 0, 2e6)])
+
+    def test_001_buffered(self):
+        self.record(False)
+
+    def test_002_direct(self):
+        self.record(True)
+
+    def test_003_ignore_rx_rate(self):
+        # the input rate tag of a decimating block is not indexed
+        filename = os.path.join(self.dir, "rec.bin")
+        tags = [gr.tag_utils.python_to_tag([0, pmt.intern("rx_time"), pmt.make_tuple(pmt.from_uint64(100), pmt.from_double(0.25)), pmt.intern("src")]),
+                gr.tag_utils.python_to_tag([0, pmt.intern("rx_rate"), pmt.from_double(1e6), pmt.intern("src")])]
+        src = blocks.vector_source_c([0j] * 1000, False, 1, tags)
+        snk = timing_utils.indexed_file_sink(filename, gr.sizeof_gr_complex, 1e5, False, 16384, False)
+        self.tb.connect(src, snk)
+        self.tb.run()
+        self.tb = None
+        snk = None
+
+        (header, entries) = self.read_index(filename + ".idx")
+        self.assertEqual(header[3], 1e5)
+        self.assertEqual(entries, [(0, 1, 0, 100, 0.25)])
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_indexed_file_sink)
@@ -0,0 +1,98 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018-2021 National Technology & Engineering Solutions of Sandia, LLC
+# (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government
+# retains certain rights in this software.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import os
+import pmt
+import shutil
+import tempfile
+try:
+    from gnuradio import timing_utils
+except ImportError:
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio import timing_utils
+
+
+class qa_indexed_file_source (gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+        self.dir = tempfile.mkdtemp()
+        self.filename = os.path.join(self.dir, "rec.bin")
+        self.data = [float(x) for x in range(20000)]
+
+    def tearDown(self):
+        self.tb = None
+        shutil.rmtree(self.dir)
+
+    def record(self):
+        tags = [gr.tag_utils.python_to_tag([0, pmt.intern("rx_time"), pmt.make_tuple(pmt.from_uint64(100), pmt.from_double(0.5)), pmt.intern("src")]),
+                gr.tag_utils.python_to_tag([0, pmt.intern("rx_rate"), pmt.from_double(1000.0), pmt.intern("src")]),
+                gr.tag_utils.python_to_tag([1000, pmt.intern("freq"), pmt.from_double(-1e5), pmt.intern("src")]),
+                gr.tag_utils.python_to_tag([8000, pmt.intern("rx_freq"), pmt.from_double(2e6), pmt.intern("src")]),
+                gr.tag_utils.python_to_tag([9000, pmt.intern("freq"), pmt.from_double(2e5), pmt.intern("src")]),
+                gr.tag_utils.python_to_tag([10000, pmt.intern("rx_time"), pmt.make_tuple(pmt.from_uint64(120), pmt.from_double(0.0)), pmt.intern("src")])]
+        src = blocks.vector_source_f(self.data, False, 1, tags)
+        snk = timing_utils.indexed_file_sink(self.filename, gr.sizeof_float, 1000.0)
+        self.tb.connect(src, snk)
+        self.tb.run()
+        self.tb = gr.top_block()
+
+    def play(self, src):
+        snk = blocks.vector_sink_f()
+        self.tb.connect(src, snk)
+        self.tb.run()
+        tags = [(t.offset, pmt.symbol_to_string(t.key), t.value) for t in snk.tags()]
+        return (snk.data(), tags)
+
+    def test_001_indexed(self):
+        self.record()
+
+        # 102.5 s is 2000 samples in, 115.25 s falls in the gap before 120 s
+        src = timing_utils.indexed_file_source(self.filename, gr.sizeof_float,
+                                               seek_time=102.5, end_time=120.5)
+        self.assertEqual((src.start_sample(), src.end_sample()), (2000, 10500))
+        (data, tags) = self.play(src)
+        self.assertFloatTuplesAlmostEqual(data, self.data[2000:10500])
+
+        times = [(t[0], pmt.to_uint64(pmt.tuple_ref(t[2], 0)), pmt.to_double(pmt.tuple_ref(t[2], 1)))
+                 for t in tags if t[1] == "rx_time"]
+        self.assertEqual(times, [(0, 102, 0.5), (8000, 120, 0.0)])
+        freqs = [(t[0], pmt.to_double(t[2])) for t in tags if t[1] == "rx_freq"]
+        self.assertEqual(freqs, [(6000, 2e6)])
+        # retunes come back as retunes, the one before the seek on the first sample
+        retunes = [(t[0], pmt.to_double(t[2])) for t in tags if t[1] == "freq"]
+        self.assertEqual(retunes, [(0, -1e5), (7000, 2e5)])
+        rates = [(t[0], pmt.to_double(t[2])) for t in tags if t[1] == "rx_rate"]
+        self.assertEqual(rates, [(0, 1000.0)])
+
+    def test_002_unindexed(self):
+        self.record()
+        os.remove(self.filename + ".idx")
+
+        src = timing_utils.indexed_file_source(self.filename, gr.sizeof_float, 1000.0, 50.0,
+                                               seek_time=53.0, end_time=54.0)
+        (data, tags) = self.play(src)
+        self.assertFloatTuplesAlmostEqual(data, self.data[3000:4000])
+        self.assertEqual([(t[0], t[1]) for t in tags], [(0, "rx_time"), (0, "rx_rate")])
+
+    def test_003_no_timing(self):
+        self.record()
+        os.remove(self.filename + ".idx")
+
+        self.assertRaises(RuntimeError, timing_utils.indexed_file_source,
+                          self.filename, gr.sizeof_float, seek_time=53.0)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_indexed_file_source)
@@ -169,7 +169,37 @@ class qa_interrupt_emitter (gr_unittest.TestCase):
             raise Exception("Did not send required messages")
         self.checkmsgtime(self.msg_dbg.get_message(0), t0, (t0 - start_time) * self.rate + sample)
 
-    #TODO Add test for late request
+    def triggermsg(self, abstime):
+        info = pmt.make_dict()
+        info = pmt.dict_add(info, self.skey, pmt.from_uint64(int((abstime - self.start_time) * self.rate)))
+        info = pmt.dict_add(info, self.tkey, self.timemsg(abstime, "pair"))
+        return pmt.cons(pmt.intern("trigger_now"), info)
+
+    def test_004_trigger_message(self):
+        # trigger messages are for samples already processed, so without a
+        # delay the interrupt is late and dropped, with one it fires after it
+        t0, delay = .1, .15
+        self.tb.start()
+        # wait until data has started flowing to issue the first interrupt instead of sleeping
+        while self.tag_dbg.num_tags() == 0:
+            time.sleep(1e-3)
+        time.sleep(.05)
+        self.emitter.emit(self.triggermsg(t0)) # issued at ~.150s due to start_time
+        time.sleep(.01)
+        self.timer.set_trigger_delay(delay)
+        self.emitter.emit(self.triggermsg(t0))
+        for i in range(15):
+            if self.msg_dbg.num_messages() == 1:
+                break
+            time.sleep(0.02)
+
+        # DO NOT call wait!!!!  It won't return because the emitter block doesn't have any inputs.
+        self.tb.stop()
+        time.sleep(.1)
+
+        if (self.msg_dbg.num_messages() != 1):
+            raise Exception("Did not send required messages")
+        self.checkmsgtime(self.msg_dbg.get_message(0), t0 + delay, (t0 + delay - self.start_time) * self.rate)
 
 
 if __name__ == '__main__':
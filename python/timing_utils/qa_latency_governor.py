@@ -0,0 +1,153 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018-2021 National Technology & Engineering Solutions of Sandia, LLC
+# (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government
+# retains certain rights in this software.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+import time
+try:
+    from gnuradio import timing_utils
+except ImportError:
+    import os
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio import timing_utils
+
+
+class qa_latency_governor (gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def wall_clock_tag(self, offset, value):
+        tag = gr.tag_t()
+        tag.offset = offset
+        tag.key = pmt.intern("wall_clock_time")
+        tag.value = pmt.from_double(value)
+        return tag
+
+    def rx_time_tag(self, offset, value):
+        tag = gr.tag_t()
+        tag.offset = offset
+        tag.key = pmt.intern("rx_time")
+        tag.value = pmt.make_tuple(pmt.from_uint64(int(value)),
+                                   pmt.from_double(value - int(value)))
+        return tag
+
+    def test_001_current(self):
+        # samples stamped in the future never lag
+        n = 10000
+        tags = [self.wall_clock_tag(0, time.time() + 60.0)]
+        src = blocks.vector_source_f([float(x) for x in range(n)], False, 1, tags)
+        gov = timing_utils.latency_governor_f(1000.0, 0.5, 0)
+        snk = blocks.vector_sink_f()
+        self.tb.connect(src, gov, snk)
+        self.tb.run()
+
+        self.assertEqual(len(snk.data()), n)
+        self.assertEqual(gov.dropped(), 0)
+
+    def test_002_stale(self):
+        # samples stamped an hour ago are all dropped
+        n = 10000
+        tags = [self.wall_clock_tag(0, time.time() - 3600.0)]
+        src = blocks.vector_source_f([float(x) for x in range(n)], False, 1, tags)
+        gov = timing_utils.latency_governor_f(1000.0, 0.5, 0)
+        snk = blocks.vector_sink_f()
+        self.tb.connect(src, gov, snk)
+        self.tb.run()
+
+        self.assertEqual(len(snk.data()), 0)
+        self.assertEqual(gov.dropped(), n)
+        self.assertGreater(gov.lag(), 3000.0)
+
+    def test_003_recover(self):
+        # stale data is dropped until fresh data arrives, which is tagged; a
+        # small buffer keeps the fresh tag out of sight while the stale data
+        # is queued
+        n = 100000
+        tags = [self.wall_clock_tag(0, time.time() - 3600.0),
+                self.wall_clock_tag(n // 2, time.time() + 60.0)]
+        src = blocks.vector_source_f([float(x) for x in range(n)], False, 1, tags)
+        src.set_max_output_buffer(1024)
+        gov = timing_utils.latency_governor_f(1000.0, 0.5, 0)
+        snk = blocks.vector_sink_f()
+        dbg = blocks.message_debug()
+        self.tb.connect(src, gov, snk)
+        self.tb.msg_connect((gov, 'shed'), (dbg, 'store'))
+        self.tb.run()
+
+        # how much is dropped depends on how the scheduler splits the buffers
+        data = snk.data()
+        self.assertGreater(gov.dropped(), 0)
+        self.assertLessEqual(gov.dropped(), n // 2)
+        self.assertEqual(len(data) + gov.dropped(), n)
+        self.assertEqual(data[-1], float(n - 1))
+
+        shed_tags = [t for t in snk.tags() if pmt.eq(t.key, pmt.intern("shed"))]
+        self.assertEqual(len(shed_tags), 1)
+        self.assertEqual(shed_tags[0].offset, 0)
+        self.assertEqual(pmt.to_uint64(shed_tags[0].value), gov.dropped())
+        self.assertEqual(dbg.num_messages(), 1)
+
+    def test_004_sustained_lag(self):
+        # radio time falls a second behind and stays there; the clock offset
+        # baseline must not absorb the lag over many small buffers
+        n = 200000
+        jump = 1000
+        now = time.time()
+        tags = [self.rx_time_tag(0, now), self.rx_time_tag(jump, now - 1.0)]
+        # a high rate keeps the radio time still over the run
+        src = blocks.vector_source_f([float(x) for x in range(n)], False, 1, tags)
+        src.set_max_noutput_items(8)
+        gov = timing_utils.latency_governor_f(1e9, 0.5, 0)
+        snk = blocks.vector_sink_f()
+        self.tb.connect(src, gov, snk)
+        self.tb.run()
+
+        data = snk.data()
+        self.assertLessEqual(len(data), jump)
+        self.assertEqual(len(data) + gov.dropped(), n)
+        self.assertGreater(gov.lag(), 0.5)
+
+    def test_005_carry_tags(self):
+        # the latest of each other tag in the dropped data is restored on the
+        # first sample passed
+        n = 100000
+        freq_tags = []
+        for offset, freq in [(n // 8, 1e6), (n // 4, 2e6)]:
+            tag = gr.tag_t()
+            tag.offset = offset
+            tag.key = pmt.intern("rx_freq")
+            tag.value = pmt.from_double(freq)
+            freq_tags.append(tag)
+        tags = [self.wall_clock_tag(0, time.time() - 3600.0),
+                self.wall_clock_tag(n // 2, time.time() + 60.0)] + freq_tags
+        src = blocks.vector_source_f([float(x) for x in range(n)], False, 1, tags)
+        src.set_max_output_buffer(1024)
+        gov = timing_utils.latency_governor_f(1000.0, 0.5, 0)
+        snk = blocks.vector_sink_f()
+        self.tb.connect(src, gov, snk)
+        self.tb.run()
+
+        # both tags fall in the dropped data
+        self.assertGreater(gov.dropped(), n // 4)
+        rx_freq = [t for t in snk.tags() if pmt.eq(t.key, pmt.intern("rx_freq"))]
+        self.assertEqual(len(rx_freq), 1)
+        self.assertEqual(rx_freq[0].offset, 0)
+        self.assertEqual(pmt.to_double(rx_freq[0].value), 2e6)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_latency_governor)
@@ -0,0 +1,153 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018-2021 National Technology & Engineering Solutions of Sandia, LLC
+# (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government
+# retains certain rights in this software.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+try:
+    from gnuradio import timing_utils
+except ImportError:
+    import os
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio import timing_utils
+
+
+class qa_sample_timeline (gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def test_001_empty(self):
+        tl = timing_utils.sample_timeline.get("qa_empty")
+        self.assertEqual(tl.version(), 0)
+        self.assertIsNone(tl.latest())
+        self.assertIsNone(tl.time_at(100))
+        self.assertIsNone(tl.offset_at(100, 0.0))
+
+    def test_002_lookup(self):
+        tl = timing_utils.sample_timeline.get("qa_lookup")
+        self.assertIs(tl, timing_utils.sample_timeline.get("qa_lookup"))
+
+        tl.publish(0, 100, 0.5, 1000.0)
+        tl.publish(1000, 101, 0.75, 2000.0)
+        self.assertEqual(tl.version(), 2)
+
+        # before the second anchor
+        secs, frac = tl.time_at(500)
+        self.assertEqual(secs, 101)
+        self.assertAlmostEqual(frac, 0.0)
+
+        # after the second anchor, at the new rate
+        secs, frac = tl.time_at(1500)
+        self.assertEqual(secs, 101)
+        self.assertAlmostEqual(frac, 0.5 + 0.25)
+        secs, frac = tl.time_at(2000)
+        self.assertEqual(secs, 102)
+        self.assertAlmostEqual(frac, 0.25)
+
+        self.assertEqual(tl.offset_at(101, 0.0), 500)
+        self.assertEqual(tl.offset_at(102, 0.25), 2000)
+        self.assertIsNone(tl.offset_at(99, 0.0))
+
+        anchor = tl.latest()
+        self.assertEqual(anchor.offset, 1000)
+        self.assertEqual(tl.anchor_at(999).offset, 0)
+
+        tl.reset()
+        self.assertEqual(tl.version(), 0)
+        self.assertIsNone(tl.latest())
+
+    def test_003_retained(self):
+        tl = timing_utils.sample_timeline.get("qa_retained")
+        n = timing_utils.sample_timeline.NUM_ANCHORS + 4
+        for ii in range(n):
+            tl.publish(ii * 1000, 10 + ii, 0.0, 1000.0)
+
+        # samples before the oldest retained anchor use that anchor
+        self.assertEqual(tl.anchor_at(0).offset, 4000)
+        secs, frac = tl.time_at(0)
+        self.assertEqual(secs, 10)
+        self.assertAlmostEqual(frac, 0.0)
+        self.assertEqual(tl.latest().offset, (n - 1) * 1000)
+
+    def test_004_add_usrp_tags(self):
+        rate = 1e6
+        src = blocks.vector_source_c(list(range(10000)), False, 1, [])
+        utag = timing_utils.add_usrp_tags_c(1090e6, rate, 1234, .5)
+        utag.set_timeline("qa_usrp_tags")
+        snk = blocks.null_sink(gr.sizeof_gr_complex)
+        self.tb.connect(src, utag, snk)
+        self.tb.run()
+
+        tl = timing_utils.sample_timeline.get("qa_usrp_tags")
+        self.assertEqual(tl.version(), 1)
+        secs, frac = tl.time_at(0)
+        self.assertEqual(secs, 1234)
+        self.assertAlmostEqual(frac, 0.5)
+        secs, frac = tl.time_at(750000)
+        self.assertEqual(secs, 1235)
+        self.assertAlmostEqual(frac, 0.25)
+
+    def test_005_tap(self):
+        # with no output connected the timeline is published from a tap on
+        # the source buffer
+        rate = 1e6
+        src = blocks.vector_source_c(list(range(10000)), False, 1, [])
+        utag = timing_utils.add_usrp_tags_c(1090e6, rate, 1234, .5)
+        utag.set_timeline("qa_tap")
+        snk = blocks.null_sink(gr.sizeof_gr_complex)
+        self.tb.connect(src, utag)
+        self.tb.connect(src, snk)
+        self.tb.run()
+
+        tl = timing_utils.sample_timeline.get("qa_tap")
+        self.assertEqual(tl.version(), 1)
+        self.assertEqual(tl.offset_at(1234, 0.501), 1000)
+
+    def test_006_invalid_rate(self):
+        # anchors that would make lookups divide by zero are rejected
+        tl = timing_utils.sample_timeline.get("qa_invalid_rate")
+        self.assertTrue(tl.publish(0, 100, 0.0, 1000.0))
+        self.assertFalse(tl.publish(1000, 101, 0.0, 0.0))
+        self.assertFalse(tl.publish(1000, 101, 0.0, -1000.0))
+        self.assertFalse(tl.publish(1000, 101, 0.0, float('nan')))
+        self.assertEqual(tl.version(), 1)
+
+    def test_007_emitter(self):
+        # the emitter converts a requested sample past a rate change with the
+        # anchor that applies to it
+        tl = timing_utils.sample_timeline.get("qa_emitter")
+        tl.publish(0, 100, 0.0, 1000.0)
+        tl.publish(2000, 200, 0.0, 2000.0)
+
+        src = blocks.vector_source_c([0j] * 4000, False)
+        dut = timing_utils.uhd_timed_pdu_emitter(1000, True)
+        dut.set_timeline("qa_emitter")
+        dbg = blocks.message_debug()
+        self.tb.connect(src, dut)
+        self.tb.msg_connect((dut, 'trig'), (dbg, 'store'))
+
+        # queued before the flowgraph starts, so it is handled before any work
+        dut.to_basic_block()._post(pmt.intern('set'), pmt.from_uint64(3000))
+        self.tb.run()
+
+        self.assertEqual(dbg.num_messages(), 1)
+        trig = pmt.dict_ref(dbg.get_message(0), pmt.intern('trigger_time'), pmt.PMT_NIL)
+        self.assertEqual(pmt.to_uint64(pmt.car(trig)), 200)
+        self.assertAlmostEqual(pmt.to_double(pmt.cdr(trig)), 0.5)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_sample_timeline)
@@ -0,0 +1,86 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018-2021 National Technology & Engineering Solutions of Sandia, LLC
+# (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government
+# retains certain rights in this software.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+import time
+try:
+    from gnuradio import timing_utils
+except ImportError:
+    import os
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio import timing_utils
+
+
+class qa_simulated_radio_source (gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def run_source(self, nsamples, *args, **kwargs):
+        src = timing_utils.simulated_radio_source(*args, **kwargs)
+        head = blocks.head(gr.sizeof_gr_complex, nsamples)
+        snk = blocks.vector_sink_c()
+        self.tb.connect(src, head, snk)
+        self.tb.run()
+        return (src, snk)
+
+    def time_tags(self, snk):
+        tags = [t for t in snk.tags() if pmt.eq(t.key, pmt.intern("rx_time"))]
+        return [(t.offset, pmt.to_uint64(pmt.tuple_ref(t.value, 0)) + pmt.to_double(pmt.tuple_ref(t.value, 1)))
+                for t in sorted(tags, key=lambda t: t.offset)]
+
+    def test_001_tags(self):
+        tnow = time.time()
+        (src, snk) = self.run_source(10000, 1e6, 2.4e9, 1e5, realtime=False)
+
+        # one set of tags on the first sample
+        keys = sorted([pmt.symbol_to_string(t.key) for t in snk.tags()])
+        self.assertEqual(keys, ['rx_freq', 'rx_rate', 'rx_time'])
+        for t in snk.tags():
+            self.assertEqual(t.offset, 0)
+            if pmt.eq(t.key, pmt.intern("rx_rate")):
+                self.assertAlmostEqual(pmt.to_double(t.value), 1e6)
+            if pmt.eq(t.key, pmt.intern("rx_freq")):
+                self.assertAlmostEqual(pmt.to_double(t.value), 2.4e9)
+        self.assertAlmostEqual(self.time_tags(snk)[0][1], tnow, delta=60)
+
+        # tone at 1/10 of the sample rate
+        data = snk.data()
+        self.assertEqual(len(data), 10000)
+        self.assertComplexAlmostEqual(data[10], data[0], 3)
+
+    def test_002_overflows(self):
+        (src, snk) = self.run_source(100000, 1e6, overflow_period=0.01, overflow_samples=500, realtime=False)
+
+        # each overflow drops 500 samples, so the time jumps by 10.5 ms
+        tags = self.time_tags(snk)
+        self.assertEqual([t[0] for t in tags], list(range(0, 100000, 10000)))
+        for (a, b) in zip(tags, tags[1:]):
+            self.assertAlmostEqual(b[1] - a[1], 0.0105, delta=1e-6)
+        self.assertGreaterEqual(src.overflows(), 9)
+
+    def test_003_realtime(self):
+        start = time.time()
+        (src, snk) = self.run_source(50000, 1e6, ppm=50, jitter=1e-4, burst_size=1000)
+
+        # samples are not delivered faster than the simulated clock
+        self.assertGreaterEqual(time.time() - start, 0.045)
+        self.assertEqual(len(snk.data()), 50000)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_simulated_radio_source)
@@ -85,6 +85,41 @@ class qa_system_time_diff (gr_unittest.TestCase):
         time.sleep(.1)
         self.tb.stop()
 
+    def test_003_diff_message(self):
+        self.duration = 10000
+        tnow = time.time()
+
+        offsets = list(range(0, self.duration, 7))
+        src_tags = [gr.tag_utils.python_to_tag([x, pmt.intern("wall_clock_time"), pmt.from_double(tnow), pmt.intern("test_003")])
+                    for x in offsets]
+        src_tags.append(gr.tag_utils.python_to_tag([5, pmt.intern("other"), pmt.PMT_T, pmt.intern("test_003")]))
+        self.src = blocks.vector_source_c(list(range(self.duration)), False, 1, src_tags)
+        self.dut = timing_utils.system_time_diff_c(False, False)
+        self.snk = blocks.vector_sink_c()
+        self.dbg = blocks.message_debug()
+
+        self.tb.connect((self.src, 0), (self.dut, 0))
+        self.tb.connect((self.dut, 0), (self.snk, 0))
+        self.tb.msg_connect((self.dut, 'diff'), (self.dbg, 'store'))
+        self.tb.run()
+
+        # every time tag is reported once, in order
+        got_offsets = []
+        got_diffs = []
+        for ii in range(self.dbg.num_messages()):
+            msg = self.dbg.get_message(ii)
+            got_offsets += list(pmt.u64vector_elements(pmt.dict_ref(pmt.car(msg), pmt.intern("offsets"), pmt.PMT_NIL)))
+            got_diffs += list(pmt.f64vector_elements(pmt.cdr(msg)))
+        self.assertEqual(got_offsets, offsets)
+        for diff in got_diffs:
+            self.assertAlmostEqual(diff, 0, delta=60)
+
+        # tags are propagated unchanged by the runtime
+        tags = self.snk.tags()
+        self.assertEqual(len(tags), len(offsets) + 1)
+        self.assertEqual(sorted([t.offset for t in tags if pmt.eq(t.key, pmt.intern("wall_clock_time"))]), offsets)
+        self.assertEqual(len(self.snk.data()), self.duration)
+
 
 if __name__ == '__main__':
     gr_unittest.run(qa_system_time_diff)
@@ -84,6 +84,32 @@ class qa_system_time_tagger (gr_unittest.TestCase):
         time.sleep(.1)
         self.tb.stop()
 
+    def test_003_interpolated(self):
+        self.rate = 100000
+        self.duration = 50000
+        tnow = time.time()
+
+        self.src = blocks.vector_source_c(list(range(self.duration)), False, 1, [])
+        self.throttle = blocks.throttle(gr.sizeof_gr_complex * 1, self.rate)
+        self.dut = timing_utils.system_time_tagger_c(1000)
+        self.snk = blocks.vector_sink_c()
+
+        self.tb.connect((self.src, 0), (self.throttle, 0))
+        self.tb.connect((self.throttle, 0), (self.dut, 0))
+        self.tb.connect((self.dut, 0), (self.snk, 0))
+        self.tb.run()
+
+        # once the rate is known, tags in one buffer no longer share a time
+        # but are spaced by about the tag interval
+        times = [pmt.to_double(t.value) for t in sorted(self.snk.tags(), key=lambda t: t.offset)
+                 if pmt.eq(t.key, pmt.intern("wall_clock_time"))]
+        self.assertEqual(len(times), self.duration // 1000 - 1)
+        self.assertAlmostEqual(times[0], tnow, delta=60)
+        steps = [b - a for (a, b) in zip(times[len(times) // 2:], times[len(times) // 2 + 1:])]
+        for step in steps:
+            self.assertGreater(step, 0)
+        self.assertAlmostEqual(sum(steps) / len(steps), 1000.0 / self.rate, delta=0.005)
+
 
 if __name__ == '__main__':
     gr_unittest.run(qa_system_time_tagger)
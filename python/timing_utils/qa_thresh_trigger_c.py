@@ -0,0 +1,96 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018-2021 National Technology & Engineering Solutions of Sandia, LLC
+# (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government
+# retains certain rights in this software.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import cmath
+import pmt
+try:
+    from gnuradio import timing_utils
+except ImportError:
+    import os
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio import timing_utils
+
+
+class qa_thresh_trigger_c (gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def test_001_matches_float(self):
+        # same triggers as complex_to_mag into thresh_trigger_f
+        data = [cmath.rect(0.1, 0.01 * ii) for ii in range(100000)]
+        for start, n in [(1000, 50), (40000, 5), (70000, 500)]:
+            data[start:start + n] = [cmath.rect(0.8, 0.1 * ii) for ii in range(n)]
+        src = blocks.vector_source_c(data, False)
+        trig_c = timing_utils.thresh_trigger_c(0.5, 0.2, 10)
+        mag = blocks.complex_to_mag()
+        trig_f = timing_utils.thresh_trigger_f(0.5, 0.2, 10)
+        dbg_c = blocks.message_debug()
+        dbg_f = blocks.message_debug()
+        self.tb.connect(src, trig_c)
+        self.tb.connect(src, mag, trig_f)
+        self.tb.msg_connect((trig_c, 'trig'), (dbg_c, 'store'))
+        self.tb.msg_connect((trig_f, 'trig'), (dbg_f, 'store'))
+        self.tb.run()
+
+        self.assertEqual(dbg_c.num_messages(), 2)
+        self.assertEqual(dbg_f.num_messages(), 2)
+        for ii in range(2):
+            info_c = pmt.cdr(dbg_c.get_message(ii))
+            info_f = pmt.cdr(dbg_f.get_message(ii))
+            self.assertEqual(pmt.to_uint64(pmt.dict_ref(info_c, pmt.intern("trigger_sample"), pmt.PMT_NIL)),
+                             pmt.to_uint64(pmt.dict_ref(info_f, pmt.intern("trigger_sample"), pmt.PMT_NIL)))
+
+    def test_002_pass_through(self):
+        data = [0j] * 1000 + [complex(0.6, 0.6)] * 20 + [0j] * 100
+        src = blocks.vector_source_c(data, False)
+        trig = timing_utils.thresh_trigger_c(0.8, 0.2, 5)
+        snk = blocks.vector_sink_c()
+        self.tb.connect(src, trig, snk)
+        self.tb.run()
+
+        self.assertComplexTuplesAlmostEqual(snk.data(), data)
+        tags = [t for t in snk.tags() if pmt.eq(t.key, pmt.intern("trigger_now"))]
+        self.assertEqual(len(tags), 1)
+        self.assertEqual(tags[0].offset, 1004)
+
+    def test_003_cfar(self):
+        # the ratios apply to the magnitude, so they are squared against the
+        # mean power; bursts and a step in the floor at ten times the
+        # magnitude trigger
+        mags = []
+        for level in [0.1, 1.0]:
+            mags += [level * (0.5 + ((ii * 7919) % 100) / 200.0) for ii in range(20000)]
+        bursts = [5000, 15000, 25000, 35000]
+        for start in bursts:
+            mags[start:start + 100] = [10.0 * mags[start]] * 100
+        data = [cmath.rect(m, 0.01 * ii) for ii, m in enumerate(mags)]
+        src = blocks.vector_source_c(data, False)
+        trig = timing_utils.thresh_trigger_c(5.0, 2.0, 3)
+        trig.set_cfar(1000)
+        dbg = blocks.message_debug()
+        self.tb.connect(src, trig)
+        self.tb.msg_connect((trig, 'trig'), (dbg, 'store'))
+        self.tb.run()
+
+        samples = [pmt.to_uint64(pmt.dict_ref(pmt.cdr(dbg.get_message(ii)), pmt.intern("trigger_sample"), pmt.PMT_NIL))
+                   for ii in range(dbg.num_messages())]
+        self.assertEqual(samples, sorted([start + 2 for start in bursts + [20000]]))
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_thresh_trigger_c)
@@ -0,0 +1,123 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018-2021 National Technology & Engineering Solutions of Sandia, LLC
+# (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government
+# retains certain rights in this software.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+try:
+    from gnuradio import timing_utils
+except ImportError:
+    import os
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio import timing_utils
+
+
+class qa_thresh_trigger_f (gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def run_trigger(self, data, hi, lo, length, tags=[]):
+        src = blocks.vector_source_f(data, False, 1, tags)
+        trig = timing_utils.thresh_trigger_f(hi, lo, length)
+        dbg = blocks.message_debug()
+        self.tb.connect(src, trig)
+        self.tb.msg_connect((trig, 'trig'), (dbg, 'store'))
+        self.tb.run()
+        return trig, dbg
+
+    def test_001_bursts(self):
+        # three bursts, only the two long enough trigger
+        data = [0.0] * 100000
+        for start, n in [(1000, 50), (40000, 5), (70000, 500)]:
+            data[start:start + n] = [1.0] * n
+        trig, dbg = self.run_trigger(data, 0.5, 0.2, 10)
+        self.assertEqual(dbg.num_messages(), 2)
+
+    def test_002_long_burst(self):
+        # a burst spanning many buffers triggers once
+        data = [0.0] * 10 + [1.0] * 200000 + [0.0] * 10
+        trig, dbg = self.run_trigger(data, 0.5, 0.2, 100)
+        self.assertEqual(dbg.num_messages(), 1)
+
+    def test_003_sample_and_time(self):
+        data = [0.0] * 10000
+        data[5000:5100] = [1.0] * 100
+        time_tag = gr.tag_t()
+        time_tag.offset = 1000
+        time_tag.key = pmt.intern("rx_time")
+        time_tag.value = pmt.make_tuple(pmt.from_uint64(100), pmt.from_double(0.5))
+        rate_tag = gr.tag_t()
+        rate_tag.offset = 0
+        rate_tag.key = pmt.intern("rx_rate")
+        rate_tag.value = pmt.from_double(1000.0)
+
+        src = blocks.vector_source_f(data, False, 1, [rate_tag, time_tag])
+        trig = timing_utils.thresh_trigger_f(0.5, 0.2, 10)
+        snk = blocks.vector_sink_f()
+        dbg = blocks.message_debug()
+        self.tb.connect(src, trig, snk)
+        self.tb.msg_connect((trig, 'trig'), (dbg, 'store'))
+        self.tb.run()
+
+        self.assertEqual(dbg.num_messages(), 1)
+        msg = dbg.get_message(0)
+        self.assertTrue(pmt.eq(pmt.car(msg), pmt.intern("trigger_now")))
+        info = pmt.cdr(msg)
+        self.assertEqual(pmt.to_uint64(pmt.dict_ref(info, pmt.intern("trigger_sample"), pmt.PMT_NIL)), 5009)
+        trigger_time = pmt.dict_ref(info, pmt.intern("trigger_time"), pmt.PMT_NIL)
+        self.assertEqual(pmt.to_uint64(pmt.car(trigger_time)), 104)
+        self.assertAlmostEqual(pmt.to_double(pmt.cdr(trigger_time)), 0.509)
+
+        # the output passes the input with the trigger tagged
+        self.assertEqual(len(snk.data()), len(data))
+        tags = [t for t in snk.tags() if pmt.eq(t.key, pmt.intern("trigger_now"))]
+        self.assertEqual(len(tags), 1)
+        self.assertEqual(tags[0].offset, 5009)
+
+    def test_004_no_time(self):
+        # without an rx_time tag only the sample is reported
+        data = [0.0] * 1000 + [1.0] * 20
+        trig, dbg = self.run_trigger(data, 0.5, 0.2, 5)
+        info = pmt.cdr(dbg.get_message(0))
+        self.assertEqual(pmt.to_uint64(pmt.dict_ref(info, pmt.intern("trigger_sample"), pmt.PMT_NIL)), 1004)
+        self.assertFalse(pmt.dict_has_key(info, pmt.intern("trigger_time")))
+
+    def test_005_cfar(self):
+        # bursts at ten times the noise floor trigger on both sides of a step
+        # in the floor that fixed thresholds could not handle, and the step
+        # itself triggers once
+        data = []
+        for level in [0.1, 1.0]:
+            data += [level * (0.5 + ((ii * 7919) % 100) / 200.0) for ii in range(20000)]
+        bursts = [5000, 15000, 25000, 35000]
+        for start in bursts:
+            data[start:start + 100] = [10.0 * data[start]] * 100
+        src = blocks.vector_source_f(data, False)
+        trig = timing_utils.thresh_trigger_f(5.0, 2.0, 3)
+        trig.set_cfar(1000)
+        dbg = blocks.message_debug()
+        self.tb.connect(src, trig)
+        self.tb.msg_connect((trig, 'trig'), (dbg, 'store'))
+        self.tb.run()
+
+        # the estimate restarts at the new floor without false triggers
+        samples = [pmt.to_uint64(pmt.dict_ref(pmt.cdr(dbg.get_message(ii)), pmt.intern("trigger_sample"), pmt.PMT_NIL))
+                   for ii in range(dbg.num_messages())]
+        self.assertEqual(samples, sorted([start + 2 for start in bursts + [20000]]))
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_thresh_trigger_f)
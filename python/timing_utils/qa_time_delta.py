@@ -117,6 +117,40 @@ class qa_time_delta(gr_unittest.TestCase):
         else:
             self.assertTrue(False)
 
+    def test_003_stats(self):
+        ''' Deltas should be published as periodic histogram snapshots '''
+        self.dut.set_period(0.05)
+        self.dut.set_reset_on_read(True)
+        stats = blocks.message_debug()
+        self.tb.msg_connect((self.dut, 'stats'), (stats, 'store'))
+
+        tnow = time.time()
+        self.tb.start()
+        time.sleep(.001)
+        for ii in range(100):
+            meta = pmt.dict_add(pmt.make_dict(), pmt.intern('wall_clock_time'),
+                                pmt.from_double(tnow - 1 - ii * 0.01))
+            self.emitter.emit(pmt.cons(meta, pmt.init_u8vector(1, [0])))
+        time.sleep(.2)
+        self.tb.stop()
+        self.tb.wait()
+
+        self.assertEqual(100, self.debug.num_messages())
+        self.assertGreater(stats.num_messages(), 1)
+        count = 0
+        p50 = None
+        for ii in range(stats.num_messages()):
+            snapshot = stats.get_message(ii)
+            n = pmt.to_uint64(pmt.dict_ref(snapshot, pmt.intern("count"), pmt.PMT_NIL))
+            if n:
+                p50 = pmt.to_double(pmt.dict_ref(snapshot, pmt.intern("p50"), pmt.PMT_NIL))
+            count += n
+
+        # each delta is in exactly one snapshot
+        self.assertEqual(100, count)
+        self.assertIsNotNone(p50)
+        self.assertEqual(0, pmt.to_uint64(pmt.dict_ref(self.dut.stats(), pmt.intern("count"), pmt.PMT_NIL)))
+
 
 if __name__ == '__main__':
     gr_unittest.run(qa_time_delta)
@@ -0,0 +1,98 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018-2021 National Technology & Engineering Solutions of Sandia, LLC
+# (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government
+# retains certain rights in this software.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import cmath
+import pmt
+try:
+    from gnuradio import timing_utils
+except ImportError:
+    import os
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio import timing_utils
+
+
+class qa_timed_ddc (gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def tune(self, lo_offset, secs, frac):
+        msg = pmt.dict_add(pmt.make_dict(), pmt.intern('freq'), pmt.from_double(lo_offset))
+        return pmt.dict_add(msg, pmt.intern('time'), pmt.cons(pmt.from_uint64(secs), pmt.from_double(frac)))
+
+    def run_ddc(self, tags, tune):
+        fs = 1000
+        src = blocks.vector_source_c([1 + 0j] * 2000, False, 1, tags)
+        dut = timing_utils.timed_ddc(2, [1], 0, fs, pmt.intern('freq'), 0, 0.0)
+        snk = blocks.vector_sink_c()
+        self.tb.connect(src, dut, snk)
+
+        # queued before the flowgraph starts, so it is handled before any work
+        dut.to_basic_block()._post(pmt.intern('command'), tune)
+        self.tb.run()
+        self.assertEqual(dut.retunes(), 1)
+        self.assertAlmostEqual(dut.center_freq(), 100)
+        return (snk.data(), [t for t in snk.tags() if pmt.eq(t.key, pmt.intern('freq'))])
+
+    def check_retune(self, data, freq_tags, first):
+        # the output is at 500 Hz, and the phase carries on from the retune
+        expected = [1 + 0j] * first + \
+            [cmath.exp(-2j * cmath.pi * 100 * ii / 500) for ii in range(len(data) - first)]
+        self.assertComplexTuplesAlmostEqual(data, expected, 4)
+        self.assertEqual([t.offset for t in freq_tags], [first])
+        self.assertAlmostEqual(pmt.to_double(freq_tags[0].value), 100)
+
+    def test_001_timed_retune(self):
+        # 1.0 s is input sample 1000, output sample 500
+        (data, freq_tags) = self.run_ddc([], self.tune(-100, 1, 0.0))
+        self.assertEqual(len(data), 1000)
+        self.check_retune(data, freq_tags, 500)
+
+    def test_002_rx_time(self):
+        # input sample 400 is at 10.0 s, so 10.3 s is input sample 700
+        tag = gr.tag_utils.python_to_tag([400, pmt.intern('rx_time'), pmt.make_tuple(pmt.from_uint64(10), pmt.from_double(0.0)), pmt.intern('src')])
+        (data, freq_tags) = self.run_ddc([tag], self.tune(-100, 10, 0.3))
+        self.check_retune(data, freq_tags, 350)
+
+    def test_003_group_delay(self):
+        # five taps delay by two input samples, so the output centered on
+        # input sample 700 at 10.3 s is 351, and the rx_time tag on input
+        # sample 400 lands on output 201
+        fs = 1000
+        data = [cmath.exp(2j * cmath.pi * 100 * ii / fs) for ii in range(2000)]
+        tag = gr.tag_utils.python_to_tag([400, pmt.intern('rx_time'), pmt.make_tuple(pmt.from_uint64(10), pmt.from_double(0.0)), pmt.intern('src')])
+        src = blocks.vector_source_c(data, False, 1, [tag])
+        dut = timing_utils.timed_ddc(2, [0.2] * 5, 0, fs, pmt.intern('freq'), 0, 0.0)
+        snk = blocks.vector_sink_c()
+        self.tb.connect(src, dut, snk)
+        dut.to_basic_block()._post(pmt.intern('command'), self.tune(-100, 10, 0.3))
+        self.tb.run()
+
+        tags = [(t.offset, pmt.symbol_to_string(t.key)) for t in snk.tags()]
+        self.assertEqual(sorted(tags), [(201, 'rx_time'), (351, 'freq')])
+
+        # the 100 Hz tone is attenuated by the low pass taps, then passed by
+        # the band pass taps at the new center frequency and derotated to DC
+        out = snk.data()
+        gain = sum(0.2 * cmath.exp(-2j * cmath.pi * 100 * ii / fs) for ii in range(5))
+        expected = [gain * cmath.exp(2j * cmath.pi * 100 * 2 * ii / fs) for ii in range(351)] + \
+            [cmath.exp(2j * cmath.pi * 100 * 702 / fs)] * (len(out) - 351)
+        self.assertComplexTuplesAlmostEqual(out[2:], expected[2:], 4)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_timed_ddc)
@@ -0,0 +1,118 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018-2021 National Technology & Engineering Solutions of Sandia, LLC
+# (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government
+# retains certain rights in this software.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import json
+import os
+import pmt
+import tempfile
+import time
+try:
+    from gnuradio import timing_utils
+except ImportError:
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio import timing_utils
+
+
+class qa_trace_sink (gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+        fd, self.filename = tempfile.mkstemp(suffix='.json')
+        os.close(fd)
+
+    def tearDown(self):
+        self.tb = None
+        os.remove(self.filename)
+
+    def read_events(self):
+        # the closing bracket is only written when the sink is destroyed
+        with open(self.filename) as f:
+            text = f.read().rstrip()
+        if not text.endswith(']'):
+            text += ']'
+        return json.loads(text)
+
+    def test_001_stream(self):
+        src = blocks.vector_source_f([0.0] * 1000, False)
+        tagger = timing_utils.system_time_tagger_f(100, True)
+        diff = timing_utils.system_time_diff_f(False, False)
+        sink = timing_utils.trace_sink(self.filename, gr.sizeof_float)
+        tagger.set_block_alias("tagger")
+        diff.set_block_alias("diff")
+        sink.set_block_alias("sink")
+        self.tb.connect(src, tagger, diff, sink)
+        self.tb.run()
+
+        # tags at 100 ... 900
+        self.assertEqual(9, sink.records())
+        events = self.read_events()
+        self.assertEqual(9 * 2 * 2, len(events))
+        names = [e['name'] for e in events if e['ph'] == 'b']
+        self.assertEqual(["tagger -> diff", "diff -> sink"] * 9, names)
+
+        # each record is begin/end pairs of consecutive hops
+        for ii in range(0, len(events), 4):
+            b0, e0, b1, e1 = events[ii:ii + 4]
+            self.assertEqual(b0['id'], e0['id'])
+            self.assertEqual(b1['id'], e1['id'])
+            self.assertEqual(e0['ts'], b1['ts'])
+            self.assertLessEqual(b0['ts'], e0['ts'])
+            self.assertLessEqual(b1['ts'], e1['ts'])
+
+    def test_002_untraced(self):
+        src = blocks.vector_source_f([0.0] * 1000, False)
+        tagger = timing_utils.system_time_tagger_f(100)
+        sink = timing_utils.trace_sink(self.filename, gr.sizeof_float)
+        self.tb.connect(src, tagger, sink)
+        self.tb.run()
+
+        self.assertEqual(0, sink.records())
+        self.assertEqual([], self.read_events())
+
+    def test_003_pdu(self):
+        wct = timing_utils.wall_clock_time(pmt.intern('wall_clock_time'), True)
+        delta = timing_utils.time_delta(pmt.intern('time_delta_ms'),
+                                        pmt.intern('wall_clock_time'))
+        sink = timing_utils.trace_sink(self.filename, gr.sizeof_float)
+        wct.set_block_alias("wct")
+        delta.set_block_alias("delta")
+        sink.set_block_alias("sink")
+        self.tb.msg_connect((wct, 'pdu_out'), (delta, 'pdu_in'))
+        self.tb.msg_connect((delta, 'pdu_out'), (sink, 'pdu_in'))
+
+        pdu = pmt.cons(pmt.make_dict(), pmt.init_f32vector(4, [0.0] * 4))
+        self.tb.start()
+        time.sleep(.01)
+        for ii in range(3):
+            wct.to_basic_block()._post(pmt.intern('pdu_in'), pdu)
+        # PDUs that skip the traced block carry no record
+        delta.to_basic_block()._post(pmt.intern('pdu_in'), pdu)
+        time.sleep(.1)
+        self.tb.stop()
+        self.tb.wait()
+
+        self.assertEqual(3, sink.records())
+        events = self.read_events()
+        self.assertEqual(3 * 2 * 2, len(events))
+        names = [e['name'] for e in events if e['ph'] == 'b']
+        self.assertEqual(["wct -> delta", "delta -> sink"] * 3, names)
+        for ii in range(0, len(events), 4):
+            b0, e0, b1, e1 = events[ii:ii + 4]
+            self.assertEqual(e0['ts'], b1['ts'])
+            self.assertLessEqual(b0['ts'], e0['ts'])
+            self.assertLessEqual(b1['ts'], e1['ts'])
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_trace_sink)
@@ -0,0 +1,66 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018-2021 National Technology & Engineering Solutions of Sandia, LLC
+# (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government
+# retains certain rights in this software.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+try:
+    from gnuradio import timing_utils
+except ImportError:
+    import os
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio import timing_utils
+
+
+class qa_uhd_timed_pdu_emitter (gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def run_trigger(self, info, delay):
+        # 1 kHz samples from time zero
+        src = blocks.vector_source_c([0j] * 3000, False)
+        dut = timing_utils.uhd_timed_pdu_emitter(1000, True)
+        dut.set_trigger_delay(delay)
+        dbg = blocks.message_debug()
+        self.tb.connect(src, dut)
+        self.tb.msg_connect((dut, 'trig'), (dbg, 'store'))
+
+        # queued before the flowgraph starts, so it is handled before any work
+        dut.to_basic_block()._post(pmt.intern('set'), pmt.cons(pmt.intern('trigger_now'), info))
+        self.tb.run()
+        self.assertEqual(dbg.num_messages(), 1)
+        return dbg.get_message(0)
+
+    def test_001_trigger_time(self):
+        # the trigger at 1.0 s fires at 1.5 s
+        info = pmt.make_dict()
+        info = pmt.dict_add(info, pmt.intern('trigger_sample'), pmt.from_uint64(1000))
+        info = pmt.dict_add(info, pmt.intern('trigger_time'), pmt.cons(pmt.from_uint64(1), pmt.from_double(0.0)))
+        msg = self.run_trigger(info, 0.5)
+        self.assertAlmostEqual(pmt.to_double(pmt.dict_ref(msg, pmt.intern('trigger_sample'), pmt.PMT_NIL)), 1500)
+        trig = pmt.dict_ref(msg, pmt.intern('trigger_time'), pmt.PMT_NIL)
+        self.assertEqual(pmt.to_uint64(pmt.car(trig)), 1)
+        self.assertAlmostEqual(pmt.to_double(pmt.cdr(trig)), 0.5)
+
+    def test_002_trigger_sample(self):
+        # without a time the delay is applied to the sample
+        info = pmt.dict_add(pmt.make_dict(), pmt.intern('trigger_sample'), pmt.from_uint64(1000))
+        msg = self.run_trigger(info, 0.25)
+        self.assertAlmostEqual(pmt.to_double(pmt.dict_ref(msg, pmt.intern('trigger_sample'), pmt.PMT_NIL)), 1250)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_uhd_timed_pdu_emitter)
@@ -33,14 +33,22 @@ class uhd_timed_cordic_emulator(gr.hier_block2):
     This block allows for a broadband file to be dehopped at specific times
     for downstream processing by accepting the tune commands typically given to
     SDR hardware using the UHD API.
+
+    If the file is a SigMF recording, passing its metadata file as `sigmf`
+    tags the stream with the times, frequencies and annotations of its
+    captures instead of a single set of tags at `start_time`. The captures are
+    indexed by sample, so a SigMF recording can not be looped.
     """
 
-    def __init__(self, filename, loop, decimation, samp_rate, f0, short, start_time):
+    def __init__(self, filename, loop, decimation, samp_rate, f0, short, start_time, sigmf=''):
         gr.hier_block2.__init__(self,
                                 "uhd_timed_cordic_emulator",
                                 gr.io_signature(0, 0, 0),
                                 gr.io_signature(1, 1, gr.sizeof_gr_complex))
 
+        if loop and sigmf:
+            raise ValueError("uhd_timed_cordic_emulator: a SigMF recording can not be looped")
+
         # setup logger
         logger_name = 'gr_log.' + self.to_basic_block().alias()
         if logger_name in gr.logger_get_logger_names():
@@ -64,6 +72,7 @@ class uhd_timed_cordic_emulator(gr.hier_block2):
         self.deint = blocks.interleaved_short_to_complex(False, False, 1.0 / pow(2, 15))
         self.throttle = blocks.throttle(gr.sizeof_gr_complex * 1, samp_rate, True)
         self.tagger = timing_utils.add_usrp_tags_c(fc_start, samp_rate, int(start_time), (start_time - int(start_time)))
+        self.tagger.set_sigmf(sigmf)
         self.tuner = timing_utils.retune_uhd_to_timed_tag(
             int(samp_rate), timing_utils.PMTCONSTSTR__dsp_freq(), int(start_time), (start_time - int(start_time)))
         if DECIMATE_IN_FREQ_XLATING_FILTER: